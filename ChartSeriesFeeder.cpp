@@ -0,0 +1,211 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ChartSeriesFeeder.h"
+#include "DetailViewCache.h"
+#include "Mountain.h"
+
+#include <QElapsedTimer>
+#include <QtCharts/QXYSeries>
+
+#include <cmath>
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ChartSeriesFeeder::ChartSeriesFeeder(QObject* parent) :
+    QObject{parent}
+{
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+DetailViewCache* ChartSeriesFeeder::cache() const
+{
+    return m_cache;
+}
+
+void ChartSeriesFeeder::setCache(DetailViewCache* cache)
+{
+    if (cache == m_cache)
+        return;
+
+    m_cache = cache;
+    emit cacheChanged();
+}
+
+double ChartSeriesFeeder::lastPrepareMilliseconds() const
+{
+    return m_lastPrepareMilliseconds;
+}
+
+double ChartSeriesFeeder::lastReplaceMilliseconds() const
+{
+    return m_lastReplaceMilliseconds;
+}
+
+int ChartSeriesFeeder::lastPointCount() const
+{
+    return m_lastPointCount;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+void ChartSeriesFeeder::populateSeries(QObject* series, Mountain* mountain, ChartSeriesFeeder::Variable variable, int pixelWidth)
+{
+    QXYSeries* const xySeries = qobject_cast<QXYSeries*>(series);
+    if (xySeries == nullptr || mountain == nullptr)
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QList<QPointF> points;
+    const PreparedDetailView* preparedView = nullptr;
+    if (m_cache)
+    {
+        m_cache->setPixelWidth(pixelWidth);
+        preparedView = m_cache->detailView(mountain);
+    }
+
+    if (preparedView)
+    {
+        points = preparedView->series.value(variable);
+    }
+    else
+    {
+        points = createPoints(mountain->getHourlyDateTime(),
+                              getValuesForVariable(mountain, variable),
+                              getScaleForVariable(variable));
+    }
+
+    // A line chart cannot show more than one distinct point per horizontal pixel, so anything beyond
+    // that is only extra work for the renderer. Views cached before the width was known keep every point.
+    if (pixelWidth > 2 && points.size() > pixelWidth)
+        points = downsampleLargestTriangleThreeBuckets(points, pixelWidth);
+
+    m_lastPrepareMilliseconds = timer.nsecsElapsed() / 1.0e6;
+    timer.restart();
+
+    xySeries->replace(points);
+
+    m_lastReplaceMilliseconds = timer.nsecsElapsed() / 1.0e6;
+    m_lastPointCount = points.size();
+    emit timingsChanged();
+}
+
+QList<QPointF> ChartSeriesFeeder::createPoints(const QList<QDateTime>& dateTimes, const QList<double>& values, double scale)
+{
+    // The hourly date/time list carries one extra entry beyond the data (see MountainForecast::getHourlyDateTime),
+    // so only the pairs present in both lists are plotted.
+    const qsizetype numberOfPoints = std::min(dateTimes.size(), values.size());
+
+    QList<QPointF> points;
+    points.reserve(numberOfPoints);
+    for (qsizetype index = 0; index < numberOfPoints; ++index)
+        points.emplaceBack(static_cast<qreal>(dateTimes.at(index).toMSecsSinceEpoch()), values.at(index) * scale);
+    return points;
+}
+
+QList<QPointF> ChartSeriesFeeder::downsampleLargestTriangleThreeBuckets(const QList<QPointF>& points, int threshold)
+{
+    const qsizetype dataLength = points.size();
+    if (threshold < 3 || threshold >= dataLength)
+        return points;
+
+    QList<QPointF> sampled;
+    sampled.reserve(threshold);
+
+    // Always keep the first and last points; the points in between are split into buckets
+    // and the point forming the largest triangle with its neighbours is kept from each bucket.
+    const double bucketSize = static_cast<double>(dataLength - 2) / (threshold - 2);
+    qsizetype selectedIndex = 0;
+    sampled.append(points.at(0));
+
+    for (int bucket = 0; bucket < threshold - 2; ++bucket)
+    {
+        // Average of the next bucket, used as the third vertex of the triangle.
+        const qsizetype averageRangeStart = static_cast<qsizetype>(std::floor((bucket + 1) * bucketSize)) + 1;
+        const qsizetype averageRangeEnd = std::min(static_cast<qsizetype>(std::floor((bucket + 2) * bucketSize)) + 1, dataLength);
+        double averageX = 0.0;
+        double averageY = 0.0;
+        for (qsizetype index = averageRangeStart; index < averageRangeEnd; ++index)
+        {
+            averageX += points.at(index).x();
+            averageY += points.at(index).y();
+        }
+        const qsizetype averageRangeLength = averageRangeEnd - averageRangeStart;
+        averageX /= averageRangeLength;
+        averageY /= averageRangeLength;
+
+        // Pick the point in the current bucket with the largest triangle area.
+        const qsizetype rangeStart = static_cast<qsizetype>(std::floor(bucket * bucketSize)) + 1;
+        const qsizetype rangeEnd = static_cast<qsizetype>(std::floor((bucket + 1) * bucketSize)) + 1;
+        const QPointF& pointA = points.at(selectedIndex);
+        double maxArea = -1.0;
+        qsizetype nextSelectedIndex = rangeStart;
+        for (qsizetype index = rangeStart; index < rangeEnd; ++index)
+        {
+            const QPointF& candidate = points.at(index);
+            const double area = std::abs((pointA.x() - averageX) * (candidate.y() - pointA.y()) -
+                                         (pointA.x() - candidate.x()) * (averageY - pointA.y()));
+            if (area > maxArea)
+            {
+                maxArea = area;
+                nextSelectedIndex = index;
+            }
+        }
+
+        sampled.append(points.at(nextSelectedIndex));
+        selectedIndex = nextSelectedIndex;
+    }
+
+    sampled.append(points.last());
+    return sampled;
+}
+
+QList<double> ChartSeriesFeeder::getValuesForVariable(const Mountain* mountain, ChartSeriesFeeder::Variable variable)
+{
+    switch (variable)
+    {
+    case Precipitation:
+        return mountain->getHourlyPrecipitation();
+    case Temperature:
+        return mountain->getHourlyTemperature();
+    case ApparentTemperature:
+        return mountain->getHourlyApparentTemperature();
+    case Visibility:
+    {
+        const QList<int> visibility = mountain->getHourlyVisibility();
+        return QList<double>(visibility.cbegin(), visibility.cend());
+    }
+    case WindChill:
+        return mountain->getHourlyWindChill();
+    case FreezingLevelMargin:
+        return mountain->getHourlyFreezingLevelMargin();
+    case CloudBaseMargin:
+        return mountain->getHourlyCloudBaseMargin();
+    }
+    return {};
+}
+
+double ChartSeriesFeeder::getScaleForVariable(ChartSeriesFeeder::Variable variable)
+{
+    // Visibility is reported in metres but plotted in kilometres.
+    return variable == Visibility ? 0.001 : 1.0;
+}
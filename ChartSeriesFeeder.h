@@ -0,0 +1,77 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CHARTSERIESFEEDER_H
+#define CHARTSERIESFEEDER_H
+
+#include <QDateTime>
+#include <QList>
+#include <QObject>
+#include <QPointF>
+
+Q_MOC_INCLUDE("DetailViewCache.h")
+
+class DetailViewCache;
+class Mountain;
+
+// Fills QML chart series from C++ in a single bulk replace() so that a chart is
+// repainted once per selection rather than once per appended point.
+class ChartSeriesFeeder : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(DetailViewCache* cache READ cache WRITE setCache NOTIFY cacheChanged)
+    Q_PROPERTY(double lastPrepareMilliseconds READ lastPrepareMilliseconds NOTIFY timingsChanged)
+    Q_PROPERTY(double lastReplaceMilliseconds READ lastReplaceMilliseconds NOTIFY timingsChanged)
+    Q_PROPERTY(int lastPointCount READ lastPointCount NOTIFY timingsChanged)
+
+public:
+    enum Variable
+    {
+        Precipitation,
+        Temperature,
+        ApparentTemperature,
+        Visibility,
+        WindChill,
+        FreezingLevelMargin,
+        CloudBaseMargin
+    };
+    Q_ENUM(Variable)
+
+    explicit ChartSeriesFeeder(QObject* parent = nullptr);
+
+    Q_INVOKABLE void populateSeries(QObject* series, Mountain* mountain, ChartSeriesFeeder::Variable variable, int pixelWidth = 0);
+
+    static QList<QPointF> createPoints(const QList<QDateTime>& dateTimes, const QList<double>& values, double scale = 1.0);
+    static QList<QPointF> downsampleLargestTriangleThreeBuckets(const QList<QPointF>& points, int threshold);
+    static QList<double> getValuesForVariable(const Mountain* mountain, ChartSeriesFeeder::Variable variable);
+    static double getScaleForVariable(ChartSeriesFeeder::Variable variable);
+
+    DetailViewCache* cache() const;
+    void setCache(DetailViewCache* cache);
+    double lastPrepareMilliseconds() const;
+    double lastReplaceMilliseconds() const;
+    int lastPointCount() const;
+
+signals:
+    void cacheChanged();
+    void timingsChanged();
+
+private:
+    DetailViewCache* m_cache = nullptr;
+    double m_lastPrepareMilliseconds = 0.0;
+    double m_lastReplaceMilliseconds = 0.0;
+    int m_lastPointCount = 0;
+};
+
+#endif // CHARTSERIESFEEDER_H
@@ -0,0 +1,167 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ConditionsClassifier.h"
+#include "Mountain.h"
+
+#include <limits>
+
+namespace
+{
+    // The value of a daily hazard, or the fallback if the forecast does not have it for the day. The
+    // day is one that the forecast has dates for (see hasForecastForDay).
+    template<typename T>
+    T hazardForDay(const QList<T>& values, int day, T fallback)
+    {
+        return day < values.size() ? values.at(day) : fallback;
+    }
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+ConditionsClassifier::Conditions ConditionsClassifier::classifyDay(const Mountain* mountain, int day) const
+{
+    if (mountain == nullptr)
+        return Conditions::Unknown;
+
+    return classifyDay(*mountain->getForecast(), day);
+}
+
+ConditionsClassifier::Conditions ConditionsClassifier::classifyDay(const MountainForecast& forecast, int day) const
+{
+    const MountainForecast::Series& series = forecast.getSeries();
+    if (!hasForecastForDay(series, day))
+        return Conditions::Unknown;
+
+    if (anyBadConditionForecastForDay(series, day))
+        return Conditions::Bad;
+
+    if (anyMarginalConditionForecastForDay(series, day))
+        return Conditions::Marginal;
+
+    return Conditions::Good;
+}
+
+ConditionsClassifier::Conditions ConditionsClassifier::classifyDays(const Mountain* mountain, const QList<int>& days) const
+{
+    if (mountain == nullptr)
+        return Conditions::Unknown;
+
+    return classifyDays(*mountain->getForecast(), days);
+}
+
+ConditionsClassifier::Conditions ConditionsClassifier::classifyDays(const MountainForecast& forecast, const QList<int>& days) const
+{
+    // The conditions over several days are as bad as the worst of those days.
+    Conditions worstConditions = Conditions::Good;
+    for (int day : days)
+    {
+        const Conditions conditions = classifyDay(forecast, day);
+        if (conditions == Conditions::Unknown)
+            return Conditions::Unknown;
+        if (conditions > worstConditions)
+            worstConditions = conditions;
+    }
+    return worstConditions;
+}
+
+bool ConditionsClassifier::anyBadConditionForecastForDay(const MountainForecast& forecast, int day) const
+{
+    const MountainForecast::Series& series = forecast.getSeries();
+    return hasForecastForDay(series, day) && anyBadConditionForecastForDay(series, day);
+}
+
+bool ConditionsClassifier::anyMarginalConditionForecastForDay(const MountainForecast& forecast, int day) const
+{
+    const MountainForecast::Series& series = forecast.getSeries();
+    return hasForecastForDay(series, day) && anyMarginalConditionForecastForDay(series, day);
+}
+
+bool ConditionsClassifier::conditionsDescriptionIsConcerning(const QString& condition) const
+{
+    if (condition == "Clear" || condition == "Mainly Clear" ||
+        condition == "Partly cloudy" || condition == "Overcast" ||
+        condition == "Unknown")
+        return false;
+    else
+        return true;
+}
+
+QString ConditionsClassifier::conditionsName(Conditions conditions)
+{
+    switch (conditions)
+    {
+    case Conditions::Good:
+        return "Good";
+    case Conditions::Marginal:
+        return "Marginal";
+    case Conditions::Bad:
+        return "Bad";
+    case Conditions::Unknown:
+        break;
+    }
+    return "Unknown";
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+bool ConditionsClassifier::anyBadConditionForecastForDay(const MountainForecast::Series& series, int day) const
+{
+    const QString& condition = MountainForecast::convertWeatherCodeToConditions(series.dailyWeatherCode.at(day));
+    const double windspeed = series.dailyWindSpeed.at(day);
+    const double precipitation = series.dailyPrecipitation.at(day);
+
+    if (windspeed >= badWindSpeedThreshold || precipitation >= badPrecipitationThreshold || condition == "Thunderstorms")
+        return true;
+
+    // A missing wind chill is NaN, which is never below the threshold.
+    const double windChill = hazardForDay(series.dailyMinimumWindChill, day, std::numeric_limits<double>::quiet_NaN());
+    if (windChill <= badWindChillThreshold)
+        return true;
+
+    return false;
+}
+
+bool ConditionsClassifier::anyMarginalConditionForecastForDay(const MountainForecast::Series& series, int day) const
+{
+    const QString& condition = MountainForecast::convertWeatherCodeToConditions(series.dailyWeatherCode.at(day));
+    const double windspeed = series.dailyWindSpeed.at(day);
+    const double precipitation = series.dailyPrecipitation.at(day);
+
+    if (windspeed >= marginalWindSpeedThreshold || precipitation >= marginalPrecipitationThreshold || conditionsDescriptionIsConcerning(condition))
+        return true;
+
+    const double windChill = hazardForDay(series.dailyMinimumWindChill, day, std::numeric_limits<double>::quiet_NaN());
+    const int freezingLevelBelowSummitHours = hazardForDay(series.dailyFreezingLevelBelowSummitHours, day, 0);
+    const int summitInCloudHours = hazardForDay(series.dailySummitInCloudHours, day, 0);
+    if (windChill <= marginalWindChillThreshold || freezingLevelBelowSummitHours >= marginalFreezingLevelBelowSummitHours ||
+        summitInCloudHours >= marginalSummitInCloudHours)
+        return true;
+
+    return false;
+}
+
+bool ConditionsClassifier::hasForecastForDay(const MountainForecast::Series& series, int day) const
+{
+    // As the getters of MountainForecast, only the days that have dates are counted.
+    if (day < 0 || day >= series.dates.size())
+        return false;
+
+    return day < series.dailyWeatherCode.size() &&
+           day < series.dailyWindSpeed.size() &&
+           day < series.dailyPrecipitation.size();
+}
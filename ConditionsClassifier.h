@@ -0,0 +1,70 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONDITIONSCLASSIFIER_H
+#define CONDITIONSCLASSIFIER_H
+
+#include <QList>
+#include <QString>
+
+#include "MountainForecast.h"
+
+class Mountain;
+
+// The rules used to decide whether the forecast for a mountain on a given day gives
+// good, marginal or bad conditions (see the "Info" box of the filter options).
+class ConditionsClassifier
+{
+public:
+    enum class Conditions
+    {
+        Unknown,
+        Good,
+        Marginal,
+        Bad
+    };
+
+    // The Mountain overloads classify the forecast current at the time of the call. Use the
+    // MountainForecast overloads to classify several days or mountains from the same generation.
+    Conditions classifyDay(const Mountain* mountain, int day) const;
+    Conditions classifyDay(const MountainForecast& forecast, int day) const;
+    Conditions classifyDays(const Mountain* mountain, const QList<int>& days) const;
+    Conditions classifyDays(const MountainForecast& forecast, const QList<int>& days) const;
+
+    bool anyBadConditionForecastForDay(const MountainForecast& forecast, int day) const;
+    bool anyMarginalConditionForecastForDay(const MountainForecast& forecast, int day) const;
+    bool conditionsDescriptionIsConcerning(const QString& condition) const;
+
+    static QString conditionsName(Conditions conditions);
+
+    double badPrecipitationThreshold = 5;
+    double badWindChillThreshold = -20;
+    double badWindSpeedThreshold = 40;
+    double marginalPrecipitationThreshold = 1;
+    double marginalWindChillThreshold = -10;
+    double marginalWindSpeedThreshold = 20;
+    // Hours of the day with the freezing level below the summit, or with the summit in cloud, counted
+    // over the same hours as the other daily values. The hazards are only used when the forecast has
+    // them (see HazardKernel).
+    int marginalFreezingLevelBelowSummitHours = 1;
+    int marginalSummitInCloudHours = 6;
+
+private:
+    // Classifying reads the stored series directly, as it is done for every day of every mountain
+    // whenever the pins, the filter or the heatmap are updated.
+    bool anyBadConditionForecastForDay(const MountainForecast::Series& series, int day) const;
+    bool anyMarginalConditionForecastForDay(const MountainForecast::Series& series, int day) const;
+    bool hasForecastForDay(const MountainForecast::Series& series, int day) const;
+};
+
+#endif // CONDITIONSCLASSIFIER_H
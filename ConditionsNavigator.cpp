@@ -1,412 +1,757 @@
-// Copyright 2023 Esri
-
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-
-// Unless required by applicable law or agreed to in writing, software
-// distributed under the License is distributed on an "AS IS" BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-// See the License for the specific language governing permissions and
-// limitations under the License.
-
-#include "ConditionsNavigator.h"
-
-#include <QFuture>
-#include <QQmlProperty>
-
-#include "AttributeListModel.h"
-#include "Envelope.h"
-#include "GeometryEngine.h"
-#include "Graphic.h"
-#include "GraphicListModel.h"
-#include "GraphicsOverlay.h"
-#include "GraphicsOverlayListModel.h"
-#include "IdentifyGraphicsOverlayResult.h"
-#include "LabelDefinition.h"
-#include "LabelDefinitionListModel.h"
-#include "LinearUnit.h"
-#include "Map.h"
-#include "MapTypes.h"
-#include "MapQuickView.h"
-#include "MultilayerPointSymbol.h"
-#include "Point.h"
-#include "Polygon.h"
-#include "Portal.h"
-#include "SimpleLabelExpression.h"
-#include "SpatialReference.h"
-#include "SymbolLayer.h"
-#include "SymbolLayerListModel.h"
-#include "SymbolStyle.h"
-#include "SymbolTypes.h"
-#include "TextSymbol.h"
-#include "Viewpoint.h"
-
-#include "Mountain.h"
-#include "MountainLocations.h"
-#include "OpenMeteoForecastSource.h"
-
-using namespace Esri::ArcGISRuntime;
-
-namespace
-{
-    OpenMeteoForecastSource openMeteoForecast;
-}
-
-// ------------------------------------- //
-//       Constructor & Destructor        //
-// ------------------------------------- //
-
-ConditionsNavigator::ConditionsNavigator(QObject* parent /* = nullptr */):
-    QObject(parent),
-    m_map(new Map(BasemapStyle::ArcGISTopographic, this))
-{
-    getPinSymbolFromPortalThenInitialiseApp();
-}
-
-ConditionsNavigator::~ConditionsNavigator() = default;
-
-// ------------------------------------- //
-//     Property Getters and Setters      //
-// ------------------------------------- //
-
-MapQuickView* ConditionsNavigator::mapView() const
-{
-    return m_mapView;
-}
-
-// Set the view (created in QML)
-void ConditionsNavigator::setMapView(MapQuickView* const mapView)
-{
-    if (!mapView || mapView == m_mapView)
-    {
-        return;
-    }
-
-    m_mapView = mapView;
-    m_mapView->setMap(m_map);
-
-    getReferencesToFilterOptionToggles();
-    assignLabelsToUIFilterOptions();
-
-    emit mapViewChanged();
-}
-
-Mountain* ConditionsNavigator::selectedMountain() const
-{
-    return m_selectedMountain;
-}
-
-// ------------------------------------- //
-//            Public Methods             //
-// ------------------------------------- //
-
-void ConditionsNavigator::clearCurrentFilter() const
-{
-    // Loop through each QML toggle element and set checked property to false.
-    for (QObject* toggle : m_filterToggles)
-        toggle->setProperty("checked", false);
-
-    // Loop through each mountain and reset symbol to dull red colour.
-    for (Mountain* mountain : m_mountains)
-        mountain->mountainGraphic->setSymbol(m_baseSymbol);
-}
-
-void ConditionsNavigator::filterOptionsChanged()
-{
-    const QList<int> indicesOfSelectedDays = identifyWhichFilterOptionsAreChecked();
-
-    if (indicesOfSelectedDays.isEmpty())
-        clearCurrentFilter();
-    else
-        applyFilter(indicesOfSelectedDays);
-}
-
-// ------------------------------------- //
-//            Private Methods            //
-// ------------------------------------- //
-
-QList<int> ConditionsNavigator::identifyWhichFilterOptionsAreChecked() const
-{
-    const int daysInAWeek = 7;
-    QList<int> indicesOfSelectedToggleOptions;
-    for (int index = 0; index < daysInAWeek; ++index)
-    {
-        const QObject* toggle = m_filterToggles.at(index);
-        const bool toggleChecked = QQmlProperty::read(toggle, "checked").toBool();
-        if (toggleChecked)
-            indicesOfSelectedToggleOptions.append(index);
-    }
-    return indicesOfSelectedToggleOptions;
-}
-
-void ConditionsNavigator::getPinSymbolFromPortalThenInitialiseApp()
-{
-  SymbolStyle* style = new SymbolStyle("Esri2DPointSymbolsStyle", new Portal(this), this);
-      style->fetchSymbolAsync({"esri-pin-2"}).then(this, [this](Symbol* symbol) {
-        createDifferentColouredVersionsOfPinSymbol(symbol);
-          if (m_map->loadStatus() == LoadStatus::Loaded)
-              initialiseApp();
-          else
-              waitUntilMapIsLoadedThenInitialiseApp();
-          });
-}
-
-void ConditionsNavigator::waitUntilMapIsLoadedThenInitialiseApp()
-{
-    connect(m_map, &Map::loadStatusChanged, this, [this](){
-        if (m_map->loadStatus() == LoadStatus::Loaded)
-            initialiseApp();
-    });
-}
-
-void ConditionsNavigator::createDifferentColouredVersionsOfPinSymbol(Symbol* const symbol)
-{
-    m_baseSymbol = dynamic_cast<MultilayerPointSymbol*>(symbol);
-    m_baseSymbol->setColor(QColor::fromString("indianred"));
-
-    m_greenSymbol = createCopyOfPointSymbol(m_baseSymbol);
-    m_greenSymbol->setColor(QColor::fromString("green"));
-
-    m_orangeSymbol = createCopyOfPointSymbol(m_baseSymbol);
-    m_orangeSymbol->setColor(QColor::fromString("orange"));
-
-    m_redSymbol = createCopyOfPointSymbol(m_baseSymbol);
-    m_redSymbol->setColor(QColor::fromString("red"));
-}
-
-MultilayerPointSymbol* ConditionsNavigator::createCopyOfPointSymbol(MultilayerPointSymbol* const symbol)
-{
-    // MultilayerPointSymbol does not have copy constructor, so a new MultilayerPointSymbol object
-    // needs to be created from a list containing each symbol layer.
-    const SymbolLayerListModel* listModel = symbol->symbolLayers();
-    QList<SymbolLayer*> listOfSymbolLayers;
-    for (int counter = 0; counter < listModel->size(); ++counter)
-        listOfSymbolLayers.append(listModel->at(counter)->clone());
-    return new MultilayerPointSymbol(listOfSymbolLayers, this);
-}
-
-void ConditionsNavigator::initialiseApp()
-{
-    MountainLocations mountainLocations{this};
-    m_mountains = mountainLocations.getLocations();
-    displayMountainsOnMap();
-    setInitialViewpoint();
-    retrieveForecastData();
-    setupInteractionBehaviour();
-}
-
-void ConditionsNavigator::displayMountainsOnMap()
-{
-    if (m_mountainsOverlay == nullptr)
-    {
-        m_mountainsOverlay = new GraphicsOverlay(this);
-        setupLabeling();
-    }
-
-    for (Mountain* mountain : m_mountains)
-    {
-        const double mountainsLongitude = mountain->getLongitude();
-        const double mountainsLatitude = mountain->getLatitude();
-        const QString mountainName = mountain->getName();
-
-        const Point mountainPoint(mountainsLongitude, mountainsLatitude, SpatialReference::wgs84());
-        Graphic* pointGraphic = new Graphic(mountainPoint, m_baseSymbol, this);
-        pointGraphic->attributes()->insertAttribute("Name", mountainName);
-        mountain->mountainGraphic = pointGraphic;
-        m_mountainsOverlay->graphics()->append(pointGraphic);
-    }
-
-    m_mapView->graphicsOverlays()->append(m_mountainsOverlay);
-}
-
-void ConditionsNavigator::setupLabeling()
-{
-    SimpleLabelExpression* labelExpression = new SimpleLabelExpression("[Name]", this);
-
-    TextSymbol* textSymbol = new TextSymbol(this);
-    textSymbol->setFontWeight(FontWeight::Bold);
-    textSymbol->setSize(11);
-    textSymbol->setColor(Qt::black);
-
-    LabelDefinition* labelDefinition = new LabelDefinition(labelExpression, textSymbol, this);
-    m_mountainsOverlay->labelDefinitions()->append(labelDefinition);
-    m_mountainsOverlay->setLabelsEnabled(true);
-}
-
-void ConditionsNavigator::setInitialViewpoint()
-{
-    const Envelope extent = m_mountainsOverlay->extent();
-    const double bufferSize = extent.height() * 0.1;
-    const double maxDeviationBetweenPoints = 100;
-    const Polygon expandedExtent = GeometryEngine::bufferGeodetic(
-                extent,
-                bufferSize,
-                LinearUnit::meters(),
-                maxDeviationBetweenPoints,
-                GeodeticCurveType::Geodesic);
-    const Viewpoint viewpoint(expandedExtent);
-    m_mapView->setViewpointAsync(viewpoint);
-}
-
-void ConditionsNavigator::retrieveForecastData() const
-{
-    for (Mountain* mountain : m_mountains)
-        openMeteoForecast.MakeRequest(mountain->getLongitude(), mountain->getLatitude(), mountain->getElevation(), mountain);
-}
-
-void ConditionsNavigator::setupInteractionBehaviour()
-{
-    connect(m_mapView, &MapQuickView::mouseClicked, this, [this](QMouseEvent& mouseEvent)
-    {
-        const double identifyTolerance = 15;
-        const bool returnPopups = false;
-
-        m_mapView->identifyGraphicsOverlayAsync(m_mountainsOverlay,
-                                                mouseEvent.position(),
-                                                identifyTolerance,
-                                                returnPopups).then([this](IdentifyGraphicsOverlayResult* rawIdentifyResult){
-          selectMountain(rawIdentifyResult);
-        });
-    });
-
-    connect(m_mapView, &MapQuickView::touched, this, [this](QTouchEvent& touchEvent)
-    {
-        const QEventPoint touchPoint = touchEvent.point(0);
-
-        const double identifyTolerance = 15;
-        const bool returnPopups = false;
-
-        m_mapView->identifyGraphicsOverlayAsync(m_mountainsOverlay,
-                                                touchEvent.points().first().position(),
-                                                identifyTolerance,
-                                                returnPopups).then([this](IdentifyGraphicsOverlayResult* rawIdentifyResult){
-          selectMountain(rawIdentifyResult);
-        });
-    });
-}
-
-void ConditionsNavigator::selectMountain(IdentifyGraphicsOverlayResult* const rawIdentifyResult)
-{
-  // Delete rawIdentifyResult on leaving scope.
-  const auto identifyResult = std::unique_ptr<IdentifyGraphicsOverlayResult>(rawIdentifyResult);
-
-  const bool identifyResultNullOrEmpty = !identifyResult || identifyResult.get()->graphics().isEmpty();
-
-  if (identifyResultNullOrEmpty)
-  {
-      m_selectedMountain = nullptr;
-  }
-  else
-  {
-      const QString nameOfSelectedMountain = identifyResult.get()->graphics().first()->attributes()->attributeValue("Name").toString();
-      m_selectedMountain = getSelectedMountain(nameOfSelectedMountain);
-  }
-
-  emit selectedMountainChanged();
-}
-
-void ConditionsNavigator::getReferencesToFilterOptionToggles()
-{
-    m_filterToggles.clear();
-    const int numberOfFilterOptions = 7;
-
-    const QString templateForToggleNames("day%1FilterOption");
-    for (int i = 1; i <= numberOfFilterOptions; i++)
-    {
-        const QString filterOptionName = templateForToggleNames.arg(QString::number(i));
-        if (QObject* filterOption = m_mapView->findChild<QObject*>(filterOptionName); filterOption)
-            m_filterToggles.append(filterOption);
-    }
-}
-
-void ConditionsNavigator::assignLabelsToUIFilterOptions()
-{
-    const QDate currentDate = QDate::currentDate();
-
-    for (int counter = 0; counter < 7; ++counter)
-        m_filterToggles.at(counter)->setProperty("text", currentDate.addDays(counter).toString("ddd"));
-}
-
-Mountain* ConditionsNavigator::getSelectedMountain(const QString& name) const
-{
-    for (Mountain* mountain : m_mountains)
-    {
-        if (mountain->getName() == name)
-             return mountain;
-    }
-    return nullptr;
-}
-
-void ConditionsNavigator::applyFilter(const QList<int>& selectedDays) const
-{
-    for (Mountain* mountain : m_mountains)
-    {
-      bool MoveToNextMountain = false;
-      mountain->mountainGraphic->setSymbol(m_greenSymbol);
-
-        // Check if forecast for this mountain meets criteria for bad conditions on any of the selected days.
-        for (int day : selectedDays)
-        {
-            if (anyBadConditionForecastForDay(mountain, day))
-            {
-                mountain->mountainGraphic->setSymbol(m_redSymbol);
-                MoveToNextMountain = true;
-            }
-
-            if (MoveToNextMountain)
-              break;
-        }
-
-        if (MoveToNextMountain)
-            continue;
-
-        // Check if forecast for this mountain meets criteria for marginal conditions on any of the selected days.
-        for (int day : selectedDays)
-        {
-            if (anyMarginalConditionForecastForDay(mountain, day))
-            {
-                mountain->mountainGraphic->setSymbol(m_orangeSymbol);
-                MoveToNextMountain = true;
-            }
-
-            if (MoveToNextMountain)
-              break;
-        }
-    }
-}
-
-bool ConditionsNavigator::anyBadConditionForecastForDay(Mountain* mountain, int day) const
-{
-    const QString condition = mountain->getDailyWeatherConditions().at(day);
-    const double windspeed = mountain->getDailyWindSpeed().at(day);
-    const double precipitation = mountain->getDailyPrecipitation().at(day);
-
-    if (windspeed >= 40 || precipitation >= 5 || condition == "Thunderstorms")
-        return true;
-
-    return false;
-}
-
-bool ConditionsNavigator::anyMarginalConditionForecastForDay(Mountain* mountain, int day) const
-{
-    const QString condition = mountain->getDailyWeatherConditions().at(day);
-    const double windspeed = mountain->getDailyWindSpeed().at(day);
-    const double precipitation = mountain->getDailyPrecipitation().at(day);
-
-    if (windspeed >= 20 || precipitation >= 1 || conditionsDescriptionIsConcerning(condition))
-        return true;
-
-    return false;
-}
-
-bool ConditionsNavigator::conditionsDescriptionIsConcerning(const QString& condition) const
-{
-    if (condition == "Clear" || condition == "Mainly Clear" ||
-        condition == "Partly cloudy" || condition == "Overcast" ||
-        condition == "Unknown")
-        return false;
-    else
-        return true;
-}
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ConditionsNavigator.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFuture>
+#include <QGuiApplication>
+#include <QRectF>
+
+#include <algorithm>
+
+#include "AttributeListModel.h"
+#include "Envelope.h"
+#include "GeometryEngine.h"
+#include "Graphic.h"
+#include "GraphicListModel.h"
+#include "GraphicsOverlay.h"
+#include "GraphicsOverlayListModel.h"
+#include "IdentifyGraphicsOverlayResult.h"
+#include "LabelDefinition.h"
+#include "LabelDefinitionListModel.h"
+#include "LinearUnit.h"
+#include "Map.h"
+#include "MapTypes.h"
+#include "MapQuickView.h"
+#include "MultilayerPointSymbol.h"
+#include "Point.h"
+#include "Polygon.h"
+#include "Portal.h"
+#include "SimpleLabelExpression.h"
+#include "SpatialReference.h"
+#include "Symbol.h"
+#include "SymbolLayer.h"
+#include "SymbolLayerListModel.h"
+#include "SymbolStyle.h"
+#include "SymbolTypes.h"
+#include "TextSymbol.h"
+#include "Viewpoint.h"
+
+#include "ForecastSubscription.h"
+#include "Metrics.h"
+#include "Mountain.h"
+#include "MountainLocations.h"
+#include "OpenMeteoForecastSource.h"
+#include "Tracer.h"
+
+using namespace Esri::ArcGISRuntime;
+
+namespace
+{
+    OpenMeteoForecastSource openMeteoForecast;
+
+    // Number of nearby mountains whose detail views are prepared in the background
+    // whenever a mountain is selected.
+    constexpr int numberOfNeighboursToPrefetch = 6;
+
+    // Close enough to tell a mountain found by searching from its neighbours.
+    constexpr double searchResultScale = 100000;
+
+    // The area shown by the initial viewpoint, so that forecasts can be requested while the map loads.
+    QRectF initialViewport(const QList<Mountain*>& mountains)
+    {
+        if (mountains.isEmpty())
+            return {};
+
+        double minimumLongitude = mountains.first()->getLongitude();
+        double maximumLongitude = minimumLongitude;
+        double minimumLatitude = mountains.first()->getLatitude();
+        double maximumLatitude = minimumLatitude;
+        for (const Mountain* mountain : mountains)
+        {
+            minimumLongitude = std::min(minimumLongitude, mountain->getLongitude());
+            maximumLongitude = std::max(maximumLongitude, mountain->getLongitude());
+            minimumLatitude = std::min(minimumLatitude, mountain->getLatitude());
+            maximumLatitude = std::max(maximumLatitude, mountain->getLatitude());
+        }
+
+        const double bufferSize = (maximumLatitude - minimumLatitude) * 0.1;
+        return QRectF(QPointF(minimumLongitude, minimumLatitude), QPointF(maximumLongitude, maximumLatitude))
+            .adjusted(-bufferSize, -bufferSize, bufferSize, bufferSize);
+    }
+}
+
+// ------------------------------------- //
+//       Constructor & Destructor        //
+// ------------------------------------- //
+
+ConditionsNavigator::ConditionsNavigator(QObject* parent /* = nullptr */):
+    QObject(parent),
+    m_detailViewCache(new DetailViewCache(this)),
+    m_forecastTableModel(new ForecastTableModel(this)),
+    m_map(new Map(BasemapStyle::ArcGISTopographic, this)),
+    m_refreshPlanner(new RefreshPlanner(this)),
+    m_searchModel(new MountainSearchModel(this)),
+    m_viewportLoader(new ForecastViewportLoader(this))
+{
+    m_forecastTableModel->setDetailViewCache(m_detailViewCache);
+    assignLabelsToUIFilterOptions();
+    setupViewportLoading();
+    setupRefreshPlanning();
+
+    // The forecasts, the pin symbol and the basemap do not depend on each other, so all three
+    // are started straight away and joined in initialiseAppIfReady().
+    loadMountainsAndRetrieveForecastData();
+    loadPinSymbol();
+    loadMap();
+}
+
+ConditionsNavigator::~ConditionsNavigator() = default;
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+MapQuickView* ConditionsNavigator::mapView() const
+{
+    return m_mapView;
+}
+
+// Set the view (created in QML)
+void ConditionsNavigator::setMapView(MapQuickView* const mapView)
+{
+    if (!mapView || mapView == m_mapView)
+    {
+        return;
+    }
+
+    m_mapView = mapView;
+    m_mapView->setMap(m_map);
+
+    emit mapViewChanged();
+
+    initialiseAppIfReady();
+}
+
+Mountain* ConditionsNavigator::selectedMountain() const
+{
+    return m_selectedMountain;
+}
+
+DetailViewCache* ConditionsNavigator::detailViewCache() const
+{
+    return m_detailViewCache;
+}
+
+QStringList ConditionsNavigator::filterDayLabels() const
+{
+    return m_filterDayLabels;
+}
+
+ForecastTableModel* ConditionsNavigator::forecastTableModel() const
+{
+    return m_forecastTableModel;
+}
+
+ForecastViewportLoader* ConditionsNavigator::viewportLoader() const
+{
+    return m_viewportLoader;
+}
+
+MountainSearchModel* ConditionsNavigator::searchModel() const
+{
+    return m_searchModel;
+}
+
+void ConditionsNavigator::setSelectedMountain(Mountain* mountain)
+{
+    // Replaces any selection still waiting for a search result to load.
+    m_mountainToSelect = nullptr;
+    m_selectedMountain = mountain;
+    m_forecastTableModel->setMountain(m_selectedMountain);
+
+    // The service has pushed changes to the mountain's forecast that have not been retrieved yet.
+    if (m_selectedMountain && m_pushedDayChanges.contains(m_selectedMountain))
+        openMeteoForecast.MakeRequest(m_selectedMountain->getLongitude(), m_selectedMountain->getLatitude(),
+                                      m_selectedMountain->getElevation(), m_selectedMountain);
+    m_refreshPlanner->setSelectedMountain(m_selectedMountain);
+    m_viewportLoader->setSelectedMountain(m_selectedMountain);
+    m_detailViewCache->prefetchNeighbours(m_selectedMountain, m_mountains, numberOfNeighboursToPrefetch);
+
+    emit selectedMountainChanged();
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+const ConditionsClassifier& ConditionsNavigator::classifier() const
+{
+    return m_classifier;
+}
+
+const QList<Mountain*>& ConditionsNavigator::mountains() const
+{
+    return m_mountains;
+}
+
+void ConditionsNavigator::clearCurrentFilter()
+{
+    // The QML toggles are bound to the checked days, so clearing them unchecks every toggle.
+    if (!m_checkedFilterDays.isEmpty())
+    {
+        m_checkedFilterDays.clear();
+        emit selectedFilterDaysChanged();
+    }
+
+    // Loop through each mountain with a forecast and reset symbol to dull red colour. The others
+    // keep the unknown symbol.
+    for (Mountain* mountain : m_viewportLoader->loadedMountains())
+    {
+        m_refreshPlanner->setFilteredGood(mountain, false);
+        if (mountain->mountainGraphic)
+            mountain->mountainGraphic->setSymbol(m_baseSymbol);
+    }
+}
+
+void ConditionsNavigator::showMountain(Mountain* mountain)
+{
+    if (mountain == nullptr)
+        return;
+
+    // The viewport loader requests the forecast of the mountain in the centre of the view first. If it
+    // has not been loaded yet, the mountain is selected once it has, so the charts are not empty.
+    if (m_mapView)
+        m_mapView->setViewpointCenterAsync(Point(mountain->getLongitude(), mountain->getLatitude(), SpatialReference::wgs84()), searchResultScale);
+
+    if (m_viewportLoader->isLoaded(mountain))
+        setSelectedMountain(mountain);
+    else
+        m_mountainToSelect = mountain;
+}
+
+void ConditionsNavigator::filterOptionsChanged()
+{
+    TRACE_SCOPE("filterOptionsChanged");
+    const QList<int> indicesOfSelectedDays = identifyWhichFilterOptionsAreChecked();
+
+    if (indicesOfSelectedDays.isEmpty())
+        clearCurrentFilter();
+    else
+        applyFilter(indicesOfSelectedDays);
+}
+
+void ConditionsNavigator::setFilterDayChecked(int day, bool checked)
+{
+    if (day < 0 || day >= m_filterDayLabels.size() || m_checkedFilterDays.contains(day) == checked)
+        return;
+
+    // Kept in the order of the days.
+    if (checked)
+        m_checkedFilterDays.insert(std::lower_bound(m_checkedFilterDays.begin(), m_checkedFilterDays.end(), day), day);
+    else
+        m_checkedFilterDays.removeOne(day);
+
+    emit selectedFilterDaysChanged();
+    filterOptionsChanged();
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+QList<int> ConditionsNavigator::identifyWhichFilterOptionsAreChecked() const
+{
+    return m_checkedFilterDays;
+}
+
+void ConditionsNavigator::loadPinSymbol()
+{
+    TRACE_SCOPE("loadPinSymbol");
+
+    // A copy of the pin is bundled with the app so that no Portal round trip is needed at start up.
+    QFile symbolFile(":/Resources/pin-symbol.json");
+    if (symbolFile.open(QIODevice::ReadOnly))
+    {
+        Symbol* symbol = Symbol::fromJson(QString::fromUtf8(symbolFile.readAll()), this);
+        if (dynamic_cast<MultilayerPointSymbol*>(symbol))
+        {
+            createDifferentColouredVersionsOfPinSymbol(symbol);
+            initialiseAppIfReady();
+            return;
+        }
+        delete symbol;
+    }
+
+    qWarning() << "Unable to read the bundled pin symbol, fetching it from the Portal instead.";
+    getPinSymbolFromPortal();
+}
+
+void ConditionsNavigator::getPinSymbolFromPortal()
+{
+    Tracer::instance().addAsyncBegin("portalSymbolFetch", 0);
+    SymbolStyle* style = new SymbolStyle("Esri2DPointSymbolsStyle", new Portal(this), this);
+    style->fetchSymbolAsync({"esri-pin-2"}).then(this, [this](Symbol* symbol) {
+        Tracer::instance().addAsyncEnd("portalSymbolFetch", 0);
+        createDifferentColouredVersionsOfPinSymbol(symbol);
+        initialiseAppIfReady();
+    });
+}
+
+void ConditionsNavigator::loadMap()
+{
+    Tracer::instance().addAsyncBegin("mapLoad", 0);
+    connect(m_map, &Map::loadStatusChanged, this, [this](){
+        if (m_map->loadStatus() == LoadStatus::Loaded)
+        {
+            Tracer::instance().addAsyncEnd("mapLoad", 0);
+            initialiseAppIfReady();
+        }
+    });
+
+    // Start loading the basemap now rather than when the map view is supplied from QML.
+    m_map->load();
+}
+
+void ConditionsNavigator::initialiseAppIfReady()
+{
+    const bool ready = m_baseSymbol && m_mapView && m_map->loadStatus() == LoadStatus::Loaded;
+    if (m_appInitialised || !ready)
+        return;
+
+    m_appInitialised = true;
+    initialiseApp();
+}
+
+void ConditionsNavigator::createDifferentColouredVersionsOfPinSymbol(Symbol* const symbol)
+{
+    m_baseSymbol = dynamic_cast<MultilayerPointSymbol*>(symbol);
+    m_baseSymbol->setColor(QColor::fromString("indianred"));
+
+    m_greenSymbol = createCopyOfPointSymbol(m_baseSymbol);
+    m_greenSymbol->setColor(QColor::fromString("green"));
+
+    m_orangeSymbol = createCopyOfPointSymbol(m_baseSymbol);
+    m_orangeSymbol->setColor(QColor::fromString("orange"));
+
+    m_redSymbol = createCopyOfPointSymbol(m_baseSymbol);
+    m_redSymbol->setColor(QColor::fromString("red"));
+
+    m_unknownSymbol = createCopyOfPointSymbol(m_baseSymbol);
+    m_unknownSymbol->setColor(QColor::fromString("darkgray"));
+}
+
+MultilayerPointSymbol* ConditionsNavigator::createCopyOfPointSymbol(MultilayerPointSymbol* const symbol)
+{
+    // MultilayerPointSymbol does not have copy constructor, so a new MultilayerPointSymbol object
+    // needs to be created from a list containing each symbol layer.
+    const SymbolLayerListModel* listModel = symbol->symbolLayers();
+    QList<SymbolLayer*> listOfSymbolLayers;
+    for (int counter = 0; counter < listModel->size(); ++counter)
+        listOfSymbolLayers.append(listModel->at(counter)->clone());
+    return new MultilayerPointSymbol(listOfSymbolLayers, this);
+}
+
+void ConditionsNavigator::loadMountainsAndRetrieveForecastData()
+{
+    {
+        TRACE_SCOPE("loadMountainLocations");
+        MountainLocations mountainLocations{this};
+        m_mountains = mountainLocations.getLocations();
+    }
+    m_detailViewCache->watch(m_mountains);
+    m_searchModel->setMountains(m_mountains);
+    m_viewportLoader->setMountains(m_mountains);
+    m_refreshPlanner->setMountains(m_mountains);
+
+    // A pin is only recoloured when the daily values it is classified from change. Any days pushed by
+    // the service are out of date once a forecast arrives, which is signalled first.
+    for (Mountain* mountain : std::as_const(m_mountains))
+    {
+        connect(mountain, &Mountain::forecastUpdated, this, [this, mountain]()
+        {
+            m_pushedDayChanges.remove(mountain);
+        });
+        connect(mountain, &Mountain::dailyForecastChanged, this, [this, mountain]()
+        {
+            if (m_viewportLoader->isLoaded(mountain))
+                recolourLoadedMountain(mountain);
+        });
+    }
+
+    // Until the map view reports what it shows, load what the initial viewpoint will show.
+    m_viewportLoader->setViewport(initialViewport(m_mountains));
+    m_viewportLoader->planLoading();
+    startForecastSubscription();
+
+    emit mountainsChanged();
+}
+
+void ConditionsNavigator::initialiseApp()
+{
+    TRACE_SCOPE("initialiseApp");
+
+    displayMountainsOnMap();
+    setInitialViewpoint();
+    setupInteractionBehaviour();
+    connect(m_mapView, &MapQuickView::viewpointChanged, this, &ConditionsNavigator::updateViewportFromMapView);
+
+    // Colour the pins using any forecasts that arrived while the map was loading.
+    filterOptionsChanged();
+}
+
+void ConditionsNavigator::displayMountainsOnMap()
+{
+    TRACE_SCOPE("displayMountainsOnMap");
+
+    if (m_mountainsOverlay == nullptr)
+    {
+        m_mountainsOverlay = new GraphicsOverlay(this);
+        setupLabeling();
+    }
+
+    for (Mountain* mountain : m_mountains)
+    {
+        const double mountainsLongitude = mountain->getLongitude();
+        const double mountainsLatitude = mountain->getLatitude();
+        const QString mountainName = mountain->getName();
+
+        const Point mountainPoint(mountainsLongitude, mountainsLatitude, SpatialReference::wgs84());
+        MultilayerPointSymbol* symbol = m_viewportLoader->isLoaded(mountain) ? m_baseSymbol : m_unknownSymbol;
+        Graphic* pointGraphic = new Graphic(mountainPoint, symbol, this);
+        pointGraphic->attributes()->insertAttribute("Name", mountainName);
+        mountain->mountainGraphic = pointGraphic;
+        m_mountainsOverlay->graphics()->append(pointGraphic);
+    }
+
+    m_mapView->graphicsOverlays()->append(m_mountainsOverlay);
+}
+
+void ConditionsNavigator::setupLabeling()
+{
+    SimpleLabelExpression* labelExpression = new SimpleLabelExpression("[Name]", this);
+
+    TextSymbol* textSymbol = new TextSymbol(this);
+    textSymbol->setFontWeight(FontWeight::Bold);
+    textSymbol->setSize(11);
+    textSymbol->setColor(Qt::black);
+
+    LabelDefinition* labelDefinition = new LabelDefinition(labelExpression, textSymbol, this);
+    m_mountainsOverlay->labelDefinitions()->append(labelDefinition);
+    m_mountainsOverlay->setLabelsEnabled(true);
+}
+
+void ConditionsNavigator::setInitialViewpoint()
+{
+    const Envelope extent = m_mountainsOverlay->extent();
+    const double bufferSize = extent.height() * 0.1;
+    const double maxDeviationBetweenPoints = 100;
+    const Polygon expandedExtent = GeometryEngine::bufferGeodetic(
+                extent,
+                bufferSize,
+                LinearUnit::meters(),
+                maxDeviationBetweenPoints,
+                GeodeticCurveType::Geodesic);
+    const Viewpoint viewpoint(expandedExtent);
+    m_mapView->setViewpointAsync(viewpoint);
+}
+
+void ConditionsNavigator::retrieveForecastData() const
+{
+    TRACE_SCOPE("retrieveForecastData");
+    m_viewportLoader->reload();
+}
+
+void ConditionsNavigator::setupViewportLoading()
+{
+    // Forecasts are only requested for mountains in or near the part of the map that is in view.
+    m_viewportLoader->setBufferPool(&openMeteoForecast.getBufferPool());
+    connect(m_viewportLoader, &ForecastViewportLoader::loadRequested, this, [this](Mountain* mountain)
+    {
+        m_refreshPlanner->recordRequest();
+        openMeteoForecast.MakeRequest(mountain->getLongitude(), mountain->getLatitude(), mountain->getElevation(), mountain);
+    });
+    connect(&openMeteoForecast, &OpenMeteoForecastSource::forecastFailed, m_viewportLoader, &ForecastViewportLoader::loadFailed);
+    connect(m_viewportLoader, &ForecastViewportLoader::forecastLoaded, this, [this](Mountain* mountain)
+    {
+        if (mountain == m_mountainToSelect)
+            setSelectedMountain(mountain);
+    });
+    connect(m_viewportLoader, &ForecastViewportLoader::forecastEvicted, this, [this](Mountain* mountain)
+    {
+        setMountainSymbol(mountain, ConditionsClassifier::Conditions::Unknown);
+    });
+}
+
+void ConditionsNavigator::updateViewportFromMapView() const
+{
+    const Polygon visibleArea = m_mapView->visibleArea();
+    if (visibleArea.isEmpty())
+        return;
+
+    // With wraparound the extent can run past the antimeridian, in which case only the part
+    // between -180 and 180 degrees is loaded.
+    const Envelope extent = GeometryEngine::project(visibleArea, SpatialReference::wgs84()).extent();
+    const QRectF viewport(QPointF(extent.xMin(), extent.yMin()), QPointF(extent.xMax(), extent.yMax()));
+    m_viewportLoader->setViewport(viewport);
+    m_refreshPlanner->setViewport(viewport);
+}
+
+void ConditionsNavigator::setupRefreshPlanning()
+{
+    // Stale forecasts are requested again within the daily budget of requests to Open-Meteo.
+    connect(m_refreshPlanner, &RefreshPlanner::refreshRequested, this, [](Mountain* mountain)
+    {
+        openMeteoForecast.MakeRequest(mountain->getLongitude(), mountain->getLatitude(), mountain->getElevation(), mountain);
+    });
+    connect(&openMeteoForecast, &OpenMeteoForecastSource::forecastFailed, m_refreshPlanner, &RefreshPlanner::refreshFailed);
+
+    // A ConditionsNavigatorService keeps its forecasts up to date itself and pushes the changes (see
+    // startForecastSubscription), so only forecasts from Open-Meteo are refreshed here. Requests to the
+    // service are answered from its cache and cost nothing against Open-Meteo's budget. Nothing is
+    // refreshed while the app is hidden or in the background.
+    if (!qEnvironmentVariable("CONDITIONS_NAVIGATOR_FORECAST_URL").isEmpty())
+    {
+        m_refreshPlanner->setRequestCost(0.0);
+        return;
+    }
+    m_refreshPlanner->setRequestCost(openMeteoForecast.getRequestCost());
+
+    const auto isForeground = [](Qt::ApplicationState state)
+    {
+        return state != Qt::ApplicationHidden && state != Qt::ApplicationSuspended;
+    };
+    m_refreshPlanner->setActive(isForeground(QGuiApplication::applicationState()));
+    connect(qGuiApp, &QGuiApplication::applicationStateChanged, m_refreshPlanner, [this, isForeground](Qt::ApplicationState state)
+    {
+        m_refreshPlanner->setActive(isForeground(state));
+    });
+}
+
+void ConditionsNavigator::recolourLoadedMountain(Mountain* mountain) const
+{
+    // Graphics, and the filter toggles, only exist once the map has loaded.
+    if (mountain->mountainGraphic == nullptr)
+        return;
+
+    const QList<int> selectedDays = identifyWhichFilterOptionsAreChecked();
+    if (selectedDays.isEmpty())
+    {
+        m_refreshPlanner->setFilteredGood(mountain, false);
+        mountain->mountainGraphic->setSymbol(m_baseSymbol);
+    }
+    else
+        setMountainSymbol(mountain, classifyDays(mountain, selectedDays));
+}
+
+void ConditionsNavigator::setupInteractionBehaviour()
+{
+    connect(m_mapView, &MapQuickView::mouseClicked, this, [this](QMouseEvent& mouseEvent)
+    {
+        const double identifyTolerance = 15;
+        const bool returnPopups = false;
+
+        m_mapView->identifyGraphicsOverlayAsync(m_mountainsOverlay,
+                                                mouseEvent.position(),
+                                                identifyTolerance,
+                                                returnPopups).then([this](IdentifyGraphicsOverlayResult* rawIdentifyResult){
+          selectMountain(rawIdentifyResult);
+        });
+    });
+
+    connect(m_mapView, &MapQuickView::touched, this, [this](QTouchEvent& touchEvent)
+    {
+        const QEventPoint touchPoint = touchEvent.point(0);
+
+        const double identifyTolerance = 15;
+        const bool returnPopups = false;
+
+        m_mapView->identifyGraphicsOverlayAsync(m_mountainsOverlay,
+                                                touchEvent.points().first().position(),
+                                                identifyTolerance,
+                                                returnPopups).then([this](IdentifyGraphicsOverlayResult* rawIdentifyResult){
+          selectMountain(rawIdentifyResult);
+        });
+    });
+}
+
+void ConditionsNavigator::selectMountain(IdentifyGraphicsOverlayResult* const rawIdentifyResult)
+{
+  // Delete rawIdentifyResult on leaving scope.
+  const auto identifyResult = std::unique_ptr<IdentifyGraphicsOverlayResult>(rawIdentifyResult);
+
+  const bool identifyResultNullOrEmpty = !identifyResult || identifyResult.get()->graphics().isEmpty();
+
+  if (identifyResultNullOrEmpty)
+  {
+      setSelectedMountain(nullptr);
+  }
+  else
+  {
+      const QString nameOfSelectedMountain = identifyResult.get()->graphics().first()->attributes()->attributeValue("Name").toString();
+      setSelectedMountain(getSelectedMountain(nameOfSelectedMountain));
+  }
+}
+
+void ConditionsNavigator::assignLabelsToUIFilterOptions()
+{
+    const QDate currentDate = QDate::currentDate();
+    const int forecastDays = openMeteoForecast.getForecastDays();
+
+    // Beyond a week the names of the days repeat, so the day of the month is added.
+    const QString format = forecastDays > 7 ? QString{"ddd d"} : QString{"ddd"};
+
+    m_filterDayLabels.clear();
+    for (int counter = 0; counter < forecastDays; ++counter)
+        m_filterDayLabels.append(currentDate.addDays(counter).toString(format));
+    emit filterDayLabelsChanged();
+}
+
+Mountain* ConditionsNavigator::getSelectedMountain(const QString& name) const
+{
+    for (Mountain* mountain : m_mountains)
+    {
+        if (mountain->getName() == name)
+             return mountain;
+    }
+    return nullptr;
+}
+
+void ConditionsNavigator::applyFilter(const QList<int>& selectedDays) const
+{
+    TRACE_SCOPE("applyFilter");
+    const ScopedMetricsTimer filterTimer(&Metrics::recordFilterEvaluation);
+
+    // Only mountains with a forecast are classified. The others show as unknown until they are loaded.
+    for (Mountain* mountain : m_viewportLoader->loadedMountains())
+        setMountainSymbol(mountain, classifyDays(mountain, selectedDays));
+}
+
+void ConditionsNavigator::setMountainSymbol(Mountain* mountain, ConditionsClassifier::Conditions conditions) const
+{
+    // Mountains that are good on the filtered days are kept fresher than the rest.
+    m_refreshPlanner->setFilteredGood(mountain, conditions == ConditionsClassifier::Conditions::Good);
+
+    // Graphics are only created once the map has loaded.
+    if (mountain->mountainGraphic == nullptr)
+        return;
+
+    switch (conditions)
+    {
+    case ConditionsClassifier::Conditions::Bad:
+        mountain->mountainGraphic->setSymbol(m_redSymbol);
+        break;
+    case ConditionsClassifier::Conditions::Marginal:
+        mountain->mountainGraphic->setSymbol(m_orangeSymbol);
+        break;
+    case ConditionsClassifier::Conditions::Good:
+        mountain->mountainGraphic->setSymbol(m_greenSymbol);
+        break;
+    case ConditionsClassifier::Conditions::Unknown:
+        // No forecast has been loaded for this mountain, or it was dropped when the map moved away.
+        mountain->mountainGraphic->setSymbol(m_unknownSymbol);
+        break;
+    }
+}
+
+void ConditionsNavigator::startForecastSubscription()
+{
+    // Changes are pushed only when the forecasts come from a ConditionsNavigatorService.
+    const QString forecastUrl = qEnvironmentVariable("CONDITIONS_NAVIGATOR_FORECAST_URL");
+    if (forecastUrl.isEmpty())
+        return;
+
+    m_forecastSubscription = new ForecastSubscription(this);
+    m_forecastSubscription->setLocationCount(static_cast<quint32>(m_mountains.size()));
+    connect(m_forecastSubscription, &ForecastSubscription::changesReceived, this, &ConditionsNavigator::applyForecastChanges);
+    m_forecastSubscription->start(ForecastSubscription::webSocketUrlFor(QUrl(forecastUrl)));
+}
+
+void ConditionsNavigator::applyForecastChanges(const QList<ForecastDelta::LocationChange>& changes, bool isSnapshot)
+{
+    TRACE_SCOPE("applyForecastChanges");
+
+    // Locations are identified by their position in the service's catalog, which the subscription has
+    // checked is the same size as this one.
+    // The first snapshot describes the forecasts that are already being retrieved. A later one means the
+    // service restarted, so everything is retrieved again.
+    if (isSnapshot)
+    {
+        if (m_receivedForecastSnapshot)
+            retrieveForecastData();
+        m_receivedForecastSnapshot = true;
+        return;
+    }
+
+    const ScopedMetricsTimer applyTimer(&Metrics::recordDeltaApply);
+    const QList<int> selectedDays = identifyWhichFilterOptionsAreChecked();
+
+    for (const ForecastDelta::LocationChange& change : changes)
+    {
+        Mountain* const mountain = m_mountains.value(change.location);
+        // Mountains without a forecast pick up the change when they come into view.
+        if (mountain == nullptr || !m_viewportLoader->isLoaded(mountain))
+            continue;
+
+        // The pushed days replace those of earlier pushes, and are used in place of the mountain's own
+        // until its forecast is retrieved again.
+        QList<ForecastDelta::DayChange>& pushedDays = m_pushedDayChanges[mountain];
+        for (const ForecastDelta::DayChange& dayChange : change.days)
+        {
+            const auto pushedDay = std::find_if(pushedDays.begin(), pushedDays.end(), [&dayChange](const ForecastDelta::DayChange& day)
+            {
+                return day.day == dayChange.day;
+            });
+            if (pushedDay == pushedDays.end())
+                pushedDays.append(dayChange);
+            else
+                *pushedDay = dayChange;
+        }
+
+        // Only the pins of changed mountains are recoloured, straight from the pushed conditions.
+        if (!selectedDays.isEmpty())
+            setMountainSymbol(mountain, classifyDays(mountain, selectedDays));
+
+        // The hourly data behind the charts and table is only retrieved from the service for the mountain
+        // on show. The others are retrieved when they are selected, so a push costs no more than the delta.
+        if (mountain == m_selectedMountain)
+            openMeteoForecast.MakeRequest(mountain->getLongitude(), mountain->getLatitude(), mountain->getElevation(), mountain);
+    }
+}
+
+ConditionsClassifier::Conditions ConditionsNavigator::classifyDays(Mountain* mountain, const QList<int>& selectedDays) const
+{
+    const auto pushedDays = m_pushedDayChanges.constFind(mountain);
+    if (pushedDays == m_pushedDayChanges.cend())
+        return m_classifier.classifyDays(mountain, selectedDays);
+
+    // As ConditionsClassifier::classifyDays, with the conditions pushed for a day in place of the
+    // mountain's own.
+    ConditionsClassifier::Conditions worstConditions = ConditionsClassifier::Conditions::Good;
+    for (int day : selectedDays)
+    {
+        ConditionsClassifier::Conditions conditions = m_classifier.classifyDay(mountain, day);
+        for (const ForecastDelta::DayChange& dayChange : *pushedDays)
+        {
+            if (dayChange.day == day)
+                conditions = dayChange.conditions;
+        }
+
+        if (conditions == ConditionsClassifier::Conditions::Unknown)
+            return conditions;
+        worstConditions = std::max(worstConditions, conditions);
+    }
+    return worstConditions;
+}
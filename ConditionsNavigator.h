@@ -1,88 +1,140 @@
-// Copyright 2023 Esri
-
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-
-// Unless required by applicable law or agreed to in writing, software
-// distributed under the License is distributed on an "AS IS" BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-// See the License for the specific language governing permissions and
-// limitations under the License.
-
-#ifndef CONDITIONSNAVIGATOR_H
-#define CONDITIONSNAVIGATOR_H
-
-namespace Esri::ArcGISRuntime {
-class GraphicsOverlay;
-class IdentifyGraphicsOverlayResult;
-class Map;
-class MapQuickView;
-class MultilayerPointSymbol;
-class Symbol;
-} // namespace Esri::ArcGISRuntime
-
-class QMouseEvent;
-
-#include <QObject>
-
-#include "Mountain.h"
-
-Q_MOC_INCLUDE("MapQuickView.h")
-
-class ConditionsNavigator : public QObject
-{
-    Q_OBJECT
-
-    Q_PROPERTY(Esri::ArcGISRuntime::MapQuickView* mapView READ mapView WRITE setMapView NOTIFY mapViewChanged)
-    Q_PROPERTY(Mountain* selectedMountain READ selectedMountain NOTIFY selectedMountainChanged)
-
-public:
-    explicit ConditionsNavigator(QObject* parent = nullptr);
-    ~ConditionsNavigator() override;
-
-    Q_INVOKABLE void clearCurrentFilter() const;
-    Q_INVOKABLE void filterOptionsChanged();
-
-signals:
-    void mapViewChanged();
-    void selectedMountainChanged();
-
-private:
-    bool anyBadConditionForecastForDay(Mountain* mountain, int day) const;
-    bool anyMarginalConditionForecastForDay(Mountain* mountain, int day) const;
-    void applyFilter(const QList<int>& selectedDays) const;
-    void assignLabelsToUIFilterOptions();
-    bool conditionsDescriptionIsConcerning(const QString& condition) const;
-    Esri::ArcGISRuntime::MultilayerPointSymbol* createCopyOfPointSymbol(Esri::ArcGISRuntime::MultilayerPointSymbol* const symbol);
-    void createDifferentColouredVersionsOfPinSymbol(Esri::ArcGISRuntime::Symbol* const symbol);
-    void displayMountainsOnMap();
-    void getPinSymbolFromPortalThenInitialiseApp();
-    Mountain* getSelectedMountain(const QString& name) const;
-    QList<int> identifyWhichFilterOptionsAreChecked() const;
-    void initialiseApp();
-    Esri::ArcGISRuntime::MapQuickView* mapView() const;
-    void retrieveForecastData() const;
-    Mountain* selectedMountain() const;
-    void selectMountain(Esri::ArcGISRuntime::IdentifyGraphicsOverlayResult* const rawIdentifyResult);
-    void setInitialViewpoint();
-    void setMapView(Esri::ArcGISRuntime::MapQuickView* const mapView);
-    void setupInteractionBehaviour();
-    void setupLabeling();
-    void getReferencesToFilterOptionToggles();
-    void waitUntilMapIsLoadedThenInitialiseApp();
-
-    Esri::ArcGISRuntime::MultilayerPointSymbol* m_baseSymbol = nullptr;
-    QList<QObject*> m_filterToggles;
-    Esri::ArcGISRuntime::MultilayerPointSymbol* m_greenSymbol = nullptr;
-    QList<Mountain*> m_mountains;
-    Esri::ArcGISRuntime::GraphicsOverlay* m_mountainsOverlay = nullptr;
-    Esri::ArcGISRuntime::Map* m_map = nullptr;
-    Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
-    Esri::ArcGISRuntime::MultilayerPointSymbol* m_orangeSymbol = nullptr;
-    Esri::ArcGISRuntime::MultilayerPointSymbol* m_redSymbol = nullptr;
-    Mountain* m_selectedMountain = nullptr;
-};
-
-#endif // CONDITIONSNAVIGATOR_H
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONDITIONSNAVIGATOR_H
+#define CONDITIONSNAVIGATOR_H
+
+namespace Esri::ArcGISRuntime {
+class GraphicsOverlay;
+class IdentifyGraphicsOverlayResult;
+class Map;
+class MapQuickView;
+class MultilayerPointSymbol;
+class Symbol;
+} // namespace Esri::ArcGISRuntime
+
+class ForecastSubscription;
+class QMouseEvent;
+
+#include <QHash>
+#include <QObject>
+
+#include "ConditionsClassifier.h"
+#include "DetailViewCache.h"
+#include "ForecastDelta.h"
+#include "ForecastTableModel.h"
+#include "ForecastViewportLoader.h"
+#include "Mountain.h"
+#include "MountainSearchModel.h"
+#include "RefreshPlanner.h"
+
+Q_MOC_INCLUDE("MapQuickView.h")
+
+class ConditionsNavigator : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(Esri::ArcGISRuntime::MapQuickView* mapView READ mapView WRITE setMapView NOTIFY mapViewChanged)
+    Q_PROPERTY(Mountain* selectedMountain READ selectedMountain NOTIFY selectedMountainChanged)
+    Q_PROPERTY(DetailViewCache* detailViewCache READ detailViewCache CONSTANT)
+    Q_PROPERTY(ForecastTableModel* forecastTableModel READ forecastTableModel CONSTANT)
+    Q_PROPERTY(ForecastViewportLoader* viewportLoader READ viewportLoader CONSTANT)
+    Q_PROPERTY(MountainSearchModel* searchModel READ searchModel CONSTANT)
+    // One label and filter option for each day of the forecast.
+    Q_PROPERTY(QStringList filterDayLabels READ filterDayLabels NOTIFY filterDayLabelsChanged)
+    Q_PROPERTY(QList<int> selectedFilterDays READ identifyWhichFilterOptionsAreChecked NOTIFY selectedFilterDaysChanged)
+
+public:
+    explicit ConditionsNavigator(QObject* parent = nullptr);
+    ~ConditionsNavigator() override;
+
+    Q_INVOKABLE void clearCurrentFilter();
+    Q_INVOKABLE void filterOptionsChanged();
+    Q_INVOKABLE void setFilterDayChecked(int day, bool checked);
+    // Centres the map on the mountain and selects it, as if its pin had been clicked.
+    Q_INVOKABLE void showMountain(Mountain* mountain);
+
+    const ConditionsClassifier& classifier() const;
+    const QList<Mountain*>& mountains() const;
+
+signals:
+    void filterDayLabelsChanged();
+    void mapViewChanged();
+    void mountainsChanged();
+    void selectedFilterDaysChanged();
+    void selectedMountainChanged();
+
+private:
+    void applyFilter(const QList<int>& selectedDays) const;
+    void applyForecastChanges(const QList<ForecastDelta::LocationChange>& changes, bool isSnapshot);
+    void assignLabelsToUIFilterOptions();
+    ConditionsClassifier::Conditions classifyDays(Mountain* mountain, const QList<int>& selectedDays) const;
+    Esri::ArcGISRuntime::MultilayerPointSymbol* createCopyOfPointSymbol(Esri::ArcGISRuntime::MultilayerPointSymbol* const symbol);
+    void createDifferentColouredVersionsOfPinSymbol(Esri::ArcGISRuntime::Symbol* const symbol);
+    DetailViewCache* detailViewCache() const;
+    void displayMountainsOnMap();
+    QStringList filterDayLabels() const;
+    void getPinSymbolFromPortal();
+    Mountain* getSelectedMountain(const QString& name) const;
+    ForecastTableModel* forecastTableModel() const;
+    QList<int> identifyWhichFilterOptionsAreChecked() const;
+    void initialiseApp();
+    void initialiseAppIfReady();
+    void loadMap();
+    void loadMountainsAndRetrieveForecastData();
+    void loadPinSymbol();
+    Esri::ArcGISRuntime::MapQuickView* mapView() const;
+    void retrieveForecastData() const;
+    void recolourLoadedMountain(Mountain* mountain) const;
+    MountainSearchModel* searchModel() const;
+    Mountain* selectedMountain() const;
+    void selectMountain(Esri::ArcGISRuntime::IdentifyGraphicsOverlayResult* const rawIdentifyResult);
+    void setInitialViewpoint();
+    void setMapView(Esri::ArcGISRuntime::MapQuickView* const mapView);
+    void setSelectedMountain(Mountain* mountain);
+    void setMountainSymbol(Mountain* mountain, ConditionsClassifier::Conditions conditions) const;
+    void setupInteractionBehaviour();
+    void setupLabeling();
+    void setupRefreshPlanning();
+    void setupViewportLoading();
+    void startForecastSubscription();
+    ForecastViewportLoader* viewportLoader() const;
+    void updateViewportFromMapView() const;
+
+    Esri::ArcGISRuntime::MultilayerPointSymbol* m_baseSymbol = nullptr;
+    ConditionsClassifier m_classifier;
+    DetailViewCache* m_detailViewCache = nullptr;
+    QList<int> m_checkedFilterDays;
+    QStringList m_filterDayLabels;
+    // The days pushed by the service for each loaded mountain since its forecast was last retrieved.
+    QHash<const Mountain*, QList<ForecastDelta::DayChange>> m_pushedDayChanges;
+    ForecastSubscription* m_forecastSubscription = nullptr;
+    ForecastTableModel* m_forecastTableModel = nullptr;
+    Esri::ArcGISRuntime::MultilayerPointSymbol* m_greenSymbol = nullptr;
+    QList<Mountain*> m_mountains;
+    Esri::ArcGISRuntime::GraphicsOverlay* m_mountainsOverlay = nullptr;
+    Esri::ArcGISRuntime::Map* m_map = nullptr;
+    Esri::ArcGISRuntime::MapQuickView* m_mapView = nullptr;
+    Mountain* m_mountainToSelect = nullptr;
+    Esri::ArcGISRuntime::MultilayerPointSymbol* m_orangeSymbol = nullptr;
+    Esri::ArcGISRuntime::MultilayerPointSymbol* m_redSymbol = nullptr;
+    RefreshPlanner* m_refreshPlanner = nullptr;
+    MountainSearchModel* m_searchModel = nullptr;
+    Mountain* m_selectedMountain = nullptr;
+    Esri::ArcGISRuntime::MultilayerPointSymbol* m_unknownSymbol = nullptr;
+    ForecastViewportLoader* m_viewportLoader = nullptr;
+    bool m_appInitialised = false;
+    bool m_receivedForecastSnapshot = false;
+};
+
+#endif // CONDITIONSNAVIGATOR_H
@@ -0,0 +1,195 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DailyAggregator.h"
+#include "SolarEphemeris.h"
+#include "Tracer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr double degreesToRadians = 3.14159265358979323846 / 180.0;
+
+    using DayRange = DailyAggregator::DayRange;
+
+    // Each reduction is a plain loop over a contiguous range, with excluded hours masked out by a
+    // select rather than a branch, so that it can be vectorised.
+    double sum(const QList<double>& values, const std::vector<double>& mask, const DayRange& day)
+    {
+        double total = 0.0;
+        const double* const data = values.constData();
+        for (qsizetype index = day.begin; index < day.end; ++index)
+            total += data[index] * mask[index];
+        return total;
+    }
+
+    // Wind speeds and weather codes are never negative, so excluded hours can be treated as 0.
+    double maximum(const QList<double>& values, const std::vector<double>& mask, const DayRange& day)
+    {
+        double largest = 0.0;
+        const double* const data = values.constData();
+        for (qsizetype index = day.begin; index < day.end; ++index)
+        {
+            const double value = data[index] * mask[index];
+            largest = value > largest ? value : largest;
+        }
+        return largest;
+    }
+
+    // Wind chills can be below 0, so excluded hours are treated as infinitely warm. A day with no
+    // included hours, or no values, has no minimum.
+    double minimum(const QList<double>& values, const std::vector<double>& mask, const DayRange& day)
+    {
+        double smallest = std::numeric_limits<double>::infinity();
+        const double* const data = values.constData();
+        for (qsizetype index = day.begin; index < day.end; ++index)
+        {
+            const double value = mask[index] > 0.0 ? data[index] : std::numeric_limits<double>::infinity();
+            smallest = value < smallest ? value : smallest;
+        }
+        return std::isinf(smallest) ? std::numeric_limits<double>::quiet_NaN() : smallest;
+    }
+
+    // Hours with no value are not counted.
+    int countBelow(const QList<double>& values, double threshold, const std::vector<double>& mask, const DayRange& day)
+    {
+        double count = 0.0;
+        const double* const data = values.constData();
+        for (qsizetype index = day.begin; index < day.end; ++index)
+            count += (data[index] < threshold ? 1.0 : 0.0) * mask[index];
+        return static_cast<int>(count);
+    }
+
+    // Like Open-Meteo, the dominant direction is the direction of the mean wind vector, so strong winds
+    // count for more than light ones. Directions are those the wind blows from, in degrees.
+    int dominantDirection(const QList<double>& directions, const QList<double>& speeds,
+                          const std::vector<double>& mask, const DayRange& day)
+    {
+        double east = 0.0;
+        double north = 0.0;
+        for (qsizetype index = day.begin; index < day.end; ++index)
+        {
+            const double weight = mask[index] * (index < speeds.size() ? speeds.at(index) : 1.0);
+            const double direction = directions.at(index) * degreesToRadians;
+            east += weight * std::sin(direction);
+            north += weight * std::cos(direction);
+        }
+
+        const double direction = std::atan2(east, north) / degreesToRadians;
+        return static_cast<int>(std::lround(direction < 0.0 ? direction + 360.0 : direction)) % 360;
+    }
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+DailyAggregator::DailySeries DailyAggregator::aggregate(const HourlySeries& hourly, int firstHour, int lastHour)
+{
+    TRACE_SCOPE("aggregateDaily");
+
+    const QList<DayRange> days = findDays(hourly.time);
+    std::vector<double> mask(hourly.time.size(), 0.0);
+    for (qsizetype index = 0; index < hourly.time.size(); ++index)
+    {
+        const int hour = hourly.time.getHour(index);
+        mask[index] = hour >= firstHour && hour < lastHour ? 1.0 : 0.0;
+    }
+    return reduce(hourly, days, mask);
+}
+
+DailyAggregator::DailySeries DailyAggregator::aggregate(const HourlySeries& hourly, double latitude, double longitude,
+                                                        double elevation, double solarAltitude)
+{
+    TRACE_SCOPE("aggregateDaily");
+
+    const QList<DayRange> days = findDays(hourly.time);
+    SolarEphemeris::Batch batch;
+    for (const DayRange& day : days)
+        batch.append(latitude, longitude, elevation, day.date);
+    const SolarEphemeris::Windows daylight = SolarEphemeris::compute(batch, solarAltitude);
+
+    // An hour is included if its time is within the daylight of its day.
+    std::vector<double> mask(hourly.time.size(), 0.0);
+    for (qsizetype day = 0; day < days.size(); ++day)
+    {
+        for (qsizetype index = days.at(day).begin; index < days.at(day).end; ++index)
+        {
+            const qint64 seconds = hourly.time.getUtcSeconds(index);
+            mask[index] = seconds >= daylight.begin.at(day) && seconds <= daylight.end.at(day) ? 1.0 : 0.0;
+        }
+    }
+    return reduce(hourly, days, mask);
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+QList<DailyAggregator::DayRange> DailyAggregator::findDays(const TimeAxis& time)
+{
+    QList<DayRange> days;
+    for (qsizetype index = 0; index < time.size(); ++index)
+    {
+        const QDate date = time.getDate(index);
+        if (days.isEmpty() || days.last().date != date)
+            days.append({date, index, index});
+        days.last().end = index + 1;
+    }
+    return days;
+}
+
+DailyAggregator::DailySeries DailyAggregator::reduce(const HourlySeries& hourly, const QList<DayRange>& days, const std::vector<double>& mask)
+{
+    DailySeries daily;
+    const qsizetype numberOfHours = hourly.time.size();
+    if (numberOfHours == 0)
+        return daily;
+
+    // Series that are shorter than the times are not used.
+    const auto usable = [numberOfHours](const QList<double>& series) {
+        return series.size() >= numberOfHours;
+    };
+
+    daily.dates.reserve(days.size());
+    for (const DayRange& day : std::as_const(days))
+    {
+        daily.dates.append(day.date);
+
+        if (usable(hourly.precipitation))
+            daily.precipitationSum.append(std::round(sum(hourly.precipitation, mask, day) * 100.0) / 100.0);
+        if (usable(hourly.windSpeed))
+            daily.windSpeedMax.append(maximum(hourly.windSpeed, mask, day));
+        if (usable(hourly.windGusts))
+            daily.windGustsMax.append(maximum(hourly.windGusts, mask, day));
+        if (usable(hourly.windDirection))
+            daily.windDirectionDominant.append(dominantDirection(hourly.windDirection, hourly.windSpeed, mask, day));
+
+        // WMO weather codes increase with severity, so the most severe weather of the day is the largest.
+        if (usable(hourly.weatherCode))
+            daily.weatherCode.append(static_cast<int>(maximum(hourly.weatherCode, mask, day)));
+
+        if (usable(hourly.windChill))
+            daily.minimumWindChill.append(minimum(hourly.windChill, mask, day));
+        if (usable(hourly.freezingLevelMargin))
+            daily.freezingLevelBelowSummitHours.append(countBelow(hourly.freezingLevelMargin, 0.0, mask, day));
+        if (usable(hourly.summitInCloud))
+            daily.summitInCloudHours.append(static_cast<int>(sum(hourly.summitInCloud, mask, day)));
+    }
+    return daily;
+}
@@ -0,0 +1,82 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAILYAGGREGATOR_H
+#define DAILYAGGREGATOR_H
+
+#include <QDate>
+#include <QList>
+
+#include <vector>
+
+#include "TimeAxis.h"
+
+// Derives the daily values Open-Meteo would otherwise send in its daily block from the hourly series.
+// Days are the calendar days of the hourly times in the mountain's own timezone, and the aggregates
+// can be limited to fixed hours of each day or to the daylight at the mountain. The hazards derived by HazardKernel are summed up
+// for each day in the same way. A daily series is only produced when its hourly series is given.
+class DailyAggregator
+{
+public:
+    struct HourlySeries
+    {
+        TimeAxis time;
+        QList<double> precipitation;
+        QList<double> windSpeed;
+        QList<double> windGusts;
+        QList<double> windDirection;
+        QList<double> weatherCode;
+        // Derived by HazardKernel.
+        QList<double> windChill;
+        QList<double> freezingLevelMargin;
+        QList<double> summitInCloud;
+    };
+
+    struct DailySeries
+    {
+        QList<QDate> dates;
+        QList<double> precipitationSum;
+        QList<double> windSpeedMax;
+        QList<double> windGustsMax;
+        QList<int> windDirectionDominant;
+        QList<int> weatherCode;
+        QList<double> minimumWindChill;
+        QList<int> freezingLevelBelowSummitHours;
+        QList<int> summitInCloudHours;
+    };
+
+    // Hours from firstHour up to, but not including, lastHour are aggregated; 0 and 24 is the whole day.
+    static DailySeries aggregate(const HourlySeries& hourly, int firstHour = 0, int lastHour = 24);
+    // Only the hours in daylight at the location, worked out for each day by SolarEphemeris, are
+    // aggregated. Daylight starts and ends when the sun is at the given altitude, such as
+    // SolarEphemeris::sunriseAltitude or SolarEphemeris::civilTwilightAltitude.
+    static DailySeries aggregate(const HourlySeries& hourly, double latitude, double longitude, double elevation, double solarAltitude);
+
+    // The hours of a day, as a range of indices into the hourly series.
+    struct DayRange
+    {
+        QDate date;
+        qsizetype begin = 0;
+        qsizetype end = 0;
+    };
+
+    // The entries of each day on the axis. Past the full-resolution hours of a tiered axis a day has
+    // fewer entries, so these are used wherever entries are grouped into days.
+    static QList<DayRange> findDays(const TimeAxis& time);
+
+private:
+    // The mask is 1 for the hours that are included and 0 for the others.
+    static DailySeries reduce(const HourlySeries& hourly, const QList<DayRange>& days, const std::vector<double>& mask);
+};
+
+#endif // DAILYAGGREGATOR_H
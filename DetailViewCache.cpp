@@ -0,0 +1,275 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DetailViewCache.h"
+#include "ChartSeriesFeeder.h"
+#include "Mountain.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace
+{
+    // Enough for several hundred fully prepared mountains with tiered 16 day forecasts (see ForecastTiering).
+    constexpr qsizetype maximumCacheSizeInBytes = 8 * 1024 * 1024;
+
+    constexpr ChartSeriesFeeder::Variable chartVariables[] = {
+        ChartSeriesFeeder::Precipitation,
+        ChartSeriesFeeder::Temperature,
+        ChartSeriesFeeder::ApparentTemperature,
+        ChartSeriesFeeder::Visibility,
+        ChartSeriesFeeder::WindChill
+    };
+
+    double distanceInKm(const Mountain* first, const Mountain* second)
+    {
+        constexpr double earthRadiusInKm = 6371.0;
+        const double latitude1 = qDegreesToRadians(first->getLatitude());
+        const double latitude2 = qDegreesToRadians(second->getLatitude());
+        const double deltaLatitude = latitude2 - latitude1;
+        const double deltaLongitude = qDegreesToRadians(second->getLongitude() - first->getLongitude());
+        const double a = std::sin(deltaLatitude / 2) * std::sin(deltaLatitude / 2) +
+                         std::cos(latitude1) * std::cos(latitude2) * std::sin(deltaLongitude / 2) * std::sin(deltaLongitude / 2);
+        return 2 * earthRadiusInKm * std::asin(std::sqrt(a));
+    }
+}
+
+qsizetype PreparedDetailView::memoryFootprint() const
+{
+    qsizetype bytes = sizeof(PreparedDetailView);
+    for (const QList<QPointF>& points : series)
+        bytes += points.capacity() * sizeof(QPointF);
+    bytes += rows.capacity() * sizeof(ForecastTableRow);
+    for (const ForecastTableRow& row : rows)
+        bytes += (row.day.capacity() + row.condition.capacity() + row.windDirection.capacity()) * sizeof(QChar);
+    return bytes;
+}
+
+// ------------------------------------- //
+//       Constructor & Destructor        //
+// ------------------------------------- //
+
+DetailViewCache::DetailViewCache(QObject* parent) :
+    QObject{parent},
+    m_cache(maximumCacheSizeInBytes)
+{
+    m_threadPool.setMaxThreadCount(1);
+}
+
+DetailViewCache::~DetailViewCache()
+{
+    // Results posted back by outstanding jobs are discarded along with this object.
+    m_threadPool.waitForDone();
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+int DetailViewCache::count() const
+{
+    return static_cast<int>(m_cache.count());
+}
+
+int DetailViewCache::hits() const
+{
+    return m_hits;
+}
+
+double DetailViewCache::hitRate() const
+{
+    const int lookups = m_hits + m_misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(m_hits) / lookups;
+}
+
+qint64 DetailViewCache::memoryBytes() const
+{
+    return m_cache.totalCost();
+}
+
+int DetailViewCache::misses() const
+{
+    return m_misses;
+}
+
+void DetailViewCache::setPixelWidth(int pixelWidth)
+{
+    if (pixelWidth == m_pixelWidth)
+        return;
+
+    // Until the charts report their width, views keep every point and the chart downsamples them, so
+    // they stay valid once the width is known. Only series downsampled for another width are dropped.
+    const bool widthWasKnown = m_pixelWidth > 0;
+    m_pixelWidth = pixelWidth;
+    if (!widthWasKnown)
+        return;
+
+    m_cache.clear();
+    emit statisticsChanged();
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+const PreparedDetailView* DetailViewCache::detailView(Mountain* mountain)
+{
+    if (mountain == nullptr)
+        return nullptr;
+
+    if (const PreparedDetailView* cachedView = m_cache.object(mountain))
+    {
+        ++m_hits;
+        emit statisticsChanged();
+        return cachedView;
+    }
+
+    ++m_misses;
+    insert(mountain, new PreparedDetailView(createDetailView(captureInput(mountain), m_pixelWidth)));
+
+    // May be null if the view was too large to be cached.
+    return m_cache.object(mountain);
+}
+
+void DetailViewCache::invalidate(const Mountain* mountain)
+{
+    m_pendingPrefetches.remove(mountain);
+    if (m_cache.remove(mountain))
+        emit statisticsChanged();
+}
+
+void DetailViewCache::prefetchNeighbours(const Mountain* selectedMountain, const QList<Mountain*>& mountains, int numberOfNeighbours)
+{
+    if (selectedMountain == nullptr)
+        return;
+
+    const QList<const Mountain*> neighbours = findNearestNeighbours(selectedMountain, mountains, numberOfNeighbours);
+    for (const Mountain* neighbour : neighbours)
+    {
+        if (m_cache.contains(neighbour) || m_pendingPrefetches.contains(neighbour) || neighbour->getForecast()->getHourlyTimeAxis().isEmpty())
+            continue;
+
+        const quint64 prefetch = ++m_prefetchCounter;
+        m_pendingPrefetches.insert(neighbour, prefetch);
+
+        // The input lists are implicitly shared copies, so they can be read safely on the worker thread
+        // while the mountain continues to be updated on the main thread.
+        const int pixelWidth = m_pixelWidth;
+        m_threadPool.start([this, neighbour, prefetch, pixelWidth, input = captureInput(neighbour)]()
+        {
+            const auto detailView = std::make_shared<PreparedDetailView>(createDetailView(input, pixelWidth));
+            QMetaObject::invokeMethod(this, [this, neighbour, prefetch, pixelWidth, detailView]()
+            {
+                // Drop the result if the forecast changed or the mountain was destroyed while it was
+                // being prepared, or if it was downsampled for a chart width that has since changed.
+                const auto pending = m_pendingPrefetches.constFind(neighbour);
+                if (pending == m_pendingPrefetches.cend() || *pending != prefetch)
+                    return;
+
+                m_pendingPrefetches.erase(pending);
+                if (pixelWidth > 0 && pixelWidth != m_pixelWidth)
+                    return;
+
+                insert(neighbour, new PreparedDetailView(std::move(*detailView)));
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
+void DetailViewCache::watch(const QList<Mountain*>& mountains)
+{
+    // Only the series that go into the charts and the table, so that a refresh which leaves them
+    // unchanged keeps the prepared view.
+    for (Mountain* mountain : mountains)
+    {
+        // Nothing is kept for a destroyed mountain, whose address may be reused by another.
+        connect(mountain, &QObject::destroyed, this, &DetailViewCache::forgetMountain, Qt::UniqueConnection);
+
+        for (const auto changed : {&Mountain::dailyForecastChanged, &Mountain::hourlyTimeChanged, &Mountain::hourlyApparentTemperatureChanged,
+                                   &Mountain::hourlyPrecipitationChanged, &Mountain::hourlyTemperatureChanged,
+                                   &Mountain::hourlyVisibilityChanged, &Mountain::hourlyWindChillChanged})
+        {
+            connect(mountain, changed, this, [this, mountain]()
+            {
+                invalidate(mountain);
+            });
+        }
+    }
+}
+
+QList<const Mountain*> DetailViewCache::findNearestNeighbours(const Mountain* mountain, const QList<Mountain*>& mountains, int numberOfNeighbours)
+{
+    QList<std::pair<double, const Mountain*>> candidates;
+    candidates.reserve(mountains.size());
+    for (const Mountain* candidate : mountains)
+    {
+        if (candidate != mountain)
+            candidates.append({distanceInKm(mountain, candidate), candidate});
+    }
+
+    const qsizetype numberToKeep = std::min<qsizetype>(numberOfNeighbours, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + numberToKeep, candidates.end(),
+                      [](const auto& first, const auto& second) { return first.first < second.first; });
+
+    QList<const Mountain*> neighbours;
+    neighbours.reserve(numberToKeep);
+    for (qsizetype index = 0; index < numberToKeep; ++index)
+        neighbours.append(candidates.at(index).second);
+    return neighbours;
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+DetailViewCache::DetailViewInput DetailViewCache::captureInput(const Mountain* mountain)
+{
+    DetailViewInput input;
+    input.dateTimes = mountain->getHourlyDateTime();
+    for (const ChartSeriesFeeder::Variable variable : chartVariables)
+        input.values.insert(variable, ChartSeriesFeeder::getValuesForVariable(mountain, variable));
+    input.rows = ForecastTableModel::createRows(mountain);
+    return input;
+}
+
+PreparedDetailView DetailViewCache::createDetailView(const DetailViewInput& input, int pixelWidth)
+{
+    PreparedDetailView detailView;
+    for (const ChartSeriesFeeder::Variable variable : chartVariables)
+    {
+        QList<QPointF> points = ChartSeriesFeeder::createPoints(input.dateTimes,
+                                                                input.values.value(variable),
+                                                                ChartSeriesFeeder::getScaleForVariable(variable));
+        if (pixelWidth > 2 && points.size() > pixelWidth)
+            points = ChartSeriesFeeder::downsampleLargestTriangleThreeBuckets(points, pixelWidth);
+        detailView.series.insert(variable, std::move(points));
+    }
+    detailView.rows = input.rows;
+    return detailView;
+}
+
+void DetailViewCache::forgetMountain(QObject* mountain)
+{
+    // Only the address is used, as the Mountain has already been destroyed.
+    invalidate(static_cast<const Mountain*>(mountain));
+}
+
+void DetailViewCache::insert(const Mountain* mountain, PreparedDetailView* detailView)
+{
+    m_cache.insert(mountain, detailView, detailView->memoryFootprint());
+    emit statisticsChanged();
+}
@@ -0,0 +1,95 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DETAILVIEWCACHE_H
+#define DETAILVIEWCACHE_H
+
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QThreadPool>
+
+#include "ForecastTableModel.h"
+
+class Mountain;
+
+// Chart points and table rows for a mountain, ready to be handed to the forecast drawer.
+struct PreparedDetailView
+{
+    QHash<int, QList<QPointF>> series;
+    QList<ForecastTableRow> rows;
+
+    qsizetype memoryFootprint() const;
+};
+
+// Bounded LRU cache of prepared detail views. When a mountain is opened, the views for its
+// nearest neighbours are prepared on a worker thread so that moving along a ridge is instant.
+class DetailViewCache : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int hits READ hits NOTIFY statisticsChanged)
+    Q_PROPERTY(int misses READ misses NOTIFY statisticsChanged)
+    Q_PROPERTY(double hitRate READ hitRate NOTIFY statisticsChanged)
+    Q_PROPERTY(qint64 memoryBytes READ memoryBytes NOTIFY statisticsChanged)
+    Q_PROPERTY(int count READ count NOTIFY statisticsChanged)
+
+public:
+    explicit DetailViewCache(QObject* parent = nullptr);
+    ~DetailViewCache() override;
+
+    const PreparedDetailView* detailView(Mountain* mountain);
+    void invalidate(const Mountain* mountain);
+    void prefetchNeighbours(const Mountain* selectedMountain, const QList<Mountain*>& mountains, int numberOfNeighbours);
+    void setPixelWidth(int pixelWidth);
+    void watch(const QList<Mountain*>& mountains);
+
+    int count() const;
+    int hits() const;
+    double hitRate() const;
+    qint64 memoryBytes() const;
+    int misses() const;
+
+    static QList<const Mountain*> findNearestNeighbours(const Mountain* mountain, const QList<Mountain*>& mountains, int numberOfNeighbours);
+
+signals:
+    void statisticsChanged();
+
+private:
+    struct DetailViewInput
+    {
+        QList<QDateTime> dateTimes;
+        QHash<int, QList<double>> values;
+        QList<ForecastTableRow> rows;
+    };
+
+    static DetailViewInput captureInput(const Mountain* mountain);
+    static PreparedDetailView createDetailView(const DetailViewInput& input, int pixelWidth);
+    void forgetMountain(QObject* mountain);
+    void insert(const Mountain* mountain, PreparedDetailView* detailView);
+
+    QCache<const Mountain*, PreparedDetailView> m_cache;
+    // The prefetch in flight for each mountain. A prefetch whose result is no longer wanted, because
+    // the forecast changed or the mountain was destroyed, is removed, and its result is dropped.
+    QHash<const Mountain*, quint64> m_pendingPrefetches;
+    quint64 m_prefetchCounter = 0;
+    QThreadPool m_threadPool;
+    int m_hits = 0;
+    int m_misses = 0;
+    int m_pixelWidth = 0;
+};
+
+#endif // DETAILVIEWCACHE_H
@@ -0,0 +1,894 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastArchive.h"
+#include "Mountain.h"
+#include "Tracer.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QTimeZone>
+#include <QtAlgorithms>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace
+{
+    // Identifies a segment file. The version is increased whenever the record layout changes.
+    constexpr quint32 segmentMagic = 0x41464E43; // "CNFA"
+    constexpr quint16 segmentVersion = 1;
+    constexpr qint64 segmentHeaderSize = 8;
+
+    // Fixed part of a record after its length and checksum: the name length, then after the name the
+    // issue time, the first and last hour and the first and last day.
+    constexpr qint64 recordLengthSize = 4;
+    constexpr qint64 recordChecksumSize = 2;
+    constexpr qint64 recordTimesSize = 3 * 8 + 2 * 4;
+
+    constexpr quint8 hourlyAxis = 0;
+    constexpr quint8 dailyAxis = 1;
+
+    // Each open segment holds a file descriptor and a memory map.
+    constexpr qsizetype maximumOpenSegments = 8;
+
+    struct FieldDescription
+    {
+        ForecastArchive::Field field;
+        const char* name;
+        bool daily;
+        double scale;
+    };
+
+    // Values are rounded to the precision Open-Meteo reports before they are encoded. Whole numbers
+    // leave most of the mantissa of a double empty, which is what makes the XOR encoding effective.
+    constexpr FieldDescription fieldDescriptions[] = {
+        {ForecastArchive::Field::Temperature, "temperature", false, 10.0},
+        {ForecastArchive::Field::ApparentTemperature, "apparentTemperature", false, 10.0},
+        {ForecastArchive::Field::Precipitation, "precipitation", false, 10.0},
+        {ForecastArchive::Field::Visibility, "visibility", false, 1.0},
+        {ForecastArchive::Field::DailyPrecipitation, "dailyPrecipitation", true, 10.0},
+        {ForecastArchive::Field::DailyWindSpeed, "dailyWindSpeed", true, 10.0},
+        {ForecastArchive::Field::DailyWindGusts, "dailyWindGusts", true, 10.0}
+    };
+
+    const FieldDescription* describe(ForecastArchive::Field field)
+    {
+        for (const FieldDescription& description : fieldDescriptions)
+        {
+            if (description.field == field)
+                return &description;
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    void appendLittleEndian(QByteArray& bytes, T value)
+    {
+        char buffer[sizeof(T)];
+        qToLittleEndian(value, buffer);
+        bytes.append(buffer, sizeof(T));
+    }
+
+    // Reads little endian values from a memory mapped record, failing instead of reading past its end.
+    class ByteReader
+    {
+    public:
+        ByteReader(const uchar* data, qint64 size) : m_data(data), m_size(size) {}
+
+        template<typename T>
+        T read()
+        {
+            if (m_position + static_cast<qint64>(sizeof(T)) > m_size)
+            {
+                m_ok = false;
+                return T{};
+            }
+            const T value = qFromLittleEndian<T>(m_data + m_position);
+            m_position += sizeof(T);
+            return value;
+        }
+
+        const uchar* take(qint64 length)
+        {
+            if (m_position + length > m_size)
+            {
+                m_ok = false;
+                return nullptr;
+            }
+            const uchar* const data = m_data + m_position;
+            m_position += length;
+            return data;
+        }
+
+        bool ok() const { return m_ok; }
+
+    private:
+        const uchar* m_data;
+        qint64 m_size;
+        qint64 m_position = 0;
+        bool m_ok = true;
+    };
+
+    class BitWriter
+    {
+    public:
+        void write(quint64 value, int count)
+        {
+            while (count > 0)
+            {
+                if (m_bitsFree == 0)
+                {
+                    m_bytes.append('\0');
+                    m_bitsFree = 8;
+                }
+                const int bits = std::min(count, m_bitsFree);
+                const quint64 chunk = (value >> (count - bits)) & ((1u << bits) - 1);
+                m_bytes.back() = static_cast<char>(static_cast<uchar>(m_bytes.back()) | (chunk << (m_bitsFree - bits)));
+                m_bitsFree -= bits;
+                count -= bits;
+            }
+        }
+
+        const QByteArray& bytes() const { return m_bytes; }
+
+    private:
+        QByteArray m_bytes;
+        int m_bitsFree = 0;
+    };
+
+    class BitReader
+    {
+    public:
+        BitReader(const uchar* data, qint64 size) : m_data(data), m_sizeInBits(size * 8) {}
+
+        quint64 read(int count)
+        {
+            quint64 value = 0;
+            while (count > 0)
+            {
+                if (m_position >= m_sizeInBits)
+                {
+                    m_ok = false;
+                    return 0;
+                }
+                const int bitsLeftInByte = 8 - static_cast<int>(m_position % 8);
+                const int bits = std::min(count, bitsLeftInByte);
+                const quint64 chunk = (m_data[m_position / 8] >> (bitsLeftInByte - bits)) & ((1u << bits) - 1);
+                value = (value << bits) | chunk;
+                m_position += bits;
+                count -= bits;
+            }
+            return value;
+        }
+
+        bool ok() const { return m_ok; }
+
+    private:
+        const uchar* m_data;
+        qint64 m_sizeInBits;
+        qint64 m_position = 0;
+        bool m_ok = true;
+    };
+
+    quint64 toBits(double value)
+    {
+        quint64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    double fromBits(quint64 bits)
+    {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // The first timestamp is stored in full and the second as a delta. After that only the change in
+    // the delta is stored, which for a regular series is zero and takes a single bit.
+    QByteArray encodeTimestamps(const QList<qint64>& times)
+    {
+        BitWriter writer;
+        if (times.isEmpty())
+            return writer.bytes();
+
+        writer.write(static_cast<quint64>(times.first()), 64);
+        qint64 previousDelta = 0;
+        for (qsizetype index = 1; index < times.size(); ++index)
+        {
+            const qint64 delta = times.at(index) - times.at(index - 1);
+            if (index == 1)
+            {
+                writer.write(static_cast<quint32>(static_cast<qint32>(delta)), 32);
+                previousDelta = delta;
+                continue;
+            }
+
+            const qint64 deltaOfDelta = delta - previousDelta;
+            previousDelta = delta;
+
+            if (deltaOfDelta == 0)
+            {
+                writer.write(0b0, 1);
+            }
+            else if (deltaOfDelta >= -63 && deltaOfDelta <= 64)
+            {
+                writer.write(0b10, 2);
+                writer.write(static_cast<quint64>(deltaOfDelta + 63), 7);
+            }
+            else if (deltaOfDelta >= -255 && deltaOfDelta <= 256)
+            {
+                writer.write(0b110, 3);
+                writer.write(static_cast<quint64>(deltaOfDelta + 255), 9);
+            }
+            else if (deltaOfDelta >= -2047 && deltaOfDelta <= 2048)
+            {
+                writer.write(0b1110, 4);
+                writer.write(static_cast<quint64>(deltaOfDelta + 2047), 12);
+            }
+            else
+            {
+                writer.write(0b1111, 4);
+                writer.write(static_cast<quint32>(static_cast<qint32>(deltaOfDelta)), 32);
+            }
+        }
+        return writer.bytes();
+    }
+
+    bool decodeTimestamps(const uchar* data, qint64 size, int count, QList<qint64>* times)
+    {
+        BitReader reader(data, size);
+        times->clear();
+        times->reserve(count);
+
+        qint64 delta = 0;
+        for (int index = 0; index < count && reader.ok(); ++index)
+        {
+            if (index == 0)
+            {
+                times->append(static_cast<qint64>(reader.read(64)));
+                continue;
+            }
+
+            if (index == 1)
+            {
+                delta = static_cast<qint32>(static_cast<quint32>(reader.read(32)));
+            }
+            else if (reader.read(1) == 0b0)
+            {
+                // The delta is unchanged.
+            }
+            else if (reader.read(1) == 0b0)
+            {
+                delta += static_cast<qint64>(reader.read(7)) - 63;
+            }
+            else if (reader.read(1) == 0b0)
+            {
+                delta += static_cast<qint64>(reader.read(9)) - 255;
+            }
+            else if (reader.read(1) == 0b0)
+            {
+                delta += static_cast<qint64>(reader.read(12)) - 2047;
+            }
+            else
+            {
+                delta += static_cast<qint32>(static_cast<quint32>(reader.read(32)));
+            }
+            times->append(times->last() + delta);
+        }
+        return reader.ok();
+    }
+
+    // Each value is XORed with the one before it. An unchanged value takes a single bit; otherwise only
+    // the bits between the leading and trailing zeros of the XOR are stored, reusing the previous
+    // window when they fit inside it.
+    QByteArray encodeValues(const QList<double>& values)
+    {
+        BitWriter writer;
+        if (values.isEmpty())
+            return writer.bytes();
+
+        quint64 previous = toBits(values.first());
+        writer.write(previous, 64);
+
+        int leadingZeros = -1;
+        int trailingZeros = 0;
+        for (qsizetype index = 1; index < values.size(); ++index)
+        {
+            const quint64 bits = toBits(values.at(index));
+            const quint64 difference = bits ^ previous;
+            previous = bits;
+
+            if (difference == 0)
+            {
+                writer.write(0b0, 1);
+                continue;
+            }
+
+            const int leading = std::min(qCountLeadingZeroBits(difference), 31u);
+            const int trailing = static_cast<int>(qCountTrailingZeroBits(difference));
+            if (leadingZeros >= 0 && leading >= leadingZeros && trailing >= trailingZeros)
+            {
+                writer.write(0b10, 2);
+                writer.write(difference >> trailingZeros, 64 - leadingZeros - trailingZeros);
+            }
+            else
+            {
+                leadingZeros = leading;
+                trailingZeros = trailing;
+                const int meaningfulBits = 64 - leading - trailing;
+                writer.write(0b11, 2);
+                writer.write(static_cast<quint64>(leading), 5);
+                writer.write(static_cast<quint64>(meaningfulBits & 63), 6);
+                writer.write(difference >> trailing, meaningfulBits);
+            }
+        }
+        return writer.bytes();
+    }
+
+    bool decodeValues(const uchar* data, qint64 size, int count, QList<double>* values)
+    {
+        BitReader reader(data, size);
+        values->clear();
+        values->reserve(count);
+
+        quint64 previous = 0;
+        int leadingZeros = 0;
+        int trailingZeros = 0;
+        for (int index = 0; index < count && reader.ok(); ++index)
+        {
+            if (index == 0)
+            {
+                previous = reader.read(64);
+            }
+            else if (reader.read(1) == 0b1)
+            {
+                if (reader.read(1) == 0b1)
+                {
+                    leadingZeros = static_cast<int>(reader.read(5));
+                    const int meaningfulBits = static_cast<int>(reader.read(6));
+                    trailingZeros = 64 - leadingZeros - (meaningfulBits == 0 ? 64 : meaningfulBits);
+                    if (trailingZeros < 0)
+                        return false;
+                }
+                previous ^= reader.read(64 - leadingZeros - trailingZeros) << trailingZeros;
+            }
+            values->append(fromBits(previous));
+        }
+        return reader.ok();
+    }
+
+    void appendBlock(QByteArray& payload, quint8 axis, const QList<qint64>& times,
+                     const QList<QPair<ForecastArchive::Field, QList<double>>>& series)
+    {
+        const QByteArray timeBytes = encodeTimestamps(times);
+        appendLittleEndian<quint8>(payload, axis);
+        appendLittleEndian<quint16>(payload, static_cast<quint16>(times.size()));
+        appendLittleEndian<quint16>(payload, static_cast<quint16>(timeBytes.size()));
+        payload.append(timeBytes);
+
+        appendLittleEndian<quint8>(payload, static_cast<quint8>(series.size()));
+        for (const auto& [field, values] : series)
+        {
+            const double scale = describe(field)->scale;
+            QList<double> roundedValues;
+            roundedValues.reserve(times.size());
+            for (qsizetype index = 0; index < times.size(); ++index)
+                roundedValues.append(index < values.size() ? std::round(values.at(index) * scale) : 0.0);
+
+            const QByteArray valueBytes = encodeValues(roundedValues);
+            appendLittleEndian<quint8>(payload, static_cast<quint8>(field));
+            appendLittleEndian<quint16>(payload, static_cast<quint16>(valueBytes.size()));
+            payload.append(valueBytes);
+        }
+    }
+
+    QList<double> toDoubles(const QList<int>& values)
+    {
+        QList<double> doubles;
+        doubles.reserve(values.size());
+        for (int value : values)
+            doubles.append(value);
+        return doubles;
+    }
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ForecastArchive::ForecastArchive(const QString& directory, QObject* parent) :
+    QObject{parent},
+    m_directory(directory)
+{
+    if (!QDir().mkpath(m_directory))
+        qWarning() << "Unable to create the forecast archive" << m_directory;
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+QString ForecastArchive::getDirectory() const
+{
+    return m_directory;
+}
+
+qint64 ForecastArchive::getBytesWritten() const
+{
+    return m_bytesWritten;
+}
+
+bool ForecastArchive::getIncludeHourly() const
+{
+    return m_includeHourly;
+}
+
+void ForecastArchive::setIncludeHourly(bool includeHourly)
+{
+    m_includeHourly = includeHourly;
+}
+
+int ForecastArchive::getMinimumInterval() const
+{
+    return m_minimumIntervalSeconds / 60;
+}
+
+void ForecastArchive::setMinimumInterval(int minutes)
+{
+    m_minimumIntervalSeconds = std::max(0, minutes) * 60;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+bool ForecastArchive::isDaily(Field field)
+{
+    const FieldDescription* const description = describe(field);
+    return description && description->daily;
+}
+
+bool ForecastArchive::fieldFromName(const QString& name, Field* field)
+{
+    for (const FieldDescription& description : fieldDescriptions)
+    {
+        if (name == QLatin1String(description.name))
+        {
+            *field = description.field;
+            return true;
+        }
+    }
+    return false;
+}
+
+QString ForecastArchive::fieldName(Field field)
+{
+    const FieldDescription* const description = describe(field);
+    return description ? QString::fromLatin1(description->name) : QString();
+}
+
+bool ForecastArchive::append(const Mountain* mountain, const QDateTime& issued)
+{
+    TRACE_SCOPE("archiveForecast");
+
+    if (mountain == nullptr)
+        return false;
+
+    const QString location = mountain->getName();
+    const qint64 issuedSeconds = issued.toSecsSinceEpoch();
+    const auto lastIssued = m_lastIssued.constFind(location);
+    if (lastIssued != m_lastIssued.cend() && issuedSeconds - *lastIssued < m_minimumIntervalSeconds)
+        return true;
+
+    const std::shared_ptr<const MountainForecast> forecast = mountain->getForecast();
+    QByteArray payload;
+    quint8 numberOfBlocks = 0;
+    payload.append('\0');
+
+    QList<qint64> hours;
+    if (m_includeHourly)
+    {
+        const TimeAxis timeAxis = forecast->getHourlyTimeAxis();
+        hours.reserve(timeAxis.size());
+        for (qsizetype index = 0; index < timeAxis.size(); ++index)
+            hours.append(timeAxis.getUtcSeconds(index));
+    }
+    if (!hours.isEmpty())
+    {
+        appendBlock(payload, hourlyAxis, hours, {
+            {Field::Temperature, forecast->getHourlyTemperature()},
+            {Field::ApparentTemperature, forecast->getHourlyApparentTemperature()},
+            {Field::Precipitation, forecast->getHourlyPrecipitation()},
+            {Field::Visibility, toDoubles(forecast->getHourlyVisibility())}
+        });
+        ++numberOfBlocks;
+    }
+
+    QList<qint64> days;
+    for (const QDate& date : forecast->getDates())
+        days.append(date.toJulianDay());
+    if (!days.isEmpty())
+    {
+        appendBlock(payload, dailyAxis, days, {
+            {Field::DailyPrecipitation, forecast->getDailyPrecipitation()},
+            {Field::DailyWindSpeed, forecast->getDailyWindSpeed()},
+            {Field::DailyWindGusts, forecast->getDailyWindGusts()}
+        });
+        ++numberOfBlocks;
+    }
+
+    if (numberOfBlocks == 0)
+        return true;
+    payload[0] = static_cast<char>(numberOfBlocks);
+
+    // Refreshing more often than the forecast models run mostly retrieves the same forecast again.
+    const size_t payloadHash = qHash(payload);
+    const auto lastPayloadHash = m_lastPayloadHash.constFind(location);
+    if (lastPayloadHash != m_lastPayloadHash.cend() && *lastPayloadHash == payloadHash)
+        return true;
+
+    const QDate issuedDate = issued.toUTC().date();
+    if (!openOutput(issuedDate))
+        return false;
+
+    const QByteArray name = location.toUtf8().left(255);
+    QByteArray record;
+    record.reserve(1 + name.size() + recordTimesSize + payload.size());
+    appendLittleEndian<quint8>(record, static_cast<quint8>(name.size()));
+    record.append(name);
+    appendLittleEndian<qint64>(record, issuedSeconds);
+    appendLittleEndian<qint64>(record, hours.isEmpty() ? 0 : hours.first());
+    appendLittleEndian<qint64>(record, hours.isEmpty() ? 0 : hours.last());
+    appendLittleEndian<qint32>(record, days.isEmpty() ? 0 : static_cast<qint32>(days.first()));
+    appendLittleEndian<qint32>(record, days.isEmpty() ? 0 : static_cast<qint32>(days.last()));
+    record.append(payload);
+
+    QByteArray bytes;
+    bytes.reserve(recordLengthSize + recordChecksumSize + record.size());
+    appendLittleEndian<quint32>(bytes, static_cast<quint32>(recordChecksumSize + record.size()));
+    appendLittleEndian<quint16>(bytes, qChecksum(record));
+    bytes.append(record);
+
+    if (m_output.write(bytes) != bytes.size() || !m_output.flush())
+    {
+        qWarning() << "Unable to write to the forecast archive" << m_output.fileName() << m_output.errorString();
+        return false;
+    }
+
+    m_bytesWritten += bytes.size();
+    m_lastIssued.insert(location, issuedSeconds);
+    m_lastPayloadHash.insert(location, payloadHash);
+    return true;
+}
+
+QList<ForecastArchive::ArchivedForecast> ForecastArchive::forecasts(const QString& location, const QDateTime& issuedFrom, const QDateTime& issuedTo)
+{
+    TRACE_SCOPE("archiveForecasts");
+
+    const qint64 from = issuedFrom.isValid() ? issuedFrom.toSecsSinceEpoch() : std::numeric_limits<qint64>::min();
+    const qint64 to = issuedTo.isValid() ? issuedTo.toSecsSinceEpoch() : std::numeric_limits<qint64>::max();
+
+    QList<ArchivedForecast> archivedForecasts;
+    for (const Segment* segment : segmentsBetween(issuedFrom, issuedTo))
+    {
+        for (const RecordIndex& record : segment->records.value(location))
+        {
+            if (record.issued < from || record.issued > to)
+                continue;
+
+            ArchivedForecast forecast;
+            if (decodeRecord(*segment, record, location, &forecast))
+                archivedForecasts.append(forecast);
+        }
+    }
+    return archivedForecasts;
+}
+
+QList<ForecastArchive::Revision> ForecastArchive::revisions(const QString& location, Field field, const QDateTime& target,
+                                                            const QDateTime& issuedFrom, const QDateTime& issuedTo)
+{
+    TRACE_SCOPE("archiveRevisions");
+
+    const qint64 from = issuedFrom.isValid() ? issuedFrom.toSecsSinceEpoch() : std::numeric_limits<qint64>::min();
+    const qint64 to = issuedTo.isValid() ? issuedTo.toSecsSinceEpoch() : std::numeric_limits<qint64>::max();
+    const bool daily = isDaily(field);
+    const qint64 targetTime = daily ? target.date().toJulianDay() : target.toSecsSinceEpoch();
+
+    QList<Revision> revisions;
+    for (const Segment* segment : segmentsBetween(issuedFrom, issuedTo))
+    {
+        for (const RecordIndex& record : segment->records.value(location))
+        {
+            // The record headers alone say whether a forecast covers the target.
+            const qint64 first = daily ? record.firstDay : record.firstHour;
+            const qint64 last = daily ? record.lastDay : record.lastHour;
+            if (record.issued < from || record.issued > to || targetTime < first || targetTime > last)
+                continue;
+
+            ArchivedForecast forecast;
+            if (!decodeRecord(*segment, record, location, &forecast, field))
+                continue;
+
+            qsizetype index = -1;
+            if (daily)
+            {
+                index = forecast.dates.indexOf(target.date());
+            }
+            else
+            {
+                // The forecast for the hour that contains the target.
+                const auto hour = std::upper_bound(forecast.hourlyTimes.cbegin(), forecast.hourlyTimes.cend(), target);
+                index = std::distance(forecast.hourlyTimes.cbegin(), hour) - 1;
+            }
+
+            const QList<double> values = forecast.values.value(field);
+            if (index >= 0 && index < values.size())
+                revisions.append({forecast.issued, values.at(index)});
+        }
+    }
+    return revisions;
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+QString ForecastArchive::segmentPath(const QDate& date) const
+{
+    return QDir(m_directory).filePath(QString("forecasts-%1.cnfa").arg(date.toString("yyyyMMdd")));
+}
+
+bool ForecastArchive::openOutput(const QDate& date)
+{
+    if (m_output.isOpen() && m_outputDate == date)
+        return true;
+
+    m_output.close();
+    m_output.setFileName(segmentPath(date));
+    if (!m_output.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        qWarning() << "Unable to open the forecast archive" << m_output.fileName() << m_output.errorString();
+        return false;
+    }
+    m_outputDate = date;
+
+    if (m_output.size() == 0)
+    {
+        QByteArray header;
+        appendLittleEndian<quint32>(header, segmentMagic);
+        appendLittleEndian<quint16>(header, segmentVersion);
+        appendLittleEndian<quint16>(header, 0);
+        m_output.write(header);
+        m_output.flush();
+    }
+
+    // A record left incomplete by a crash would hide every record appended after it, so it is removed.
+    Segment& segment = m_segments[date];
+    segment.lastUsed = ++m_segmentUses;
+    refreshSegment(date, segment);
+    if (segment.scannedSize >= segmentHeaderSize && segment.scannedSize < m_output.size())
+    {
+        qWarning() << "Removing an incomplete record from" << m_output.fileName();
+        if (segment.data)
+            segment.file->unmap(segment.data);
+        segment.data = nullptr;
+        segment.mappedSize = 0;
+        m_output.resize(segment.scannedSize);
+    }
+
+    closeUnusedSegments({&segment});
+    return true;
+}
+
+QList<ForecastArchive::Segment*> ForecastArchive::segmentsBetween(const QDateTime& issuedFrom, const QDateTime& issuedTo)
+{
+    const QDate fromDate = issuedFrom.isValid() ? issuedFrom.toUTC().date() : QDate();
+    const QDate toDate = issuedTo.isValid() ? issuedTo.toUTC().date() : QDate();
+
+    const QStringList fileNames = QDir(m_directory).entryList({"forecasts-*.cnfa"}, QDir::Files, QDir::Name);
+    QList<Segment*> segments;
+    for (const QString& fileName : fileNames)
+    {
+        const QDate date = QDate::fromString(fileName.mid(10, 8), "yyyyMMdd");
+        if (!date.isValid() || (fromDate.isValid() && date < fromDate) || (toDate.isValid() && date > toDate))
+            continue;
+
+        Segment& segment = m_segments[date];
+        segment.lastUsed = ++m_segmentUses;
+        refreshSegment(date, segment);
+        segments.append(&segment);
+    }
+
+    closeUnusedSegments(segments);
+    return segments;
+}
+
+void ForecastArchive::refreshSegment(const QDate& date, Segment& segment)
+{
+    TRACE_SCOPE("refreshArchiveSegment");
+
+    if (segment.file == nullptr)
+    {
+        segment.file = new QFile(segmentPath(date), this);
+        if (!segment.file->open(QIODevice::ReadOnly))
+        {
+            qWarning() << "Unable to read the forecast archive" << segment.file->fileName() << segment.file->errorString();
+            return;
+        }
+    }
+
+    // Segments are only ever appended to, so only the part written since the last scan is indexed.
+    const qint64 size = segment.file->size();
+    if (size > segment.mappedSize)
+    {
+        if (segment.data)
+            segment.file->unmap(segment.data);
+        segment.data = segment.file->map(0, size);
+        segment.mappedSize = segment.data ? size : 0;
+    }
+    if (segment.data == nullptr || segment.scannedSize >= segment.mappedSize)
+        return;
+
+    if (segment.scannedSize == 0)
+    {
+        if (segment.mappedSize < segmentHeaderSize ||
+            qFromLittleEndian<quint32>(segment.data) != segmentMagic ||
+            qFromLittleEndian<quint16>(segment.data + 4) != segmentVersion)
+        {
+            qWarning() << segment.file->fileName() << "is not a forecast archive segment";
+            segment.scannedSize = segment.mappedSize;
+            return;
+        }
+        segment.scannedSize = segmentHeaderSize;
+    }
+
+    qint64 offset = segment.scannedSize;
+    while (offset + recordLengthSize + recordChecksumSize <= segment.mappedSize)
+    {
+        const qint64 recordLength = qFromLittleEndian<quint32>(segment.data + offset);
+        if (recordLength < recordChecksumSize || offset + recordLengthSize + recordLength > segment.mappedSize)
+            break;
+
+        const uchar* const body = segment.data + offset + recordLengthSize + recordChecksumSize;
+        const qint64 bodyLength = recordLength - recordChecksumSize;
+        const quint16 checksum = qFromLittleEndian<quint16>(segment.data + offset + recordLengthSize);
+
+        if (bodyLength > 0 && qChecksum(QByteArrayView(body, bodyLength)) == checksum &&
+            1 + body[0] + recordTimesSize <= bodyLength)
+        {
+            const qint64 nameLength = body[0];
+            const uchar* const times = body + 1 + nameLength;
+
+            RecordIndex record;
+            record.issued = qFromLittleEndian<qint64>(times);
+            record.firstHour = qFromLittleEndian<qint64>(times + 8);
+            record.lastHour = qFromLittleEndian<qint64>(times + 16);
+            record.firstDay = qFromLittleEndian<qint32>(times + 24);
+            record.lastDay = qFromLittleEndian<qint32>(times + 28);
+            record.payloadOffset = (times - segment.data) + recordTimesSize;
+            record.payloadLength = bodyLength - (1 + nameLength + recordTimesSize);
+
+            const QString location = QString::fromUtf8(reinterpret_cast<const char*>(body + 1), nameLength);
+            segment.records[location].append(record);
+        }
+        else
+        {
+            qWarning() << "Skipping a corrupt record in" << segment.file->fileName() << "at" << offset;
+        }
+
+        offset += recordLengthSize + recordLength;
+    }
+    segment.scannedSize = offset;
+}
+
+void ForecastArchive::closeUnusedSegments(const QList<Segment*>& segmentsInUse)
+{
+    // The least recently used segments outside the query are closed along with their index, and are
+    // opened and indexed again if a later query needs them.
+    while (m_segments.size() > maximumOpenSegments)
+    {
+        auto leastRecentlyUsed = m_segments.end();
+        for (auto segment = m_segments.begin(); segment != m_segments.end(); ++segment)
+        {
+            if (segmentsInUse.contains(&segment.value()))
+                continue;
+            if (leastRecentlyUsed == m_segments.end() || segment->lastUsed < leastRecentlyUsed->lastUsed)
+                leastRecentlyUsed = segment;
+        }
+        if (leastRecentlyUsed == m_segments.end())
+            return;
+
+        if (leastRecentlyUsed->data)
+            leastRecentlyUsed->file->unmap(leastRecentlyUsed->data);
+        delete leastRecentlyUsed->file;
+        m_segments.erase(leastRecentlyUsed);
+    }
+}
+
+bool ForecastArchive::decodeRecord(const Segment& segment, const RecordIndex& record, const QString& location,
+                                   ArchivedForecast* forecast, Field onlyField) const
+{
+    if (segment.data == nullptr || record.payloadOffset + record.payloadLength > segment.mappedSize)
+        return false;
+
+    forecast->location = location;
+    forecast->issued = QDateTime::fromSecsSinceEpoch(record.issued, QTimeZone::UTC);
+
+    ByteReader reader(segment.data + record.payloadOffset, record.payloadLength);
+    const quint8 numberOfBlocks = reader.read<quint8>();
+    for (quint8 block = 0; block < numberOfBlocks && reader.ok(); ++block)
+    {
+        const quint8 axis = reader.read<quint8>();
+        const quint16 count = reader.read<quint16>();
+        const quint16 timeLength = reader.read<quint16>();
+        const uchar* const timeData = reader.take(timeLength);
+        const quint8 numberOfSeries = reader.read<quint8>();
+        if (!reader.ok())
+            return false;
+
+        // Only the series asked for are decoded; the others are skipped over using their lengths.
+        bool wanted = onlyField == Field{};
+        QList<std::pair<Field, std::pair<const uchar*, quint16>>> series;
+        for (quint8 index = 0; index < numberOfSeries && reader.ok(); ++index)
+        {
+            const Field field = static_cast<Field>(reader.read<quint8>());
+            const quint16 length = reader.read<quint16>();
+            const uchar* const data = reader.take(length);
+            if (onlyField == Field{} || field == onlyField)
+            {
+                series.append({field, {data, length}});
+                wanted = true;
+            }
+        }
+        if (!reader.ok())
+            return false;
+        if (!wanted)
+            continue;
+
+        QList<qint64> times;
+        if (!decodeTimestamps(timeData, timeLength, count, &times))
+            return false;
+
+        if (axis == hourlyAxis)
+        {
+            forecast->hourlyTimes.reserve(times.size());
+            for (qint64 time : times)
+                forecast->hourlyTimes.append(QDateTime::fromSecsSinceEpoch(time));
+        }
+        else
+        {
+            forecast->dates.reserve(times.size());
+            for (qint64 time : times)
+                forecast->dates.append(QDate::fromJulianDay(time));
+        }
+
+        for (const auto& [field, bytes] : series)
+        {
+            const FieldDescription* const description = describe(field);
+            QList<double> values;
+            if (description == nullptr || !decodeValues(bytes.first, bytes.second, count, &values))
+                continue;
+
+            for (double& value : values)
+                value /= description->scale;
+            forecast->values.insert(field, values);
+        }
+    }
+    return reader.ok();
+}
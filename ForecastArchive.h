@@ -0,0 +1,137 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTARCHIVE_H
+#define FORECASTARCHIVE_H
+
+#include <QDate>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QString>
+
+class Mountain;
+
+// An append-only record of every forecast retrieved for each location, so that the way a forecast
+// evolved, and how good it turned out to be, can be looked at later.
+//
+// The archive is a directory of segments, one per UTC day of issue, named forecasts-yyyyMMdd.cnfa.
+// Each archived forecast is one record holding the location, the time it was issued and its hourly
+// and daily series. Timestamps are stored as deltas of deltas and values in the XOR encoding of
+// Facebook's Gorilla, after rounding them to the precision Open-Meteo reports, so an hourly series
+// that changes slowly takes only a few bits per value. Segments are read through memory maps and
+// only the fixed headers of the records are scanned to index them, so a query decodes just the
+// records, and the series within them, that it needs. Only the most recently used segments are kept
+// open, so a long running service does not hold a file and a map for every day it has archived.
+//
+// By default only the daily series are archived, which for the Munros at four forecasts a day takes
+// a few MB a month. The hourly series make each forecast about ten times larger.
+//
+// A forecast identical to the last one archived for the location is not stored again, nor is one
+// issued within the minimum interval of it.
+class ForecastArchive : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Field : quint8
+    {
+        Temperature = 1,
+        ApparentTemperature,
+        Precipitation,
+        Visibility,
+        DailyPrecipitation,
+        DailyWindSpeed,
+        DailyWindGusts
+    };
+
+    struct ArchivedForecast
+    {
+        QString location;
+        QDateTime issued;
+        QList<QDateTime> hourlyTimes;
+        QList<QDate> dates;
+        QMap<Field, QList<double>> values;
+    };
+
+    struct Revision
+    {
+        QDateTime issued;
+        double value = 0.0;
+    };
+
+    explicit ForecastArchive(const QString& directory, QObject* parent = nullptr);
+
+    static bool isDaily(Field field);
+    static bool fieldFromName(const QString& name, Field* field);
+    static QString fieldName(Field field);
+
+    QString getDirectory() const;
+    qint64 getBytesWritten() const;
+    bool getIncludeHourly() const;
+    void setIncludeHourly(bool includeHourly);
+    int getMinimumInterval() const;
+    void setMinimumInterval(int minutes);
+
+    bool append(const Mountain* mountain, const QDateTime& issued = QDateTime::currentDateTimeUtc());
+
+    QList<ArchivedForecast> forecasts(const QString& location, const QDateTime& issuedFrom, const QDateTime& issuedTo);
+    QList<Revision> revisions(const QString& location, Field field, const QDateTime& target,
+                              const QDateTime& issuedFrom, const QDateTime& issuedTo);
+
+private:
+    struct RecordIndex
+    {
+        qint64 issued = 0;
+        qint64 firstHour = 0;
+        qint64 lastHour = 0;
+        qint64 firstDay = 0;
+        qint64 lastDay = 0;
+        qint64 payloadOffset = 0;
+        qint64 payloadLength = 0;
+    };
+
+    struct Segment
+    {
+        QFile* file = nullptr;
+        uchar* data = nullptr;
+        qint64 mappedSize = 0;
+        qint64 scannedSize = 0;
+        QHash<QString, QList<RecordIndex>> records;
+        quint64 lastUsed = 0;
+    };
+
+    qint64 m_bytesWritten = 0;
+    QString m_directory;
+    bool m_includeHourly = false;
+    QHash<QString, qint64> m_lastIssued;
+    QHash<QString, size_t> m_lastPayloadHash;
+    int m_minimumIntervalSeconds = 0;
+    QFile m_output;
+    QDate m_outputDate;
+    QMap<QDate, Segment> m_segments;
+    quint64 m_segmentUses = 0;
+
+    QString segmentPath(const QDate& date) const;
+    bool openOutput(const QDate& date);
+    QList<Segment*> segmentsBetween(const QDateTime& issuedFrom, const QDateTime& issuedTo);
+    void refreshSegment(const QDate& date, Segment& segment);
+    void closeUnusedSegments(const QList<Segment*>& segmentsInUse);
+    bool decodeRecord(const Segment& segment, const RecordIndex& record, const QString& location,
+                      ArchivedForecast* forecast, Field onlyField = Field{}) const;
+};
+
+#endif // FORECASTARCHIVE_H
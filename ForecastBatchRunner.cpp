@@ -0,0 +1,333 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastBatchRunner.h"
+#include "ForecastArchive.h"
+#include "Metrics.h"
+#include "Mountain.h"
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace
+{
+    // Identifies the binary output format. The version is increased whenever the record layout changes.
+    constexpr quint32 binaryMagic = 0x434E4643; // "CNFC"
+    constexpr quint16 binaryVersion = 1;
+    constexpr quint8 binaryRecordMarker = 1;
+    constexpr quint8 binaryEndMarker = 0;
+
+    constexpr int progressIntervalMilliseconds = 5000;
+
+    QString escapeCsvField(const QString& field)
+    {
+        if (!field.contains(',') && !field.contains('"') && !field.contains('\n'))
+            return field;
+
+        QString escaped = field;
+        escaped.replace("\"", "\"\"");
+        return "\"" + escaped + "\"";
+    }
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ForecastBatchRunner::ForecastBatchRunner(QObject* parent) :
+    QObject{parent}
+{
+    connect(&m_forecastSource, &OpenMeteoForecastSource::forecastReceived, this, [this](Mountain* mountain){
+        handleForecast(mountain, true);
+    });
+    connect(&m_forecastSource, &OpenMeteoForecastSource::forecastFailed, this, [this](Mountain* mountain, const QString& failureType){
+        qWarning() << "Unable to retrieve the forecast for" << (mountain ? mountain->getName() : QString()) << failureType;
+        handleForecast(mountain, false);
+    });
+
+    m_progressTimer.setInterval(progressIntervalMilliseconds);
+    connect(&m_progressTimer, &QTimer::timeout, this, [this](){ reportProgress(false); });
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+void ForecastBatchRunner::setArchive(ForecastArchive* archive)
+{
+    m_archive = archive;
+}
+
+int ForecastBatchRunner::getMaximumConcurrentRequests() const
+{
+    return m_maximumConcurrentRequests;
+}
+
+void ForecastBatchRunner::setMaximumConcurrentRequests(int maximumConcurrentRequests)
+{
+    m_maximumConcurrentRequests = std::max(1, maximumConcurrentRequests);
+}
+
+void ForecastBatchRunner::setModels(const QStringList& models, double ensemblePercentile)
+{
+    m_forecastSource.setModels(models);
+    m_forecastSource.setEnsemblePercentile(ensemblePercentile);
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+bool ForecastBatchRunner::outputFormatFromName(const QString& name, OutputFormat* format)
+{
+    const QString lowerCaseName = name.toLower();
+    if (lowerCaseName == "json")
+        *format = OutputFormat::Json;
+    else if (lowerCaseName == "csv")
+        *format = OutputFormat::Csv;
+    else if (lowerCaseName == "binary" || lowerCaseName == "bin")
+        *format = OutputFormat::Binary;
+    else
+        return false;
+    return true;
+}
+
+bool ForecastBatchRunner::start(const QList<CatalogEntry>& catalog, const QString& outputPath, OutputFormat format)
+{
+    m_catalog = catalog;
+    m_format = format;
+    m_nextEntry = 0;
+    m_completed = 0;
+    m_failed = 0;
+    m_peakConcurrentRequests = 0;
+
+    m_output.setFileName(outputPath);
+    if (!m_output.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Unable to write" << outputPath << m_output.errorString();
+        return false;
+    }
+
+    if (m_format == OutputFormat::Binary)
+    {
+        m_binaryStream.setDevice(&m_output);
+        m_binaryStream.setVersion(QDataStream::Qt_6_5);
+    }
+    else
+    {
+        m_textStream.setDevice(&m_output);
+    }
+
+    writeHeader();
+    m_runTimer.start();
+    m_progressTimer.start();
+
+    // Finishing is always asynchronous so callers can connect to finished() after starting.
+    if (m_catalog.isEmpty())
+        QTimer::singleShot(0, this, &ForecastBatchRunner::finishRun);
+    else
+        dispatchRequests();
+    return true;
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+void ForecastBatchRunner::dispatchRequests()
+{
+    while (m_requestsInFlight < m_maximumConcurrentRequests && m_nextEntry < m_catalog.size())
+    {
+        const CatalogEntry& entry = m_catalog.at(m_nextEntry++);
+
+        // The Mountain only lives until its forecast has been written out.
+        Mountain* const mountain = new Mountain(entry.name, entry.latitude, entry.longitude, entry.elevation, this);
+        ++m_requestsInFlight;
+        m_peakConcurrentRequests = std::max(m_peakConcurrentRequests, m_requestsInFlight);
+        m_forecastSource.MakeRequest(entry.longitude, entry.latitude, entry.elevation, mountain);
+    }
+}
+
+void ForecastBatchRunner::handleForecast(Mountain* mountain, bool received)
+{
+    --m_requestsInFlight;
+
+    if (received)
+    {
+        writeRecord(mountain);
+        if (m_archive)
+            m_archive->append(mountain);
+        ++m_completed;
+    }
+    else
+    {
+        ++m_failed;
+    }
+
+    if (mountain)
+        mountain->deleteLater();
+
+    if (m_nextEntry < m_catalog.size())
+        dispatchRequests();
+    else if (m_requestsInFlight == 0)
+        finishRun();
+}
+
+void ForecastBatchRunner::finishRun()
+{
+    m_progressTimer.stop();
+    writeFooter();
+    m_output.close();
+    reportProgress(true);
+    emit finished(m_output.error() == QFileDevice::NoError && m_failed == 0);
+}
+
+void ForecastBatchRunner::reportProgress(bool final) const
+{
+    const double elapsedSeconds = m_runTimer.elapsed() / 1000.0;
+    const double locationsPerSecond = elapsedSeconds > 0.0 ? (m_completed + m_failed) / elapsedSeconds : 0.0;
+    const QVariantMap metrics = Metrics::instance().summary();
+
+    if (final)
+    {
+        qInfo().noquote() << QString("Classified %1 of %2 locations in %3 s (%4 locations/s), %5 failed, "
+                                     "peak %6 concurrent requests, %7 MiB received, round trip p50 %8 ms p99 %9 ms")
+                             .arg(m_completed).arg(m_catalog.size())
+                             .arg(elapsedSeconds, 0, 'f', 1)
+                             .arg(locationsPerSecond, 0, 'f', 1)
+                             .arg(m_failed)
+                             .arg(m_peakConcurrentRequests)
+                             .arg(metrics.value("bytesReceived").toULongLong() / (1024.0 * 1024.0), 0, 'f', 1)
+                             .arg(metrics.value("roundTripP50Milliseconds").toDouble(), 0, 'f', 0)
+                             .arg(metrics.value("roundTripP99Milliseconds").toDouble(), 0, 'f', 0);
+    }
+    else
+    {
+        qInfo().noquote() << QString("%1 of %2 locations (%3 locations/s), %4 failed, %5 in flight")
+                             .arg(m_completed + m_failed).arg(m_catalog.size())
+                             .arg(locationsPerSecond, 0, 'f', 1)
+                             .arg(m_failed)
+                             .arg(m_requestsInFlight);
+    }
+}
+
+void ForecastBatchRunner::writeHeader()
+{
+    switch (m_format)
+    {
+    case OutputFormat::Json:
+        m_textStream << "[";
+        break;
+    case OutputFormat::Csv:
+        m_textStream << "name,latitude,longitude,elevation,date,conditions,weather,precipitation,windspeed,windgusts\n";
+        break;
+    case OutputFormat::Binary:
+        // The header is followed by one record (prefixed by binaryRecordMarker) per location, in the order
+        // the forecasts arrived, then binaryEndMarker and the number of records.
+        m_binaryStream << binaryMagic << binaryVersion;
+        break;
+    }
+}
+
+void ForecastBatchRunner::writeRecord(const Mountain* mountain)
+{
+    const std::shared_ptr<const MountainForecast> forecast = mountain->getForecast();
+    const QList<QDate> dates = forecast->getDates();
+    const QList<QString> weather = forecast->getDailyWeatherConditions();
+    const QList<double> precipitation = forecast->getDailyPrecipitation();
+    const QList<double> windSpeed = forecast->getDailyWindSpeed();
+    const QList<double> windGusts = forecast->getDailyWindGusts();
+    const qsizetype numberOfDays = std::min({dates.size(), weather.size(), precipitation.size(), windSpeed.size(), windGusts.size()});
+
+    switch (m_format)
+    {
+    case OutputFormat::Json:
+    {
+        QJsonArray days;
+        for (int day = 0; day < numberOfDays; ++day)
+        {
+            days.append(QJsonObject{
+                {"date", dates.at(day).toString(Qt::ISODate)},
+                {"conditions", ConditionsClassifier::conditionsName(m_classifier.classifyDay(*forecast, day))},
+                {"weather", weather.at(day)},
+                {"precipitation", precipitation.at(day)},
+                {"windSpeed", windSpeed.at(day)},
+                {"windGusts", windGusts.at(day)}
+            });
+        }
+
+        const QJsonObject record{
+            {"name", mountain->getName()},
+            {"latitude", mountain->getLatitude()},
+            {"longitude", mountain->getLongitude()},
+            {"elevation", mountain->getElevation()},
+            {"days", days}
+        };
+
+        m_textStream << (m_completed == 0 ? "\n" : ",\n") << QJsonDocument(record).toJson(QJsonDocument::Compact);
+        break;
+    }
+    case OutputFormat::Csv:
+    {
+        const QString location = QString("%1,%2,%3,%4").arg(escapeCsvField(mountain->getName()))
+                                     .arg(mountain->getLatitude(), 0, 'f', 6)
+                                     .arg(mountain->getLongitude(), 0, 'f', 6)
+                                     .arg(mountain->getElevation());
+        for (int day = 0; day < numberOfDays; ++day)
+        {
+            m_textStream << location << ','
+                         << dates.at(day).toString(Qt::ISODate) << ','
+                         << ConditionsClassifier::conditionsName(m_classifier.classifyDay(*forecast, day)) << ','
+                         << escapeCsvField(weather.at(day)) << ','
+                         << precipitation.at(day) << ','
+                         << windSpeed.at(day) << ','
+                         << windGusts.at(day) << '\n';
+        }
+        break;
+    }
+    case OutputFormat::Binary:
+    {
+        m_binaryStream << binaryRecordMarker << mountain->getName()
+                       << mountain->getLatitude() << mountain->getLongitude() << mountain->getElevation()
+                       << static_cast<quint8>(numberOfDays);
+        for (int day = 0; day < numberOfDays; ++day)
+        {
+            m_binaryStream << static_cast<qint64>(dates.at(day).toJulianDay())
+                           << static_cast<quint8>(m_classifier.classifyDay(*forecast, day))
+                           << static_cast<float>(precipitation.at(day))
+                           << static_cast<float>(windSpeed.at(day))
+                           << static_cast<float>(windGusts.at(day));
+        }
+        break;
+    }
+    }
+}
+
+void ForecastBatchRunner::writeFooter()
+{
+    switch (m_format)
+    {
+    case OutputFormat::Json:
+        m_textStream << "\n]\n";
+        m_textStream.flush();
+        break;
+    case OutputFormat::Csv:
+        m_textStream.flush();
+        break;
+    case OutputFormat::Binary:
+        m_binaryStream << binaryEndMarker << static_cast<quint32>(m_completed);
+        break;
+    }
+}
@@ -0,0 +1,91 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTBATCHRUNNER_H
+#define FORECASTBATCHRUNNER_H
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTextStream>
+#include <QTimer>
+
+#include "ConditionsClassifier.h"
+#include "ForecastCatalog.h"
+#include "OpenMeteoForecastSource.h"
+
+class ForecastArchive;
+class Mountain;
+
+// Fetches and classifies the forecast for every location in a catalog without a map or any UI,
+// and streams the results to a JSON, CSV or binary file as they arrive. Only the locations that
+// have a request in flight are held in memory, so the memory used is bounded by the maximum number
+// of concurrent requests rather than by the size of the catalog.
+class ForecastBatchRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class OutputFormat
+    {
+        Json,
+        Csv,
+        Binary
+    };
+
+    explicit ForecastBatchRunner(QObject* parent = nullptr);
+
+    static bool outputFormatFromName(const QString& name, OutputFormat* format);
+
+    bool start(const QList<CatalogEntry>& catalog, const QString& outputPath, OutputFormat format);
+
+    void setArchive(ForecastArchive* archive);
+    int getMaximumConcurrentRequests() const;
+    void setMaximumConcurrentRequests(int maximumConcurrentRequests);
+    void setModels(const QStringList& models, double ensemblePercentile);
+
+signals:
+    void finished(bool success);
+
+private:
+    ForecastArchive* m_archive = nullptr;
+    QList<CatalogEntry> m_catalog;
+    ConditionsClassifier m_classifier;
+    qsizetype m_completed = 0;
+    qsizetype m_failed = 0;
+    OpenMeteoForecastSource m_forecastSource;
+    OutputFormat m_format = OutputFormat::Json;
+    int m_maximumConcurrentRequests = 64;
+    qsizetype m_nextEntry = 0;
+    QFile m_output;
+    QDataStream m_binaryStream;
+    QTextStream m_textStream;
+    int m_peakConcurrentRequests = 0;
+    QTimer m_progressTimer;
+    int m_requestsInFlight = 0;
+    QElapsedTimer m_runTimer;
+
+    void dispatchRequests();
+    void handleForecast(Mountain* mountain, bool received);
+    void finishRun();
+    void reportProgress(bool final) const;
+
+    void writeHeader();
+    void writeRecord(const Mountain* mountain);
+    void writeFooter();
+};
+
+#endif // FORECASTBATCHRUNNER_H
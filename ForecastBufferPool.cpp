@@ -0,0 +1,101 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastBufferPool.h"
+#include "MountainForecast.h"
+
+#include <QMutexLocker>
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ForecastBufferPool::ForecastBufferPool(qsizetype maximumSize) :
+    m_maximumSize(maximumSize)
+{
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+quint64 ForecastBufferPool::getAllocations() const
+{
+    return m_allocations.load(std::memory_order_relaxed);
+}
+
+quint64 ForecastBufferPool::getCreated() const
+{
+    return m_created.load(std::memory_order_relaxed);
+}
+
+quint64 ForecastBufferPool::getReused() const
+{
+    return m_reused.load(std::memory_order_relaxed);
+}
+
+qsizetype ForecastBufferPool::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_retired.size();
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+std::shared_ptr<MountainForecast> ForecastBufferPool::acquire()
+{
+    std::shared_ptr<const MountainForecast> recycled;
+    {
+        QMutexLocker locker(&m_mutex);
+
+        // A retired generation can no longer be reached through its Mountain, so once the pool holds
+        // the only reference nobody can start reading it again.
+        for (qsizetype index = 0; index < m_retired.size(); ++index)
+        {
+            if (m_retired.at(index).use_count() == 1)
+            {
+                recycled = std::move(m_retired[index]);
+                m_retired[index] = std::move(m_retired.last());
+                m_retired.removeLast();
+                break;
+            }
+        }
+    }
+
+    if (!recycled)
+    {
+        m_created.fetch_add(1, std::memory_order_relaxed);
+        m_allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::make_shared<MountainForecast>();
+    }
+
+    // Make sure the last reader's accesses happen before the buffers are overwritten. Generations are
+    // never created const (see also Mountain's constructor), so they can be written again here.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto forecast = std::const_pointer_cast<MountainForecast>(std::move(recycled));
+    forecast->clear();
+    m_reused.fetch_add(1, std::memory_order_relaxed);
+    return forecast;
+}
+
+void ForecastBufferPool::recycle(std::shared_ptr<const MountainForecast> forecast)
+{
+    if (!forecast)
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    if (m_retired.size() < m_maximumSize)
+        m_retired.append(std::move(forecast));
+}
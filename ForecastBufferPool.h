@@ -0,0 +1,84 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTBUFFERPOOL_H
+#define FORECASTBUFFERPOOL_H
+
+#include <QList>
+#include <QMutex>
+#include <QVariant>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+class MountainForecast;
+
+// Recycles the forecast generations that have been replaced, so that each refresh fills the buffers
+// of an old generation instead of allocating new ones. A generation is only reused once nothing
+// reads it any more; until then it stays in the pool untouched. Once every location has been
+// refreshed twice, a refresh with the same shape of forecast allocates no forecast storage.
+// Generations are taken on the threads that parse forecasts and returned on the GUI thread.
+class ForecastBufferPool
+{
+public:
+    explicit ForecastBufferPool(qsizetype maximumSize = 65536);
+
+    // A cleared generation to fill, recycled if one is free.
+    std::shared_ptr<MountainForecast> acquire();
+    // A generation that has been replaced, or one that was never published.
+    void recycle(std::shared_ptr<const MountainForecast> forecast);
+
+    // Copies the values into the buffer, reusing its storage where it is large enough and not
+    // shared with anyone still holding a copy of the old values.
+    template<typename T>
+    void assign(QList<T>* buffer, const QList<T>& values)
+    {
+        prepare(buffer, values.size());
+        std::copy(values.cbegin(), values.cend(), buffer->begin());
+    }
+
+    template<typename T>
+    void assign(QList<T>* buffer, const QVariantList& values)
+    {
+        prepare(buffer, values.size());
+        T* const data = buffer->data();
+        for (qsizetype index = 0; index < values.size(); ++index)
+            data[index] = values.at(index).value<T>();
+    }
+
+    // Resizes the buffer to be filled in place, in the same way.
+    template<typename T>
+    void prepare(QList<T>* buffer, qsizetype size)
+    {
+        if (size > 0 && (!buffer->isDetached() || buffer->capacity() < size))
+            m_allocations.fetch_add(1, std::memory_order_relaxed);
+        buffer->resize(size);
+    }
+
+    quint64 getAllocations() const;
+    quint64 getCreated() const;
+    quint64 getReused() const;
+    qsizetype size() const;
+
+private:
+    const qsizetype m_maximumSize;
+    mutable QMutex m_mutex;
+    QList<std::shared_ptr<const MountainForecast>> m_retired;
+    // Buffers that had to be allocated or grown, and generations created and reused.
+    std::atomic<quint64> m_allocations{0};
+    std::atomic<quint64> m_created{0};
+    std::atomic<quint64> m_reused{0};
+};
+
+#endif // FORECASTBUFFERPOOL_H
@@ -0,0 +1,91 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastCatalog.h"
+#include "Mountain.h"
+#include "MountainLocations.h"
+
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+QList<CatalogEntry> ForecastCatalog::load(const QString& path, QString* errorMessage)
+{
+    QFile catalogFile(path);
+    if (!catalogFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        if (errorMessage)
+            *errorMessage = catalogFile.errorString();
+        return {};
+    }
+
+    // Each line is "name,latitude,longitude,elevation". The numbers are taken from the end of the
+    // line so names may contain commas. A header line, blank lines and comments are skipped.
+    QList<CatalogEntry> catalog;
+    QTextStream catalogStream(&catalogFile);
+    int lineNumber = 0;
+    while (!catalogStream.atEnd())
+    {
+        const QString line = catalogStream.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+
+        QStringList fields = line.split(',');
+        bool validLatitude = false;
+        bool validLongitude = false;
+        bool validElevation = false;
+        CatalogEntry entry;
+        if (fields.size() >= 4)
+        {
+            entry.elevation = fields.takeLast().trimmed().toDouble(&validElevation);
+            entry.longitude = fields.takeLast().trimmed().toDouble(&validLongitude);
+            entry.latitude = fields.takeLast().trimmed().toDouble(&validLatitude);
+            entry.name = fields.join(',').trimmed();
+            if (entry.name.size() >= 2 && entry.name.startsWith('"') && entry.name.endsWith('"'))
+                entry.name = entry.name.mid(1, entry.name.size() - 2).replace("\"\"", "\"");
+        }
+
+        if (!validLatitude || !validLongitude || !validElevation)
+        {
+            if (lineNumber == 1)
+                continue;
+
+            if (errorMessage)
+                *errorMessage = QString("Line %1 is not \"name,latitude,longitude,elevation\"").arg(lineNumber);
+            return {};
+        }
+
+        catalog.append(entry);
+    }
+    return catalog;
+}
+
+QList<CatalogEntry> ForecastCatalog::builtIn()
+{
+    const MountainLocations mountainLocations;
+    const QList<Mountain*> mountains = mountainLocations.getLocations();
+
+    QList<CatalogEntry> catalog;
+    catalog.reserve(mountains.size());
+    for (Mountain* mountain : mountains)
+    {
+        catalog.append({mountain->getName(), mountain->getLatitude(), mountain->getLongitude(), mountain->getElevation()});
+        delete mountain;
+    }
+    return catalog;
+}
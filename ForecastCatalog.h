@@ -0,0 +1,37 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTCATALOG_H
+#define FORECASTCATALOG_H
+
+#include <QList>
+#include <QString>
+
+// A location to forecast, without any of the forecast data a Mountain holds.
+struct CatalogEntry
+{
+    QString name;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double elevation = 0.0;
+};
+
+// Loads the list of locations used by the headless tools.
+class ForecastCatalog
+{
+public:
+    static QList<CatalogEntry> load(const QString& path, QString* errorMessage);
+    static QList<CatalogEntry> builtIn();
+};
+
+#endif // FORECASTCATALOG_H
@@ -0,0 +1,121 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastDelta.h"
+
+#include <QDataStream>
+#include <QIODevice>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr quint16 deltaMagic = 0x4644; // "FD"
+    constexpr quint8 deltaProtocolVersion = 1;
+
+    // Precipitation (mm) and wind speed (km/h) are sent in tenths, which is the precision Open-Meteo reports.
+    constexpr float fixedPointScale = 10.0f;
+
+    // The magic, protocol version, epoch, versions and counts; then each location's index, version
+    // and number of days; then each day's index, Julian day, conditions, precipitation and wind speed.
+    constexpr qsizetype headerBytes = 2 + 1 + 8 + 8 + 8 + 4 + 4;
+    constexpr qsizetype locationBytes = 4 + 8 + 1;
+    constexpr qsizetype dayBytes = 1 + 4 + 1 + 2 + 2;
+
+    quint16 toFixedPoint(float value)
+    {
+        return static_cast<quint16>(std::clamp(std::lround(value * fixedPointScale), 0L, 65535L));
+    }
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+QByteArray ForecastDelta::encode(const Message& message)
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_5);
+
+    stream << deltaMagic << deltaProtocolVersion
+           << message.epoch << message.fromVersion << message.toVersion
+           << message.locationCount << static_cast<quint32>(message.changes.size());
+
+    for (const LocationChange& change : message.changes)
+    {
+        stream << change.location << change.version << static_cast<quint8>(change.days.size());
+        for (const DayChange& day : change.days)
+        {
+            stream << day.day
+                   << static_cast<quint32>(day.date.toJulianDay())
+                   << static_cast<quint8>(day.conditions)
+                   << toFixedPoint(day.precipitation)
+                   << toFixedPoint(day.windSpeed);
+        }
+    }
+    return bytes;
+}
+
+bool ForecastDelta::decode(const QByteArray& bytes, Message* message)
+{
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_6_5);
+
+    quint16 magic = 0;
+    quint8 protocolVersion = 0;
+    stream >> magic >> protocolVersion;
+    if (magic != deltaMagic || protocolVersion != deltaProtocolVersion)
+        return false;
+
+    quint32 numberOfChanges = 0;
+    stream >> message->epoch >> message->fromVersion >> message->toVersion
+           >> message->locationCount >> numberOfChanges;
+
+    // A corrupt count must not cause a huge allocation, so the list only grows as changes are read.
+    message->changes.clear();
+    for (quint32 changeIndex = 0; changeIndex < numberOfChanges && stream.status() == QDataStream::Ok; ++changeIndex)
+    {
+        LocationChange change;
+        quint8 numberOfDays = 0;
+        stream >> change.location >> change.version >> numberOfDays;
+
+        change.days.reserve(numberOfDays);
+        for (quint8 dayIndex = 0; dayIndex < numberOfDays; ++dayIndex)
+        {
+            DayChange day;
+            quint32 julianDay = 0;
+            quint8 conditions = 0;
+            quint16 precipitation = 0;
+            quint16 windSpeed = 0;
+            stream >> day.day >> julianDay >> conditions >> precipitation >> windSpeed;
+
+            day.date = QDate::fromJulianDay(julianDay);
+            day.conditions = conditions <= static_cast<quint8>(ConditionsClassifier::Conditions::Bad)
+                                 ? static_cast<ConditionsClassifier::Conditions>(conditions)
+                                 : ConditionsClassifier::Conditions::Unknown;
+            day.precipitation = precipitation / fixedPointScale;
+            day.windSpeed = windSpeed / fixedPointScale;
+            change.days.append(day);
+        }
+        message->changes.append(change);
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+qsizetype ForecastDelta::encodedSize(qsizetype numberOfLocations, qsizetype numberOfDays)
+{
+    return headerBytes + numberOfLocations * locationBytes + numberOfDays * dayBytes;
+}
@@ -0,0 +1,70 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTDELTA_H
+#define FORECASTDELTA_H
+
+#include <QByteArray>
+#include <QDate>
+#include <QList>
+
+#include "ConditionsClassifier.h"
+
+// The binary messages ForecastService pushes to subscribed clients when forecasts change. A message
+// holds only the locations, and the days of those locations, that changed after the version the
+// client already has. A snapshot is a message from version 0 and holds every day of every location.
+//
+// Every location and every day in the service carries the version in which it last changed, so a
+// client that reconnects can send its own per-location versions and receive just what it missed.
+// The epoch identifies one run of the service; versions from another run are meaningless, so a
+// client with a different epoch is sent a snapshot.
+class ForecastDelta
+{
+public:
+    struct DayChange
+    {
+        quint8 day = 0;
+        QDate date;
+        ConditionsClassifier::Conditions conditions = ConditionsClassifier::Conditions::Unknown;
+        float precipitation = 0.0f;
+        float windSpeed = 0.0f;
+    };
+
+    struct LocationChange
+    {
+        quint32 location = 0;
+        quint64 version = 0;
+        QList<DayChange> days;
+    };
+
+    struct Message
+    {
+        quint64 epoch = 0;
+        quint64 fromVersion = 0;
+        quint64 toVersion = 0;
+        quint32 locationCount = 0;
+        QList<LocationChange> changes;
+
+        bool isSnapshot() const
+        {
+            return fromVersion == 0;
+        }
+    };
+
+    static QByteArray encode(const Message& message);
+    static bool decode(const QByteArray& bytes, Message* message);
+    // The size encode() gives a message with these numbers of changed locations and days in all, without encoding it.
+    static qsizetype encodedSize(qsizetype numberOfLocations, qsizetype numberOfDays);
+};
+
+#endif // FORECASTDELTA_H
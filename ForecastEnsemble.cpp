@@ -0,0 +1,98 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastEnsemble.h"
+#include "Tracer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+ForecastEnsemble::Statistics ForecastEnsemble::merge(const QList<QList<double>>& members, double percentile)
+{
+    TRACE_SCOPE("mergeEnsemble");
+
+    qsizetype length = 0;
+    for (const QList<double>& member : members)
+        length = std::max(length, member.size());
+
+    const double infinity = std::numeric_limits<double>::infinity();
+    std::vector<double> sum(length, 0.0);
+    std::vector<double> sumOfSquares(length, 0.0);
+    std::vector<double> count(length, 0.0);
+    std::vector<double> minimum(length, infinity);
+    std::vector<double> maximum(length, -infinity);
+
+    // One pass over each model's contiguous series. The loop has no branches, NaN being masked out by
+    // selects, so the compiler can vectorise it.
+    for (const QList<double>& member : members)
+    {
+        const double* const values = member.constData();
+        const qsizetype size = member.size();
+        for (qsizetype index = 0; index < size; ++index)
+        {
+            const double value = values[index];
+            const bool present = value == value;
+            const double masked = present ? value : 0.0;
+            sum[index] += masked;
+            sumOfSquares[index] += masked * masked;
+            count[index] += present ? 1.0 : 0.0;
+            minimum[index] = present && value < minimum[index] ? value : minimum[index];
+            maximum[index] = present && value > maximum[index] ? value : maximum[index];
+        }
+    }
+
+    Statistics statistics;
+    statistics.mean.resize(length);
+    statistics.minimum.resize(length);
+    statistics.maximum.resize(length);
+    statistics.spread.resize(length);
+    statistics.percentile.resize(length);
+
+    const double rank = std::clamp(percentile, 0.0, 100.0) / 100.0;
+    std::vector<double> column;
+    column.reserve(members.size());
+
+    for (qsizetype index = 0; index < length; ++index)
+    {
+        if (count[index] == 0.0)
+            continue;
+
+        const double mean = sum[index] / count[index];
+        statistics.mean[index] = mean;
+        statistics.minimum[index] = minimum[index];
+        statistics.maximum[index] = maximum[index];
+        statistics.spread[index] = std::sqrt(std::max(0.0, sumOfSquares[index] / count[index] - mean * mean));
+
+        // There are only a handful of models, so sorting each time step is cheap. The percentile is
+        // interpolated between the two nearest models.
+        column.clear();
+        for (const QList<double>& member : members)
+        {
+            if (index < member.size() && member.at(index) == member.at(index))
+                column.push_back(member.at(index));
+        }
+        std::sort(column.begin(), column.end());
+
+        const double position = rank * static_cast<double>(column.size() - 1);
+        const size_t lower = static_cast<size_t>(std::floor(position));
+        const size_t upper = std::min(lower + 1, column.size() - 1);
+        statistics.percentile[index] = column[lower] + (column[upper] - column[lower]) * (position - lower);
+    }
+    return statistics;
+}
@@ -0,0 +1,38 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTENSEMBLE_H
+#define FORECASTENSEMBLE_H
+
+#include <QList>
+
+// Combines the same series from several forecast models into statistics describing how much the
+// models agree. Values a model does not provide are NaN and are left out of the statistics for that
+// time step; a time step no model provides is 0.
+class ForecastEnsemble
+{
+public:
+    struct Statistics
+    {
+        QList<double> mean;
+        QList<double> minimum;
+        QList<double> maximum;
+        // The standard deviation of the models about the mean.
+        QList<double> spread;
+        QList<double> percentile;
+    };
+
+    static Statistics merge(const QList<QList<double>>& members, double percentile);
+};
+
+#endif // FORECASTENSEMBLE_H
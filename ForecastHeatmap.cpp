@@ -0,0 +1,521 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastHeatmap.h"
+#include "ConditionsNavigator.h"
+#include "DailyAggregator.h"
+#include "Mountain.h"
+
+#include <QColor>
+#include <QElapsedTimer>
+#include <QFontMetrics>
+#include <QHash>
+#include <QPainter>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr int rowsPerTile = 64;
+    constexpr int labelWidth = 140;
+
+    // Enough tiles to cover a few screens of rows either side of the viewport.
+    constexpr int maximumNumberOfCachedTiles = 48;
+
+    QRgb colourForConditions(ConditionsClassifier::Conditions conditions)
+    {
+        switch (conditions)
+        {
+        case ConditionsClassifier::Conditions::Good:
+            return qRgb(0, 128, 0);
+        case ConditionsClassifier::Conditions::Marginal:
+            return qRgb(255, 165, 0);
+        case ConditionsClassifier::Conditions::Bad:
+            return qRgb(255, 0, 0);
+        case ConditionsClassifier::Conditions::Unknown:
+            break;
+        }
+        return qRgb(211, 211, 211);
+    }
+
+    // Linear ramp between two colours, with the value clamped to [minimum, maximum].
+    QRgb colourOnRamp(double value, double minimum, double maximum, QRgb low, QRgb high)
+    {
+        if (std::isnan(value))
+            return colourForConditions(ConditionsClassifier::Conditions::Unknown);
+
+        const double fraction = std::clamp((value - minimum) / (maximum - minimum), 0.0, 1.0);
+        const auto mix = [fraction](int from, int to) { return static_cast<int>(from + (to - from) * fraction); };
+        return qRgb(mix(qRed(low), qRed(high)), mix(qGreen(low), qGreen(high)), mix(qBlue(low), qBlue(high)));
+    }
+
+    // Reduce the entries of one day, as found on the forecast's time axis, to a single value for the
+    // "Days" columns.
+    template<typename T, typename Reduce>
+    double reduceDay(const QList<T>& values, const QList<DailyAggregator::DayRange>& days, const QDate& date, Reduce reduce)
+    {
+        const auto day = std::find_if(days.cbegin(), days.cend(), [&date](const DailyAggregator::DayRange& range)
+        {
+            return range.date == date;
+        });
+        if (day == days.cend())
+            return std::nan("");
+
+        const qsizetype last = std::min(day->end, values.size());
+        if (day->begin >= last)
+            return std::nan("");
+
+        double result = values.at(day->begin);
+        for (qsizetype index = day->begin + 1; index < last; ++index)
+            result = reduce(result, static_cast<double>(values.at(index)));
+        return result;
+    }
+
+    double valueAt(const QList<double>& values, qsizetype index)
+    {
+        return index < values.size() ? values.at(index) : std::nan("");
+    }
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ForecastHeatmap::ForecastHeatmap(QQuickItem* parent) :
+    QQuickPaintedItem{parent},
+    m_tiles(maximumNumberOfCachedTiles)
+{
+    setOpaquePainting(true);
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+ConditionsNavigator* ForecastHeatmap::navigator() const
+{
+    return m_navigator;
+}
+
+void ForecastHeatmap::setNavigator(ConditionsNavigator* navigator)
+{
+    if (navigator == m_navigator)
+        return;
+
+    if (m_navigator)
+        disconnect(m_navigator, nullptr, this, nullptr);
+
+    m_navigator = navigator;
+
+    if (m_navigator)
+    {
+        connect(m_navigator, &ConditionsNavigator::mountainsChanged, this, &ForecastHeatmap::connectToMountains);
+        connectToMountains();
+    }
+
+    emit navigatorChanged();
+}
+
+ForecastHeatmap::SortOrder ForecastHeatmap::sortOrder() const
+{
+    return m_sortOrder;
+}
+
+void ForecastHeatmap::setSortOrder(SortOrder sortOrder)
+{
+    if (sortOrder == m_sortOrder)
+        return;
+
+    m_sortOrder = sortOrder;
+    invalidate();
+    emit sortOrderChanged();
+}
+
+ForecastHeatmap::ColumnMode ForecastHeatmap::columnMode() const
+{
+    return m_columnMode;
+}
+
+void ForecastHeatmap::setColumnMode(ColumnMode columnMode)
+{
+    if (columnMode == m_columnMode)
+        return;
+
+    m_columnMode = columnMode;
+    invalidate();
+    emit columnModeChanged();
+}
+
+ForecastHeatmap::ColourMode ForecastHeatmap::colourMode() const
+{
+    return m_colourMode;
+}
+
+void ForecastHeatmap::setColourMode(ColourMode colourMode)
+{
+    if (colourMode == m_colourMode)
+        return;
+
+    m_colourMode = colourMode;
+    invalidate();
+    emit colourModeChanged();
+}
+
+int ForecastHeatmap::rowHeight() const
+{
+    return m_rowHeight;
+}
+
+void ForecastHeatmap::setRowHeight(int rowHeight)
+{
+    if (rowHeight == m_rowHeight || rowHeight < 1)
+        return;
+
+    m_rowHeight = rowHeight;
+    invalidate();
+    emit rowHeightChanged();
+}
+
+qreal ForecastHeatmap::viewportY() const
+{
+    return m_viewportY;
+}
+
+void ForecastHeatmap::setViewportY(qreal viewportY)
+{
+    if (qFuzzyCompare(viewportY, m_viewportY))
+        return;
+
+    // Scrolling only changes which cached tiles are drawn.
+    m_viewportY = viewportY;
+    update();
+    emit viewportYChanged();
+}
+
+qreal ForecastHeatmap::contentHeight() const
+{
+    return static_cast<qreal>(m_rows.size()) * m_rowHeight;
+}
+
+double ForecastHeatmap::lastRenderMilliseconds() const
+{
+    return m_lastRenderMilliseconds;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+void ForecastHeatmap::paint(QPainter* painter)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const int tileHeight = rowsPerTile * m_rowHeight;
+    const int numberOfTiles = static_cast<int>((m_rows.size() + rowsPerTile - 1) / rowsPerTile);
+    const int firstVisibleTile = std::max(0, static_cast<int>(std::floor(m_viewportY / tileHeight)));
+    const int lastVisibleTile = std::min(numberOfTiles - 1, static_cast<int>(std::floor((m_viewportY + height()) / tileHeight)));
+
+    painter->fillRect(QRectF(0, 0, width(), height()), Qt::white);
+
+    for (int tileIndex = firstVisibleTile; tileIndex <= lastVisibleTile; ++tileIndex)
+    {
+        QImage* tile = m_tiles.object(tileIndex);
+        if (tile == nullptr)
+        {
+            tile = new QImage(renderTile(tileIndex));
+            m_tiles.insert(tileIndex, tile);
+        }
+        painter->drawImage(QPointF(0, tileIndex * tileHeight - m_viewportY), *tile);
+    }
+
+    // paint() may run on the scene graph thread, so report the timing from the GUI thread.
+    const double renderMilliseconds = timer.nsecsElapsed() / 1.0e6;
+    QMetaObject::invokeMethod(this, [this, renderMilliseconds]()
+    {
+        m_lastRenderMilliseconds = renderMilliseconds;
+        emit lastRenderMillisecondsChanged();
+    }, Qt::QueuedConnection);
+}
+
+Mountain* ForecastHeatmap::mountainAt(qreal /*x*/, qreal y) const
+{
+    const qsizetype row = static_cast<qsizetype>(std::floor((m_viewportY + y) / m_rowHeight));
+    if (row < 0 || row >= m_rows.size())
+        return nullptr;
+    return m_rows.at(row);
+}
+
+void ForecastHeatmap::invalidate()
+{
+    // Coalesce bursts of invalidations (e.g. a full refresh of the catalog) into a single update.
+    if (m_updateScheduled)
+        return;
+
+    m_updateScheduled = true;
+    QMetaObject::invokeMethod(this, &ForecastHeatmap::updateRowOrder, Qt::QueuedConnection);
+}
+
+// ------------------------------------- //
+//          Protected Methods            //
+// ------------------------------------- //
+
+void ForecastHeatmap::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry)
+{
+    // Tiles span the full width, so they are re-rendered when the width changes.
+    if (!qFuzzyCompare(newGeometry.width(), oldGeometry.width()))
+        m_tiles.clear();
+
+    QQuickPaintedItem::geometryChange(newGeometry, oldGeometry);
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+void ForecastHeatmap::connectToMountains()
+{
+    if (m_navigator == nullptr)
+        return;
+
+    // Only the series drawn in the cells and the days they are classified on. A refresh that leaves
+    // them unchanged, such as a repeat of the last forecast, does not re-render anything.
+    for (Mountain* mountain : m_navigator->mountains())
+    {
+        for (const auto changed : {&Mountain::dailyForecastChanged, &Mountain::hourlyTimeChanged, &Mountain::hourlyPrecipitationChanged,
+                                   &Mountain::hourlyTemperatureChanged, &Mountain::hourlyVisibilityChanged})
+            connect(mountain, changed, this, &ForecastHeatmap::invalidate, Qt::UniqueConnection);
+    }
+
+    invalidate();
+}
+
+void ForecastHeatmap::updateRowOrder()
+{
+    m_updateScheduled = false;
+    m_tiles.clear();
+    m_rows = m_navigator ? m_navigator->mountains() : QList<Mountain*>{};
+    if (m_navigator)
+        m_classifier = m_navigator->classifier();
+
+    m_numberOfColumns = 0;
+    m_columnAxis = TimeAxis();
+    for (const Mountain* mountain : m_rows)
+    {
+        const std::shared_ptr<const MountainForecast> forecast = mountain->getForecast();
+        if (m_columnMode == Days)
+            m_numberOfColumns = std::max(m_numberOfColumns, static_cast<int>(forecast->getDates().size()));
+        else if (forecast->getHourlyTimeAxis().size() > m_columnAxis.size())
+            m_columnAxis = forecast->getHourlyTimeAxis();
+    }
+    if (m_columnMode == Hours)
+        m_numberOfColumns = static_cast<int>(m_columnAxis.size());
+
+    // Hours columns are as wide as the time they cover, so the entries of a tiered forecast after its
+    // first days are several hours wide.
+    m_columnEdges.resize(m_numberOfColumns + 1);
+    for (int column = 0; column <= m_numberOfColumns; ++column)
+        m_columnEdges[column] = m_columnMode == Days ? column : m_columnAxis.getUtcSeconds(column) - m_columnAxis.getUtcSeconds(0);
+
+    switch (m_sortOrder)
+    {
+    case SortByName:
+        std::sort(m_rows.begin(), m_rows.end(), [](const Mountain* first, const Mountain* second)
+        {
+            return QString::localeAwareCompare(first->getName(), second->getName()) < 0;
+        });
+        break;
+    case SortByLatitude:
+        // North to south, which keeps the mountains of each region together.
+        std::sort(m_rows.begin(), m_rows.end(), [](const Mountain* first, const Mountain* second)
+        {
+            return first->getLatitude() > second->getLatitude();
+        });
+        break;
+    case SortByScore:
+    {
+        // Best forecast first: each marginal day costs one point and each bad day three.
+        QHash<const Mountain*, int> scores;
+        for (const Mountain* mountain : m_rows)
+        {
+            int score = 0;
+            const std::shared_ptr<const MountainForecast> forecast = mountain->getForecast();
+            for (int day = 0; day < forecast->getDates().size(); ++day)
+            {
+                switch (m_classifier.classifyDay(*forecast, day))
+                {
+                case ConditionsClassifier::Conditions::Bad:
+                    score += 3;
+                    break;
+                case ConditionsClassifier::Conditions::Unknown:
+                    score += 2;
+                    break;
+                case ConditionsClassifier::Conditions::Marginal:
+                    score += 1;
+                    break;
+                case ConditionsClassifier::Conditions::Good:
+                    break;
+                }
+            }
+            scores.insert(mountain, score);
+        }
+        std::stable_sort(m_rows.begin(), m_rows.end(), [&scores](const Mountain* first, const Mountain* second)
+        {
+            return scores.value(first) < scores.value(second);
+        });
+        break;
+    }
+    }
+
+    emit contentHeightChanged();
+    update();
+}
+
+QList<QRgb> ForecastHeatmap::createRowColours(const Mountain* mountain, int numberOfColumns) const
+{
+    // paint() may run on the scene graph thread while forecasts are published on the GUI thread, so
+    // every colour in the row is taken from the same generation of the forecast.
+    const std::shared_ptr<const MountainForecast> forecast = mountain->getForecast();
+    QList<QRgb> colours(numberOfColumns, colourForConditions(ConditionsClassifier::Conditions::Unknown));
+
+    const bool dailyColumns = m_columnMode == Days;
+    const QList<QDate> dates = forecast->getDates();
+    const QList<DailyAggregator::DayRange> days = DailyAggregator::findDays(forecast->getHourlyTimeAxis());
+    switch (m_colourMode)
+    {
+    case ColourByConditions:
+    {
+        // Conditions are only classified per day, so each hour takes the colour of its day. The copy of
+        // the classifier is used, as the navigator's may be changed on the GUI thread meanwhile.
+        if (dailyColumns)
+        {
+            for (int day = 0; day < numberOfColumns; ++day)
+                colours[day] = colourForConditions(m_classifier.classifyDay(*forecast, day));
+            break;
+        }
+
+        for (const DailyAggregator::DayRange& range : days)
+        {
+            const qsizetype day = dates.indexOf(range.date);
+            if (day < 0)
+                continue;
+
+            const QRgb colour = colourForConditions(m_classifier.classifyDay(*forecast, static_cast<int>(day)));
+            std::fill(colours.begin() + std::min<qsizetype>(range.begin, numberOfColumns),
+                      colours.begin() + std::min<qsizetype>(range.end, numberOfColumns), colour);
+        }
+        break;
+    }
+    case ColourByPrecipitation:
+    {
+        const QList<double> precipitation = dailyColumns ? forecast->getDailyPrecipitation() : forecast->getHourlyPrecipitation();
+        const double maximum = dailyColumns ? 10.0 : 3.0;
+        for (int column = 0; column < numberOfColumns; ++column)
+            colours[column] = colourOnRamp(valueAt(precipitation, column), 0.0, maximum, qRgb(255, 255, 255), qRgb(0, 70, 200));
+        break;
+    }
+    case ColourByTemperature:
+    {
+        const QList<double> temperature = forecast->getHourlyTemperature();
+        for (int column = 0; column < numberOfColumns; ++column)
+        {
+            const double value = dailyColumns ? reduceDay(temperature, days, dates.value(column), [](double a, double b) { return std::max(a, b); })
+                                              : valueAt(temperature, column);
+            colours[column] = colourOnRamp(value, -10.0, 25.0, qRgb(40, 90, 220), qRgb(220, 40, 40));
+        }
+        break;
+    }
+    case ColourByVisibility:
+    {
+        const QList<int> visibility = forecast->getHourlyVisibility();
+        for (int column = 0; column < numberOfColumns; ++column)
+        {
+            const double value = dailyColumns ? reduceDay(visibility, days, dates.value(column), [](double a, double b) { return std::min(a, b); })
+                                              : (column < visibility.size() ? visibility.at(column) : std::nan(""));
+            colours[column] = colourOnRamp(value / 1000.0, 0.0, 25.0, qRgb(60, 60, 60), qRgb(255, 255, 255));
+        }
+        break;
+    }
+    }
+
+    return colours;
+}
+
+QImage ForecastHeatmap::renderTile(int tileIndex) const
+{
+    const int imageWidth = std::max(1, static_cast<int>(width()));
+    QImage image(imageWidth, rowsPerTile * m_rowHeight, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+
+    const int firstRow = tileIndex * rowsPerTile;
+    const int lastRow = std::min(firstRow + rowsPerTile, static_cast<int>(m_rows.size()));
+    const int cellAreaWidth = imageWidth - labelWidth;
+
+    // The cells are written straight into the scan lines; only the labels go through QPainter.
+    if (cellAreaWidth > 0 && m_numberOfColumns > 0)
+    {
+        const qint64 span = m_columnEdges.last();
+        QList<int> columnAtX(cellAreaWidth);
+        int column = 0;
+        for (int x = 0; x < cellAreaWidth; ++x)
+        {
+            const qint64 position = x * span / cellAreaWidth;
+            while (column + 1 < m_numberOfColumns && m_columnEdges.at(column + 1) <= position)
+                ++column;
+            columnAtX[x] = column;
+        }
+
+        for (int row = firstRow; row < lastRow; ++row)
+        {
+            const QList<QRgb> colours = createRowColours(m_rows.at(row), m_numberOfColumns);
+            const int top = (row - firstRow) * m_rowHeight;
+
+            // Leave a one pixel gap between rows.
+            for (int y = top; y < top + m_rowHeight - 1; ++y)
+            {
+                QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y)) + labelWidth;
+                for (int x = 0; x < cellAreaWidth; ++x)
+                    line[x] = colours.at(columnAtX.at(x));
+            }
+        }
+    }
+
+    QPainter painter(&image);
+    QFont font = painter.font();
+    font.setPixelSize(std::max(8, m_rowHeight - 3));
+    painter.setFont(font);
+    const QFontMetrics fontMetrics(font);
+    for (int row = firstRow; row < lastRow; ++row)
+    {
+        const QRect labelRect(2, (row - firstRow) * m_rowHeight, labelWidth - 4, m_rowHeight);
+        const QString label = fontMetrics.elidedText(m_rows.at(row)->getName(), Qt::ElideRight, labelRect.width());
+        painter.drawText(labelRect, Qt::AlignVCenter | Qt::AlignLeft, label);
+    }
+
+    // Mark the start of each day when showing hours.
+    if (m_columnMode == Hours && cellAreaWidth > 0 && m_numberOfColumns > 0)
+    {
+        painter.setPen(QColor(255, 255, 255, 160));
+        const qint64 span = m_columnEdges.last();
+        for (const DailyAggregator::DayRange& day : DailyAggregator::findDays(m_columnAxis))
+        {
+            if (day.begin == 0)
+                continue;
+            const int x = labelWidth + static_cast<int>(m_columnEdges.at(day.begin) * cellAreaWidth / span);
+            painter.drawLine(x, 0, x, (lastRow - firstRow) * m_rowHeight);
+        }
+    }
+
+    return image;
+}
@@ -0,0 +1,134 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTHEATMAP_H
+#define FORECASTHEATMAP_H
+
+#include <QCache>
+#include <QImage>
+#include <QList>
+#include <QQuickPaintedItem>
+#include <QRgb>
+
+#include "ConditionsClassifier.h"
+#include "TimeAxis.h"
+
+class ConditionsNavigator;
+class Mountain;
+
+Q_MOC_INCLUDE("ConditionsNavigator.h")
+
+// Overview of every mountain (rows) against every forecast day or hour (columns).
+// The item only covers the visible viewport: a Flickable supplies viewportY and scrolls over
+// contentHeight, and only the tiles of rows intersecting the viewport are ever rendered.
+class ForecastHeatmap : public QQuickPaintedItem
+{
+    Q_OBJECT
+
+    Q_PROPERTY(ConditionsNavigator* navigator READ navigator WRITE setNavigator NOTIFY navigatorChanged)
+    Q_PROPERTY(SortOrder sortOrder READ sortOrder WRITE setSortOrder NOTIFY sortOrderChanged)
+    Q_PROPERTY(ColumnMode columnMode READ columnMode WRITE setColumnMode NOTIFY columnModeChanged)
+    Q_PROPERTY(ColourMode colourMode READ colourMode WRITE setColourMode NOTIFY colourModeChanged)
+    Q_PROPERTY(int rowHeight READ rowHeight WRITE setRowHeight NOTIFY rowHeightChanged)
+    Q_PROPERTY(qreal viewportY READ viewportY WRITE setViewportY NOTIFY viewportYChanged)
+    Q_PROPERTY(qreal contentHeight READ contentHeight NOTIFY contentHeightChanged)
+    Q_PROPERTY(double lastRenderMilliseconds READ lastRenderMilliseconds NOTIFY lastRenderMillisecondsChanged)
+
+public:
+    enum SortOrder
+    {
+        SortByName,
+        SortByLatitude,
+        SortByScore
+    };
+    Q_ENUM(SortOrder)
+
+    enum ColumnMode
+    {
+        Days,
+        Hours
+    };
+    Q_ENUM(ColumnMode)
+
+    enum ColourMode
+    {
+        ColourByConditions,
+        ColourByPrecipitation,
+        ColourByTemperature,
+        ColourByVisibility
+    };
+    Q_ENUM(ColourMode)
+
+    explicit ForecastHeatmap(QQuickItem* parent = nullptr);
+
+    void paint(QPainter* painter) override;
+
+    Q_INVOKABLE Mountain* mountainAt(qreal x, qreal y) const;
+    Q_INVOKABLE void invalidate();
+
+    ConditionsNavigator* navigator() const;
+    void setNavigator(ConditionsNavigator* navigator);
+    SortOrder sortOrder() const;
+    void setSortOrder(SortOrder sortOrder);
+    ColumnMode columnMode() const;
+    void setColumnMode(ColumnMode columnMode);
+    ColourMode colourMode() const;
+    void setColourMode(ColourMode colourMode);
+    int rowHeight() const;
+    void setRowHeight(int rowHeight);
+    qreal viewportY() const;
+    void setViewportY(qreal viewportY);
+    qreal contentHeight() const;
+    double lastRenderMilliseconds() const;
+
+signals:
+    void navigatorChanged();
+    void sortOrderChanged();
+    void columnModeChanged();
+    void colourModeChanged();
+    void rowHeightChanged();
+    void viewportYChanged();
+    void contentHeightChanged();
+    void lastRenderMillisecondsChanged();
+
+protected:
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private:
+    void connectToMountains();
+    QList<QRgb> createRowColours(const Mountain* mountain, int numberOfColumns) const;
+    QImage renderTile(int tileIndex) const;
+    void updateRowOrder();
+
+    ConditionsNavigator* m_navigator = nullptr;
+    SortOrder m_sortOrder = SortByLatitude;
+    ColumnMode m_columnMode = Days;
+    ColourMode m_colourMode = ColourByConditions;
+    int m_rowHeight = 14;
+    qreal m_viewportY = 0.0;
+    double m_lastRenderMilliseconds = 0.0;
+
+    // A copy of the navigator's classifier taken on the GUI thread whenever the rows are updated, as
+    // the tiles may be rendered on the scene graph thread while the navigator's is changed.
+    ConditionsClassifier m_classifier;
+    QList<Mountain*> m_rows;
+    int m_numberOfColumns = 0;
+    // The hours columns follow the longest time axis of the rows. Each column spans from its edge to
+    // the next, in seconds for hours and in days for days.
+    TimeAxis m_columnAxis;
+    QList<qint64> m_columnEdges;
+    bool m_updateScheduled = false;
+    mutable QCache<int, QImage> m_tiles;
+};
+
+#endif // FORECASTHEATMAP_H
@@ -0,0 +1,705 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastService.h"
+#include "ForecastArchive.h"
+#include "Mountain.h"
+#include "Tracer.h"
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUrlQuery>
+#include <QWebSocket>
+#include <QWebSocketServer>
+
+#include <cmath>
+
+namespace
+{
+    // Requests are a request line and a few headers; anything larger is not a forecast request.
+    constexpr qint64 maximumRequestHeaderSize = 8192;
+
+    // Clients that have this much data waiting to be sent to them are not reading it, so they are dropped.
+    constexpr qint64 maximumPendingBytesPerClient = 4 * 1024 * 1024;
+
+    // Forecast requests are matched to catalog locations on a grid of about 100m.
+    constexpr double gridCellsPerDegree = 1000.0;
+    constexpr double maximumLocationDistanceDegrees = 0.001;
+
+    QByteArray httpResponse(int statusCode, const QByteArray& contentType, const QByteArray& body, bool keepAlive)
+    {
+        QByteArray reasonPhrase;
+        switch (statusCode)
+        {
+        case 200: reasonPhrase = "OK"; break;
+        case 400: reasonPhrase = "Bad Request"; break;
+        case 404: reasonPhrase = "Not Found"; break;
+        case 405: reasonPhrase = "Method Not Allowed"; break;
+        default: reasonPhrase = "Service Unavailable"; break;
+        }
+
+        return "HTTP/1.1 " + QByteArray::number(statusCode) + ' ' + reasonPhrase + "\r\n" +
+               "Content-Type: " + contentType + "\r\n" +
+               "Content-Length: " + QByteArray::number(body.size()) + "\r\n" +
+               (keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n") + body;
+    }
+
+    QByteArray errorBody(const QByteArray& reason)
+    {
+        return "{\"error\":true,\"reason\":\"" + reason + "\"}";
+    }
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ForecastService::ForecastService(QObject* parent) :
+    QObject{parent},
+    m_server(new QTcpServer(this)),
+    m_webSocketServer(new QWebSocketServer("ConditionsNavigatorService", QWebSocketServer::NonSecureMode, this))
+{
+    connect(m_server, &QTcpServer::newConnection, this, &ForecastService::handleNewConnections);
+    connect(m_webSocketServer, &QWebSocketServer::newConnection, this, &ForecastService::handleNewWebSocketConnections);
+
+    connect(&m_forecastSource, &OpenMeteoForecastSource::replyReceived, this, &ForecastService::storeReply);
+    connect(&m_forecastSource, &OpenMeteoForecastSource::forecastReceived, this, [this](Mountain* mountain){
+        storeForecast(mountain);
+        finishRequest(mountain);
+    });
+    connect(&m_forecastSource, &OpenMeteoForecastSource::forecastFailed, this, [this](Mountain* mountain, const QString& failureType){
+        // The previous forecast for the location, if any, continues to be served.
+        qWarning() << "Unable to refresh the forecast for" << (mountain ? mountain->getName() : QString()) << failureType;
+        finishRequest(mountain);
+    });
+
+    m_epoch = QRandomGenerator::global()->generate64() | 1;
+
+    m_refreshTimer.setInterval(30 * 60 * 1000);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &ForecastService::refresh);
+
+    rebuildCatalogSnapshot();
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+void ForecastService::setArchive(ForecastArchive* archive)
+{
+    m_archive = archive;
+}
+
+void ForecastService::setCatalog(const QList<CatalogEntry>& catalog)
+{
+    m_catalog = catalog;
+    m_forecasts = QList<StoredForecast>(m_catalog.size());
+
+    m_locationGrid.clear();
+    for (int index = 0; index < m_catalog.size(); ++index)
+    {
+        const CatalogEntry& entry = m_catalog.at(index);
+        const quint64 key = gridKey(std::llround(entry.latitude * gridCellsPerDegree), std::llround(entry.longitude * gridCellsPerDegree));
+        m_locationGrid[key].append(index);
+    }
+
+    rebuildCatalogSnapshot();
+}
+
+void ForecastService::setMaximumConcurrentRequests(int maximumConcurrentRequests)
+{
+    m_maximumConcurrentRequests = std::max(1, maximumConcurrentRequests);
+}
+
+void ForecastService::setMaximumSessions(int maximumSessions)
+{
+    m_maximumSessions = std::max(1, maximumSessions);
+}
+
+void ForecastService::setModels(const QStringList& models, double ensemblePercentile)
+{
+    m_forecastSource.setModels(models);
+    m_forecastSource.setEnsemblePercentile(ensemblePercentile);
+}
+
+void ForecastService::setRefreshInterval(int minutes)
+{
+    m_refreshTimer.setInterval(std::max(1, minutes) * 60 * 1000);
+}
+
+void ForecastService::setUpstreamUrl(const QUrl& upstreamUrl)
+{
+    m_forecastSource.setBaseUrl(upstreamUrl);
+}
+
+quint64 ForecastService::getVersion() const
+{
+    return m_version;
+}
+
+int ForecastService::getSessionCount() const
+{
+    return m_sessionCount;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+bool ForecastService::listen(const QHostAddress& address, quint16 port)
+{
+    if (!m_server->listen(address, port))
+    {
+        qWarning() << "Unable to serve forecasts on port" << port << m_server->errorString();
+        return false;
+    }
+
+    m_refreshTimer.start();
+    return true;
+}
+
+quint16 ForecastService::port() const
+{
+    return m_server->serverPort();
+}
+
+void ForecastService::refresh()
+{
+    if (m_refreshing || m_catalog.isEmpty())
+        return;
+
+    Tracer::instance().addAsyncBegin("serviceRefresh", m_version + 1);
+    m_refreshing = true;
+    m_refreshChangedForecasts = false;
+    m_nextEntry = 0;
+    dispatchRequests();
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+void ForecastService::dispatchRequests()
+{
+    while (m_requestsInFlight < m_maximumConcurrentRequests && m_nextEntry < m_catalog.size())
+    {
+        const int index = static_cast<int>(m_nextEntry++);
+        const CatalogEntry& entry = m_catalog.at(index);
+
+        // Like the batch runner, a Mountain only exists while its request is in flight.
+        Mountain* const mountain = new Mountain(entry.name, entry.latitude, entry.longitude, entry.elevation, this);
+        m_mountainIndices.insert(mountain, index);
+        ++m_requestsInFlight;
+        m_forecastSource.MakeRequest(entry.longitude, entry.latitude, entry.elevation, mountain);
+    }
+}
+
+void ForecastService::storeReply(Mountain* mountain, const QByteArray& jsonBytes)
+{
+    // The response is only served once it has been parsed successfully (see storeForecast).
+    m_pendingResponses.insert(mountain, jsonBytes);
+}
+
+void ForecastService::storeForecast(Mountain* mountain)
+{
+    const int index = m_mountainIndices.value(mountain, -1);
+    if (index < 0)
+        return;
+
+    const std::shared_ptr<const MountainForecast> forecast = mountain->getForecast();
+    const QList<QDate> dates = forecast->getDates();
+    const QList<double> precipitation = forecast->getDailyPrecipitation();
+    const QList<double> windSpeed = forecast->getDailyWindSpeed();
+    const qsizetype numberOfDays = std::min({dates.size(), precipitation.size(), windSpeed.size()});
+
+    QList<DailySummary> days;
+    days.reserve(numberOfDays);
+    for (int day = 0; day < numberOfDays; ++day)
+    {
+        days.append({dates.at(day), m_classifier.classifyDay(*forecast, day),
+                     static_cast<float>(precipitation.at(day)), static_cast<float>(windSpeed.at(day))});
+    }
+
+    // Only the days whose values changed, and the locations they belong to, are given the new version.
+    StoredForecast& storedForecast = m_forecasts[index];
+    storedForecast.response = m_pendingResponses.take(mountain);
+
+    // The archive skips forecasts that are the same as the last one it stored for the location.
+    if (m_archive)
+        m_archive->append(mountain);
+
+    if (storedForecast.days == days)
+        return;
+
+    const quint64 newVersion = m_version + 1;
+    storedForecast.dayVersions.resize(days.size());
+    for (int day = 0; day < days.size(); ++day)
+    {
+        if (day >= storedForecast.days.size() || !(storedForecast.days.at(day) == days.at(day)))
+            storedForecast.dayVersions[day] = newVersion;
+    }
+    storedForecast.days = days;
+    storedForecast.version = newVersion;
+    m_refreshChangedForecasts = true;
+}
+
+void ForecastService::finishRequest(Mountain* mountain)
+{
+    m_mountainIndices.remove(mountain);
+    m_pendingResponses.remove(mountain);
+    if (mountain)
+        mountain->deleteLater();
+    --m_requestsInFlight;
+
+    if (m_nextEntry < m_catalog.size())
+        dispatchRequests();
+    else if (m_requestsInFlight == 0)
+        finishRefresh();
+}
+
+void ForecastService::finishRefresh()
+{
+    Tracer::instance().addAsyncEnd("serviceRefresh", m_version + 1);
+    m_refreshing = false;
+
+    if (!m_refreshChangedForecasts)
+        return;
+
+    ++m_version;
+    rebuildCatalogSnapshot();
+
+    const QString catalogMessage = QString::fromUtf8(m_catalogSnapshot);
+    const QList<QWebSocket*> subscribers = m_subscribers.values();
+    for (QWebSocket* webSocket : subscribers)
+    {
+        if (hasRoomFor(webSocket, m_catalogSnapshot.size()))
+            webSocket->sendTextMessage(catalogMessage);
+    }
+
+    pushDeltas();
+
+    emit refreshed(m_version);
+}
+
+void ForecastService::pushDeltas()
+{
+    if (m_deltaSubscribers.isEmpty())
+        return;
+
+    TRACE_SCOPE("pushDeltas");
+
+    // Subscribers are normally all at the previous version, so each distinct delta is encoded once.
+    QHash<quint64, QByteArray> encodedDeltas;
+    qint64 bytesSent = 0;
+    const QList<QWebSocket*> subscribers = m_deltaSubscribers.keys();
+    for (QWebSocket* webSocket : subscribers)
+    {
+        const quint64 fromVersion = m_deltaSubscribers.value(webSocket);
+        auto encodedDelta = encodedDeltas.find(fromVersion);
+        if (encodedDelta == encodedDeltas.end())
+            encodedDelta = encodedDeltas.insert(fromVersion, ForecastDelta::encode(createDelta(fromVersion, nullptr)));
+
+        if (!hasRoomFor(webSocket, encodedDelta.value().size()))
+            continue;
+
+        webSocket->sendBinaryMessage(encodedDelta.value());
+        m_deltaSubscribers.insert(webSocket, m_version);
+        bytesSent += encodedDelta.value().size();
+    }
+
+    // The snapshot a new subscriber would be sent, which is only counted, not encoded.
+    qsizetype snapshotLocations = 0;
+    qsizetype snapshotDays = 0;
+    for (const StoredForecast& storedForecast : std::as_const(m_forecasts))
+    {
+        if (storedForecast.days.isEmpty())
+            continue;
+        ++snapshotLocations;
+        snapshotDays += storedForecast.days.size();
+    }
+    const qsizetype snapshotSize = ForecastDelta::encodedSize(snapshotLocations, snapshotDays);
+    qInfo("Pushed version %llu to %lld subscribers: %lld bytes of deltas against %lld bytes of binary snapshots "
+          "or %lld bytes of JSON catalogs",
+          m_version, static_cast<long long>(subscribers.size()), static_cast<long long>(bytesSent),
+          static_cast<long long>(snapshotSize * subscribers.size()),
+          static_cast<long long>(m_catalogSnapshot.size() * subscribers.size()));
+}
+
+ForecastDelta::Message ForecastService::createDelta(quint64 fromVersion, const QList<quint64>* locationVersions) const
+{
+    ForecastDelta::Message message;
+    message.epoch = m_epoch;
+    message.fromVersion = fromVersion;
+    message.toVersion = m_version;
+    message.locationCount = static_cast<quint32>(m_catalog.size());
+
+    for (int index = 0; index < m_forecasts.size(); ++index)
+    {
+        // A client's own version vector, when it has sent one, says what it already has of each location.
+        const quint64 knownVersion = locationVersions ? locationVersions->value(index, 0) : fromVersion;
+        const StoredForecast& storedForecast = m_forecasts.at(index);
+        if (storedForecast.version <= knownVersion && knownVersion != 0)
+            continue;
+        if (storedForecast.days.isEmpty())
+            continue;
+
+        ForecastDelta::LocationChange change;
+        change.location = static_cast<quint32>(index);
+        change.version = storedForecast.version;
+        for (int day = 0; day < storedForecast.days.size(); ++day)
+        {
+            if (knownVersion != 0 && storedForecast.dayVersions.value(day) <= knownVersion)
+                continue;
+
+            const DailySummary& summary = storedForecast.days.at(day);
+            change.days.append({static_cast<quint8>(day), summary.date, summary.conditions, summary.precipitation, summary.windSpeed});
+        }
+        message.changes.append(change);
+    }
+    return message;
+}
+
+void ForecastService::rebuildCatalogSnapshot()
+{
+    TRACE_SCOPE("rebuildCatalogSnapshot");
+
+    QJsonArray locations;
+    for (int index = 0; index < m_catalog.size(); ++index)
+    {
+        const CatalogEntry& entry = m_catalog.at(index);
+        const StoredForecast& storedForecast = m_forecasts.at(index);
+
+        QJsonArray days;
+        for (const DailySummary& day : storedForecast.days)
+        {
+            days.append(QJsonObject{
+                {"date", day.date.toString(Qt::ISODate)},
+                {"conditions", ConditionsClassifier::conditionsName(day.conditions)},
+                {"precipitation", day.precipitation},
+                {"windSpeed", day.windSpeed}
+            });
+        }
+
+        locations.append(QJsonObject{
+            {"name", entry.name},
+            {"latitude", entry.latitude},
+            {"longitude", entry.longitude},
+            {"elevation", entry.elevation},
+            {"version", static_cast<qint64>(storedForecast.version)},
+            {"days", days}
+        });
+    }
+
+    const QJsonObject catalog{
+        {"type", "catalog"},
+        {"version", static_cast<qint64>(m_version)},
+        {"locations", locations}
+    };
+    m_catalogSnapshot = QJsonDocument(catalog).toJson(QJsonDocument::Compact);
+}
+
+int ForecastService::findLocation(double latitude, double longitude) const
+{
+    const qint64 latitudeCell = std::llround(latitude * gridCellsPerDegree);
+    const qint64 longitudeCell = std::llround(longitude * gridCellsPerDegree);
+
+    // Coordinates are rounded by the client, so the neighbouring cells are searched as well.
+    int nearestIndex = -1;
+    double nearestDistance = maximumLocationDistanceDegrees;
+    for (qint64 latitudeOffset = -1; latitudeOffset <= 1; ++latitudeOffset)
+    {
+        for (qint64 longitudeOffset = -1; longitudeOffset <= 1; ++longitudeOffset)
+        {
+            const auto cell = m_locationGrid.constFind(gridKey(latitudeCell + latitudeOffset, longitudeCell + longitudeOffset));
+            if (cell == m_locationGrid.constEnd())
+                continue;
+
+            for (int index : cell.value())
+            {
+                const CatalogEntry& entry = m_catalog.at(index);
+                const double distance = std::hypot(entry.latitude - latitude, entry.longitude - longitude);
+                if (distance <= nearestDistance)
+                {
+                    nearestDistance = distance;
+                    nearestIndex = index;
+                }
+            }
+        }
+    }
+    return nearestIndex;
+}
+
+quint64 ForecastService::gridKey(qint64 latitudeCell, qint64 longitudeCell)
+{
+    return (static_cast<quint64>(static_cast<quint32>(latitudeCell)) << 32) | static_cast<quint32>(longitudeCell);
+}
+
+void ForecastService::handleNewConnections()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection())
+    {
+        if (m_sessionCount >= m_maximumSessions)
+        {
+            socket->write(httpResponse(503, "application/json", errorBody("Too many sessions"), false));
+            socket->disconnectFromHost();
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            continue;
+        }
+
+        ++m_sessionCount;
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket](){
+            --m_sessionCount;
+            socket->deleteLater();
+        });
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket](){
+            handleHttpData(socket);
+        });
+    }
+}
+
+void ForecastService::handleHttpData(QTcpSocket* socket)
+{
+    while (true)
+    {
+        // Wait until a whole request header has arrived.
+        const QByteArray buffered = socket->peek(maximumRequestHeaderSize);
+        const qsizetype headerEnd = buffered.indexOf("\r\n\r\n");
+        if (headerEnd < 0)
+        {
+            if (socket->bytesAvailable() >= maximumRequestHeaderSize)
+                socket->abort();
+            return;
+        }
+
+        const QByteArray header = buffered.left(headerEnd);
+        const QByteArray lowerCaseHeader = header.toLower();
+
+        if (lowerCaseHeader.contains("upgrade: websocket"))
+        {
+            // The WebSocket server reads the handshake itself and takes over the socket; the session
+            // continues to be counted until the WebSocket disconnects.
+            socket->disconnect(this);
+            socket->disconnect(socket);
+            m_webSocketServer->handleConnection(socket);
+            return;
+        }
+
+        socket->read(headerEnd + 4);
+
+        const QList<QByteArray> requestLine = header.left(header.indexOf("\r\n")).split(' ');
+        const bool keepAlive = !lowerCaseHeader.contains("connection: close");
+
+        int statusCode = 200;
+        QByteArray body;
+        if (requestLine.size() < 2)
+        {
+            statusCode = 400;
+            body = errorBody("Malformed request");
+        }
+        else if (requestLine.at(0) != "GET")
+        {
+            statusCode = 405;
+            body = errorBody("Only GET is supported");
+        }
+        else
+        {
+            const QUrl target("http://localhost" + QString::fromUtf8(requestLine.at(1)));
+            const QUrlQuery query(target);
+            if (target.path() == "/v1/forecast")
+            {
+                bool validLatitude = false;
+                bool validLongitude = false;
+                const double latitude = query.queryItemValue("latitude").toDouble(&validLatitude);
+                const double longitude = query.queryItemValue("longitude").toDouble(&validLongitude);
+                if (validLatitude && validLongitude)
+                {
+                    body = forecastResponseFor(latitude, longitude, &statusCode);
+                }
+                else
+                {
+                    statusCode = 400;
+                    body = errorBody("latitude and longitude are required");
+                }
+            }
+            else if (target.path() == "/v1/catalog")
+            {
+                body = m_catalogSnapshot;
+            }
+            else if (target.path() == "/v1/history")
+            {
+                body = historyResponseFor(query, &statusCode);
+            }
+            else
+            {
+                statusCode = 404;
+                body = errorBody("Not found");
+            }
+        }
+
+        socket->write(httpResponse(statusCode, "application/json", body, keepAlive));
+        if (!keepAlive || socket->bytesToWrite() > maximumPendingBytesPerClient)
+        {
+            socket->disconnectFromHost();
+            return;
+        }
+    }
+}
+
+void ForecastService::handleNewWebSocketConnections()
+{
+    while (QWebSocket* webSocket = m_webSocketServer->nextPendingConnection())
+    {
+        connect(webSocket, &QWebSocket::textMessageReceived, this, [this, webSocket](const QString& message){
+            handleWebSocketMessage(webSocket, message);
+        });
+        connect(webSocket, &QWebSocket::disconnected, this, [this, webSocket](){
+            m_subscribers.remove(webSocket);
+            m_deltaSubscribers.remove(webSocket);
+            --m_sessionCount;
+            webSocket->deleteLater();
+        });
+    }
+}
+
+void ForecastService::handleWebSocketMessage(QWebSocket* webSocket, const QString& message)
+{
+    const QJsonObject request = QJsonDocument::fromJson(message.toUtf8()).object();
+    const QString type = request.value("type").toString();
+
+    if (type == "subscribe")
+    {
+        m_subscribers.insert(webSocket);
+        if (hasRoomFor(webSocket, m_catalogSnapshot.size()))
+            webSocket->sendTextMessage(QString::fromUtf8(m_catalogSnapshot));
+    }
+    else if (type == "unsubscribe")
+    {
+        m_subscribers.remove(webSocket);
+        m_deltaSubscribers.remove(webSocket);
+    }
+    else if (type == "subscribeDeltas" || type == "resync")
+    {
+        // Epochs are sent as strings because JSON numbers cannot hold every 64-bit value.
+        const bool sameEpoch = request.value("epoch").toString().toULongLong() == m_epoch;
+        const quint64 clientVersion = static_cast<quint64>(request.value("version").toInteger());
+
+        ForecastDelta::Message delta;
+        if (!sameEpoch || clientVersion > m_version)
+        {
+            delta = createDelta(0, nullptr);
+        }
+        else if (type == "resync")
+        {
+            QList<quint64> locationVersions;
+            const QJsonArray versions = request.value("versions").toArray();
+            locationVersions.reserve(versions.size());
+            for (const QJsonValue& version : versions)
+                locationVersions.append(static_cast<quint64>(version.toInteger()));
+            delta = createDelta(clientVersion, &locationVersions);
+        }
+        else
+        {
+            delta = createDelta(clientVersion, nullptr);
+        }
+
+        const QByteArray encodedDelta = ForecastDelta::encode(delta);
+        if (hasRoomFor(webSocket, encodedDelta.size()))
+        {
+            webSocket->sendBinaryMessage(encodedDelta);
+            m_deltaSubscribers.insert(webSocket, m_version);
+        }
+    }
+    else if (type == "forecast")
+    {
+        int statusCode = 200;
+        const QByteArray forecast = forecastResponseFor(request.value("latitude").toDouble(),
+                                                        request.value("longitude").toDouble(), &statusCode);
+        const QByteArray reply = "{\"type\":\"forecast\",\"status\":" + QByteArray::number(statusCode) +
+                                 ",\"forecast\":" + forecast + "}";
+        if (hasRoomFor(webSocket, reply.size()))
+            webSocket->sendTextMessage(QString::fromUtf8(reply));
+    }
+    else
+    {
+        webSocket->sendTextMessage(QString::fromUtf8(errorBody("Unknown message type")));
+    }
+}
+
+QByteArray ForecastService::forecastResponseFor(double latitude, double longitude, int* statusCode) const
+{
+    const int index = findLocation(latitude, longitude);
+    if (index < 0)
+    {
+        *statusCode = 404;
+        return errorBody("The location is not in the catalog");
+    }
+
+    const QByteArray& response = m_forecasts.at(index).response;
+    if (response.isEmpty())
+    {
+        *statusCode = 503;
+        return errorBody("The forecast has not been retrieved yet");
+    }
+
+    *statusCode = 200;
+    return response;
+}
+
+QByteArray ForecastService::historyResponseFor(const QUrlQuery& query, int* statusCode)
+{
+    if (m_archive == nullptr)
+    {
+        *statusCode = 404;
+        return errorBody("Forecasts are not being archived");
+    }
+
+    const QString location = query.queryItemValue("location", QUrl::FullyDecoded);
+    const QDateTime target = QDateTime::fromString(query.queryItemValue("target"), Qt::ISODate);
+    ForecastArchive::Field field;
+    if (location.isEmpty() || !target.isValid() || !ForecastArchive::fieldFromName(query.queryItemValue("field"), &field))
+    {
+        *statusCode = 400;
+        return errorBody("location, field and target are required");
+    }
+
+    const QDateTime issuedFrom = QDateTime::fromString(query.queryItemValue("from"), Qt::ISODate);
+    const QDateTime issuedTo = QDateTime::fromString(query.queryItemValue("to"), Qt::ISODate);
+
+    QJsonArray revisions;
+    for (const ForecastArchive::Revision& revision : m_archive->revisions(location, field, target, issuedFrom, issuedTo))
+        revisions.append(QJsonObject{{"issued", revision.issued.toString(Qt::ISODate)}, {"value", revision.value}});
+
+    *statusCode = 200;
+    return QJsonDocument(QJsonObject{
+        {"location", location},
+        {"field", ForecastArchive::fieldName(field)},
+        {"target", target.toString(Qt::ISODate)},
+        {"revisions", revisions}
+    }).toJson(QJsonDocument::Compact);
+}
+
+bool ForecastService::hasRoomFor(QWebSocket* webSocket, qsizetype messageSize)
+{
+    if (webSocket->bytesToWrite() + messageSize > maximumPendingBytesPerClient)
+    {
+        qWarning() << "Disconnecting a client that is not reading its updates" << webSocket->peerAddress();
+        webSocket->abort();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,153 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTSERVICE_H
+#define FORECASTSERVICE_H
+
+#include <QByteArray>
+#include <QDate>
+#include <QHash>
+#include <QHostAddress>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+
+#include "ConditionsClassifier.h"
+#include "ForecastCatalog.h"
+#include "ForecastDelta.h"
+#include "OpenMeteoForecastSource.h"
+
+class ForecastArchive;
+class Mountain;
+class QTcpServer;
+class QUrlQuery;
+class QTcpSocket;
+class QWebSocket;
+class QWebSocketServer;
+
+// Holds one periodically refreshed copy of the forecast for every location in a catalog and serves
+// it to many clients, so that each phone does not have to query Open-Meteo for every mountain.
+//
+// HTTP (keep-alive is supported):
+//   GET /v1/forecast?latitude=..&longitude=..  the cached Open-Meteo response for the location, so the
+//                                              app can use the service by setting CONDITIONS_NAVIGATOR_FORECAST_URL
+//   GET /v1/catalog                            the daily conditions of every location
+//   GET /v1/history?location=..&field=..&target=..[&from=..&to=..]
+//                                              how the forecast of a field for a target time (ISO 8601)
+//                                              changed with each issue, if an archive is set
+// WebSocket (on the same port):
+//   {"type": "subscribe"}                                  the catalog now and after every refresh
+//   {"type": "forecast", "latitude": .., "longitude": ..}  the cached Open-Meteo response for the location
+//   {"type": "subscribeDeltas", "epoch": "..", "version": ..}
+//                           binary ForecastDelta messages with the changes since the version, now and after every refresh
+//   {"type": "resync", "epoch": "..", "version": .., "versions": [..]}
+//                           as subscribeDeltas, but only the changes after each location's own version
+//
+// Responses are serialised once per refresh and shared between clients. The number of sessions is
+// capped and clients that stop reading are disconnected, so memory use does not grow with slow clients.
+class ForecastService : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ForecastService(QObject* parent = nullptr);
+
+    bool listen(const QHostAddress& address, quint16 port);
+    quint16 port() const;
+
+    void setArchive(ForecastArchive* archive);
+    void setCatalog(const QList<CatalogEntry>& catalog);
+    void setMaximumConcurrentRequests(int maximumConcurrentRequests);
+    void setMaximumSessions(int maximumSessions);
+    void setModels(const QStringList& models, double ensemblePercentile);
+    void setRefreshInterval(int minutes);
+    void setUpstreamUrl(const QUrl& upstreamUrl);
+
+    quint64 getVersion() const;
+    int getSessionCount() const;
+
+    void refresh();
+
+signals:
+    void refreshed(quint64 version);
+
+private:
+    struct DailySummary
+    {
+        QDate date;
+        ConditionsClassifier::Conditions conditions = ConditionsClassifier::Conditions::Unknown;
+        float precipitation = 0.0f;
+        float windSpeed = 0.0f;
+
+        bool operator==(const DailySummary& other) const
+        {
+            return date == other.date && conditions == other.conditions &&
+                   precipitation == other.precipitation && windSpeed == other.windSpeed;
+        }
+    };
+
+    struct StoredForecast
+    {
+        QByteArray response;
+        QList<DailySummary> days;
+        QList<quint64> dayVersions;
+        quint64 version = 0;
+    };
+
+    ForecastArchive* m_archive = nullptr;
+    QList<CatalogEntry> m_catalog;
+    QByteArray m_catalogSnapshot;
+    ConditionsClassifier m_classifier;
+    QHash<QWebSocket*, quint64> m_deltaSubscribers;
+    quint64 m_epoch = 0;
+    OpenMeteoForecastSource m_forecastSource;
+    QList<StoredForecast> m_forecasts;
+    QHash<quint64, QList<int>> m_locationGrid;
+    int m_maximumConcurrentRequests = 32;
+    int m_maximumSessions = 10000;
+    QHash<const Mountain*, int> m_mountainIndices;
+    qsizetype m_nextEntry = 0;
+    QHash<const Mountain*, QByteArray> m_pendingResponses;
+    bool m_refreshChangedForecasts = false;
+    QTimer m_refreshTimer;
+    bool m_refreshing = false;
+    int m_requestsInFlight = 0;
+    QTcpServer* m_server = nullptr;
+    int m_sessionCount = 0;
+    QSet<QWebSocket*> m_subscribers;
+    quint64 m_version = 0;
+    QWebSocketServer* m_webSocketServer = nullptr;
+
+    void dispatchRequests();
+    void storeReply(Mountain* mountain, const QByteArray& jsonBytes);
+    void storeForecast(Mountain* mountain);
+    void finishRequest(Mountain* mountain);
+    void finishRefresh();
+    void rebuildCatalogSnapshot();
+    void pushDeltas();
+    ForecastDelta::Message createDelta(quint64 fromVersion, const QList<quint64>* locationVersions) const;
+
+    int findLocation(double latitude, double longitude) const;
+    static quint64 gridKey(qint64 latitudeCell, qint64 longitudeCell);
+
+    void handleNewConnections();
+    void handleHttpData(QTcpSocket* socket);
+    void handleNewWebSocketConnections();
+    void handleWebSocketMessage(QWebSocket* webSocket, const QString& message);
+    QByteArray forecastResponseFor(double latitude, double longitude, int* statusCode) const;
+    QByteArray historyResponseFor(const QUrlQuery& query, int* statusCode);
+    bool hasRoomFor(QWebSocket* webSocket, qsizetype messageSize);
+};
+
+#endif // FORECASTSERVICE_H
@@ -0,0 +1,155 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastSubscription.h"
+#include "Metrics.h"
+#include "Tracer.h"
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QWebSocket>
+
+namespace
+{
+    constexpr int reconnectIntervalMilliseconds = 5000;
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ForecastSubscription::ForecastSubscription(QObject* parent) :
+    QObject{parent},
+    m_webSocket(new QWebSocket(QString(), QWebSocketProtocol::VersionLatest, this))
+{
+    connect(m_webSocket, &QWebSocket::connected, this, &ForecastSubscription::subscribe);
+    connect(m_webSocket, &QWebSocket::binaryMessageReceived, this, &ForecastSubscription::handleMessage);
+    connect(m_webSocket, &QWebSocket::disconnected, this, [this](){
+        m_reconnectTimer.start();
+    });
+    connect(m_webSocket, &QWebSocket::errorOccurred, this, [this](QAbstractSocket::SocketError){
+        qWarning() << "Forecast updates unavailable:" << m_webSocket->errorString();
+        m_reconnectTimer.start();
+    });
+
+    m_reconnectTimer.setSingleShot(true);
+    m_reconnectTimer.setInterval(reconnectIntervalMilliseconds);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, [this](){
+        m_webSocket->open(m_url);
+    });
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+quint64 ForecastSubscription::getVersion() const
+{
+    return m_version;
+}
+
+quint32 ForecastSubscription::getLocationCount() const
+{
+    return m_locationCount;
+}
+
+void ForecastSubscription::setLocationCount(quint32 locationCount)
+{
+    m_locationCount = locationCount;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+QUrl ForecastSubscription::webSocketUrlFor(const QUrl& forecastUrl)
+{
+    // The service accepts WebSocket connections on the same port as its HTTP endpoints.
+    QUrl url = forecastUrl.adjusted(QUrl::RemovePath | QUrl::RemoveQuery);
+    url.setScheme(forecastUrl.scheme() == "https" ? "wss" : "ws");
+    url.setPath("/");
+    return url;
+}
+
+void ForecastSubscription::start(const QUrl& url)
+{
+    m_url = url;
+    m_webSocket->open(m_url);
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+void ForecastSubscription::subscribe()
+{
+    QJsonObject request{
+        {"type", "subscribeDeltas"},
+        {"epoch", QString::number(m_epoch)},
+        {"version", static_cast<qint64>(m_version)}
+    };
+
+    // After a reconnect the service is told what is known of each location, in case some
+    // updates were only partly received.
+    if (m_epoch != 0)
+    {
+        QJsonArray versions;
+        for (quint64 version : std::as_const(m_locationVersions))
+            versions.append(static_cast<qint64>(version));
+        request.insert("type", "resync");
+        request.insert("versions", versions);
+    }
+
+    m_webSocket->sendTextMessage(QString::fromUtf8(QJsonDocument(request).toJson(QJsonDocument::Compact)));
+}
+
+void ForecastSubscription::handleMessage(const QByteArray& bytes)
+{
+    TRACE_SCOPE("decodeForecastDelta");
+
+    ForecastDelta::Message message;
+    if (!ForecastDelta::decode(bytes, &message))
+    {
+        qWarning() << "Ignoring a malformed forecast update of" << bytes.size() << "bytes";
+        Metrics::instance().recordFailure("DeltaDecodeError");
+        return;
+    }
+
+    Metrics::instance().recordPushReceived(bytes.size(), message.isSnapshot());
+
+    // The count comes straight off the network, so it is checked before the versions are sized by it.
+    if (message.locationCount != m_locationCount)
+    {
+        qWarning() << "Ignoring forecast updates for a catalog of" << message.locationCount << "locations";
+        Metrics::instance().recordFailure("DeltaCatalogMismatch");
+        return;
+    }
+
+    if (message.isSnapshot() || message.epoch != m_epoch)
+        m_locationVersions = QList<quint64>(message.locationCount, 0);
+    else if (m_locationVersions.size() != static_cast<qsizetype>(message.locationCount))
+        m_locationVersions.resize(message.locationCount);
+
+    for (const ForecastDelta::LocationChange& change : std::as_const(message.changes))
+    {
+        if (change.location < static_cast<quint32>(m_locationVersions.size()))
+            m_locationVersions[change.location] = change.version;
+    }
+
+    m_epoch = message.epoch;
+    m_version = message.toVersion;
+
+    emit changesReceived(message.changes, message.isSnapshot());
+}
@@ -0,0 +1,61 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTSUBSCRIPTION_H
+#define FORECASTSUBSCRIPTION_H
+
+#include <QList>
+#include <QObject>
+#include <QTimer>
+#include <QUrl>
+
+#include "ForecastDelta.h"
+
+class QWebSocket;
+
+// Subscribes to the forecast changes pushed by a ForecastService and keeps track of the version of
+// every location, so that after a reconnect only what was missed is sent again.
+class ForecastSubscription : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ForecastSubscription(QObject* parent = nullptr);
+
+    static QUrl webSocketUrlFor(const QUrl& forecastUrl);
+
+    void start(const QUrl& url);
+
+    quint64 getVersion() const;
+    // The number of locations in the catalog, which must be the service's. Updates for a catalog of
+    // another size are ignored before anything is allocated for them.
+    quint32 getLocationCount() const;
+    void setLocationCount(quint32 locationCount);
+
+signals:
+    void changesReceived(const QList<ForecastDelta::LocationChange>& changes, bool isSnapshot);
+
+private:
+    quint64 m_epoch = 0;
+    quint32 m_locationCount = 0;
+    QList<quint64> m_locationVersions;
+    QTimer m_reconnectTimer;
+    QUrl m_url;
+    quint64 m_version = 0;
+    QWebSocket* m_webSocket = nullptr;
+
+    void subscribe();
+    void handleMessage(const QByteArray& bytes);
+};
+
+#endif // FORECASTSUBSCRIPTION_H
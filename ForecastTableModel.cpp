@@ -0,0 +1,198 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastTableModel.h"
+#include "DetailViewCache.h"
+#include "Mountain.h"
+
+#include <algorithm>
+#include <utility>
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ForecastTableModel::ForecastTableModel(QObject* parent) :
+    QAbstractTableModel{parent}
+{
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+void ForecastTableModel::setDetailViewCache(DetailViewCache* cache)
+{
+    m_detailViewCache = cache;
+}
+
+Mountain* ForecastTableModel::mountain() const
+{
+    return m_mountain;
+}
+
+void ForecastTableModel::setMountain(Mountain* mountain)
+{
+    if (mountain == m_mountain)
+        return;
+
+    disconnect(m_dailyForecastConnection);
+
+    beginResetModel();
+    m_mountain = mountain;
+    m_rows = rowsForCurrentMountain();
+    endResetModel();
+
+    // Only the daily values are shown, so forecasts that change nothing but the hourly series are ignored.
+    if (m_mountain)
+        m_dailyForecastConnection = connect(m_mountain, &Mountain::dailyForecastChanged, this, &ForecastTableModel::refresh);
+}
+
+// ------------------------------------- //
+//           Model Implementation        //
+// ------------------------------------- //
+
+int ForecastTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : NumberOfColumns;
+}
+
+int ForecastTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+QVariant ForecastTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole || index.row() >= m_rows.size())
+        return {};
+
+    return cellValue(m_rows.at(index.row()), index.column());
+}
+
+QVariant ForecastTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section)
+    {
+    case DayColumn:
+        return QString{"Day"};
+    case ConditionColumn:
+        return QString{"Condition"};
+    case PrecipitationColumn:
+        return QString{"Precipitation (mm)"};
+    case WindColumn:
+        return QString{"Wind Speed (km/h)"};
+    case WindDirectionColumn:
+        return QString{"Wind Dir. (from)"};
+    }
+    return {};
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+QList<ForecastTableRow> ForecastTableModel::createRows(const Mountain* mountain)
+{
+    if (mountain == nullptr)
+        return {};
+
+    // Every column is read from the same generation of the forecast.
+    const std::shared_ptr<const MountainForecast> forecast = mountain->getForecast();
+    const QList<QString> days = forecast->getDays();
+    const QList<QString> conditions = forecast->getDailyWeatherConditions();
+    const QList<double> precipitation = forecast->getDailyPrecipitation();
+    const QList<double> windSpeed = forecast->getDailyWindSpeed();
+    const QList<double> windGusts = forecast->getDailyWindGusts();
+    const QList<QString> windDirection = forecast->getDailyWindDirection();
+
+    const qsizetype numberOfRows = std::min({days.size(), conditions.size(), precipitation.size(),
+                                             windSpeed.size(), windGusts.size(), windDirection.size()});
+
+    QList<ForecastTableRow> rows;
+    rows.reserve(numberOfRows);
+    for (qsizetype index = 0; index < numberOfRows; ++index)
+        rows.append({days.at(index), conditions.at(index), precipitation.at(index),
+                     windSpeed.at(index), windGusts.at(index), windDirection.at(index)});
+    return rows;
+}
+
+QVariant ForecastTableModel::cellValue(const ForecastTableRow& row, int column)
+{
+    switch (column)
+    {
+    case DayColumn:
+        return row.day;
+    case ConditionColumn:
+        return row.condition;
+    case PrecipitationColumn:
+        return row.precipitation;
+    case WindColumn:
+        return QString{"%1 (%2)"}.arg(QString::number(row.windSpeed), QString::number(row.windGusts));
+    case WindDirectionColumn:
+        return row.windDirection;
+    }
+    return {};
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+QList<ForecastTableRow> ForecastTableModel::rowsForCurrentMountain()
+{
+    if (m_detailViewCache)
+    {
+        if (const PreparedDetailView* preparedView = m_detailViewCache->detailView(m_mountain))
+            return preparedView->rows;
+    }
+    return createRows(m_mountain);
+}
+
+void ForecastTableModel::refresh()
+{
+    QList<ForecastTableRow> newRows = rowsForCurrentMountain();
+
+    if (newRows.size() != m_rows.size())
+    {
+        beginResetModel();
+        m_rows = std::move(newRows);
+        endResetModel();
+        return;
+    }
+
+    // Same shape, so only notify the views about the cells whose displayed value has changed.
+    // Adjacent changed cells in a row are reported as a single range.
+    const QList<ForecastTableRow> oldRows = std::exchange(m_rows, std::move(newRows));
+    for (int row = 0; row < m_rows.size(); ++row)
+    {
+        int firstChangedColumn = -1;
+        for (int column = 0; column <= NumberOfColumns; ++column)
+        {
+            const bool changed = column < NumberOfColumns &&
+                                 cellValue(oldRows.at(row), column) != cellValue(m_rows.at(row), column);
+            if (changed && firstChangedColumn < 0)
+            {
+                firstChangedColumn = column;
+            }
+            else if (!changed && firstChangedColumn >= 0)
+            {
+                emit dataChanged(index(row, firstChangedColumn), index(row, column - 1), {Qt::DisplayRole});
+                firstChangedColumn = -1;
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTTABLEMODEL_H
+#define FORECASTTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QList>
+#include <QString>
+
+class DetailViewCache;
+class Mountain;
+
+struct ForecastTableRow
+{
+    QString day;
+    QString condition;
+    double precipitation = 0.0;
+    double windSpeed = 0.0;
+    double windGusts = 0.0;
+    QString windDirection;
+};
+
+// Daily forecast rows for the selected mountain, shown in the table of the forecast drawer.
+class ForecastTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column
+    {
+        DayColumn,
+        ConditionColumn,
+        PrecipitationColumn,
+        WindColumn,
+        WindDirectionColumn,
+        NumberOfColumns
+    };
+
+    explicit ForecastTableModel(QObject* parent = nullptr);
+
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    void setDetailViewCache(DetailViewCache* cache);
+    Mountain* mountain() const;
+    void setMountain(Mountain* mountain);
+
+    static QList<ForecastTableRow> createRows(const Mountain* mountain);
+    static QVariant cellValue(const ForecastTableRow& row, int column);
+
+private:
+    QList<ForecastTableRow> rowsForCurrentMountain();
+    void refresh();
+
+    DetailViewCache* m_detailViewCache = nullptr;
+    Mountain* m_mountain = nullptr;
+    QMetaObject::Connection m_dailyForecastConnection;
+    QList<ForecastTableRow> m_rows;
+};
+
+#endif // FORECASTTABLEMODEL_H
@@ -0,0 +1,70 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastTiering.h"
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ForecastTiering::ForecastTiering(qsizetype fullResolutionEntries, int coarseFactor) :
+    m_fullResolutionEntries(std::max<qsizetype>(fullResolutionEntries, 0)),
+    m_coarseFactor(std::max(coarseFactor, 1))
+{
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+qsizetype ForecastTiering::getFullResolutionEntries() const
+{
+    return m_fullResolutionEntries;
+}
+
+int ForecastTiering::getCoarseFactor() const
+{
+    return m_coarseFactor;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+qsizetype ForecastTiering::tieredSize(qsizetype size) const
+{
+    if (size <= m_fullResolutionEntries)
+        return size;
+    return m_fullResolutionEntries + (size - m_fullResolutionEntries + m_coarseFactor - 1) / m_coarseFactor;
+}
+
+TimeAxis ForecastTiering::apply(const TimeAxis& axis) const
+{
+    if (axis.size() <= m_fullResolutionEntries)
+        return axis;
+
+    // Each coarse entry is placed at the first hour it covers, as the hourly ones are.
+    return TimeAxis(axis.getOriginSeconds(), axis.getStepSeconds(), tieredSize(axis.size()), axis.getUtcOffsetSeconds(),
+                    m_fullResolutionEntries, axis.getStepSeconds() * m_coarseFactor);
+}
+
+ForecastEnsemble::Statistics ForecastTiering::apply(const ForecastEnsemble::Statistics& statistics, Reduction reduction) const
+{
+    ForecastEnsemble::Statistics tiered;
+    tiered.mean = apply(statistics.mean, Reduction::Mean);
+    tiered.minimum = apply(statistics.minimum, Reduction::Minimum);
+    tiered.maximum = apply(statistics.maximum, Reduction::Maximum);
+    tiered.spread = apply(statistics.spread, Reduction::Mean);
+    tiered.percentile = apply(statistics.percentile, reduction);
+    return tiered;
+}
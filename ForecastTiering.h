@@ -0,0 +1,126 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTTIERING_H
+#define FORECASTTIERING_H
+
+#include <QList>
+#include <QVariant>
+
+#include "ForecastEnsemble.h"
+#include "TimeAxis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+// Keeps the first hours of a forecast at full resolution and reduces the rest to one entry per
+// several hours, so that a longer horizon adds a fraction of the memory it would if every hour were
+// kept. Past the full resolution hours the storage still grows linearly with the horizon, at the
+// fraction given by the coarse factor: a third with the default of 3 hour steps. The near days, where
+// the detail is worth having, are unaffected. The daily values are worked out from the full hourly
+// series before they are tiered.
+class ForecastTiering
+{
+public:
+    // Most series are averaged, which keeps rates such as precipitation in the same units. Those where
+    // the worst hour matters, such as visibility, keep the lowest value instead.
+    enum class Reduction
+    {
+        Mean,
+        Minimum,
+        Maximum
+    };
+
+    ForecastTiering() = default;
+    ForecastTiering(qsizetype fullResolutionEntries, int coarseFactor);
+
+    qsizetype getFullResolutionEntries() const;
+    int getCoarseFactor() const;
+
+    // The number of entries a series of the given length is reduced to.
+    qsizetype tieredSize(qsizetype size) const;
+    TimeAxis apply(const TimeAxis& axis) const;
+    ForecastEnsemble::Statistics apply(const ForecastEnsemble::Statistics& statistics, Reduction reduction) const;
+
+    // Writes tieredSize(size) entries. A last coarse entry with fewer hours than the others reduces
+    // the hours there are. Values that are not numbers are left out, unless every one of them is.
+    template<typename T>
+    void apply(const T* values, qsizetype size, T* tiered, Reduction reduction) const
+    {
+        reduce(size, tiered, reduction, [values](qsizetype index){ return values[index]; });
+    }
+
+    // The same, converting the values as they are read, so that a decoded response is tiered without
+    // first being copied into a typed list.
+    template<typename T>
+    void apply(const QVariantList& values, T* tiered, Reduction reduction) const
+    {
+        reduce(values.size(), tiered, reduction, [&values](qsizetype index){ return values.at(index).value<T>(); });
+    }
+
+    template<typename T>
+    QList<T> apply(const QList<T>& values, Reduction reduction) const
+    {
+        QList<T> tiered(tieredSize(values.size()));
+        apply(values.constData(), values.size(), tiered.data(), reduction);
+        return tiered;
+    }
+
+private:
+    template<typename T, typename ValueAt>
+    void reduce(qsizetype size, T* tiered, Reduction reduction, ValueAt valueAt) const
+    {
+        const qsizetype fullResolution = std::min(size, m_fullResolutionEntries);
+        for (qsizetype index = 0; index < fullResolution; ++index)
+            tiered[index] = valueAt(index);
+
+        qsizetype output = fullResolution;
+        for (qsizetype first = fullResolution; first < size; first += m_coarseFactor, ++output)
+        {
+            const qsizetype last = std::min(first + m_coarseFactor, size);
+            double total = 0.0;
+            int count = 0;
+            const T firstValue = valueAt(first);
+            T extreme = firstValue;
+            for (qsizetype index = first; index < last; ++index)
+            {
+                const T value = valueAt(index);
+                if constexpr (std::is_floating_point_v<T>)
+                {
+                    if (std::isnan(value))
+                        continue;
+                    if (std::isnan(extreme))
+                        extreme = value;
+                }
+                total += value;
+                ++count;
+                extreme = reduction == Reduction::Minimum ? std::min(extreme, value) : std::max(extreme, value);
+            }
+
+            if (reduction != Reduction::Mean)
+                tiered[output] = extreme;
+            else if constexpr (std::is_floating_point_v<T>)
+                tiered[output] = count > 0 ? static_cast<T>(total / count) : firstValue;
+            else
+                tiered[output] = static_cast<T>(std::lround(total / count));
+        }
+    }
+
+    // Without a tiering every entry is kept.
+    qsizetype m_fullResolutionEntries = std::numeric_limits<qsizetype>::max();
+    int m_coarseFactor = 1;
+};
+
+#endif // FORECASTTIERING_H
@@ -0,0 +1,354 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastViewportLoader.h"
+#include "ForecastBufferPool.h"
+#include "Mountain.h"
+#include "MountainForecast.h"
+#include "Tracer.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace
+{
+    // Enough for several thousand tiered 16 day forecasts.
+    constexpr qint64 defaultMemoryBudgetInBytes = 32 * 1024 * 1024;
+    // Used until the first forecast has been loaded and its actual size is known.
+    constexpr qint64 initialForecastSizeInBytes = 8 * 1024;
+    constexpr int planIntervalInMilliseconds = 200;
+
+    // The margin loaded all round the viewport, and the further margin on the sides it is moving
+    // towards, as fractions of its width and height.
+    constexpr double prefetchMargin = 0.25;
+    constexpr double panPrefetchMargin = 0.5;
+
+    constexpr int numberOfCellColumns = 360;
+    constexpr int numberOfCellRows = 180;
+
+    int cellColumn(double longitude)
+    {
+        return std::clamp(static_cast<int>(std::floor(longitude)) + 180, 0, numberOfCellColumns - 1);
+    }
+
+    int cellRow(double latitude)
+    {
+        return std::clamp(static_cast<int>(std::floor(latitude)) + 90, 0, numberOfCellRows - 1);
+    }
+
+    quint32 cellKey(int column, int row)
+    {
+        return static_cast<quint32>(row * numberOfCellColumns + column);
+    }
+
+    QPointF position(const Mountain* mountain)
+    {
+        return QPointF(mountain->getLongitude(), mountain->getLatitude());
+    }
+
+    // Good enough for ordering by distance. A degree of longitude shrinks towards the poles.
+    double squaredDistance(const QPointF& first, const QPointF& second)
+    {
+        const double deltaLongitude = (second.x() - first.x()) * std::cos(qDegreesToRadians(first.y()));
+        const double deltaLatitude = second.y() - first.y();
+        return deltaLongitude * deltaLongitude + deltaLatitude * deltaLatitude;
+    }
+
+    void sortByDistance(QList<std::pair<double, Mountain*>>* mountains)
+    {
+        std::sort(mountains->begin(), mountains->end(),
+                  [](const auto& first, const auto& second) { return first.first < second.first; });
+    }
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+ForecastViewportLoader::ForecastViewportLoader(QObject* parent) :
+    QObject{parent},
+    m_memoryBudget(defaultMemoryBudgetInBytes)
+{
+    m_planTimer.setSingleShot(true);
+    m_planTimer.setInterval(planIntervalInMilliseconds);
+    connect(&m_planTimer, &QTimer::timeout, this, &ForecastViewportLoader::planLoading);
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+void ForecastViewportLoader::setBufferPool(ForecastBufferPool* bufferPool)
+{
+    m_bufferPool = bufferPool;
+}
+
+qint64 ForecastViewportLoader::getMemoryBudget() const
+{
+    return m_memoryBudget;
+}
+
+void ForecastViewportLoader::setMemoryBudget(qint64 memoryBudget)
+{
+    m_memoryBudget = memoryBudget;
+}
+
+QRectF ForecastViewportLoader::getViewport() const
+{
+    return m_viewport;
+}
+
+void ForecastViewportLoader::setViewport(const QRectF& viewport)
+{
+    m_viewport = viewport.normalized();
+    if (!m_planTimer.isActive())
+        m_planTimer.start();
+}
+
+void ForecastViewportLoader::setMountains(const QList<Mountain*>& mountains)
+{
+    for (Mountain* mountain : mountains)
+    {
+        m_cells[cellKey(cellColumn(mountain->getLongitude()), cellRow(mountain->getLatitude()))].append(mountain);
+
+        // A mountain may already have a forecast, for example from a snapshot.
+        const std::shared_ptr<const MountainForecast> forecast = mountain->getForecast();
+        if (!forecast->getHourlyTimeAxis().isEmpty())
+        {
+            m_loaded.insert(mountain, forecast->memoryFootprint());
+            m_loadedBytes += m_loaded.value(mountain);
+        }
+
+        connect(mountain, &Mountain::forecastUpdated, this, [this, mountain]()
+        {
+            forecastUpdated(mountain);
+        });
+    }
+}
+
+void ForecastViewportLoader::setSelectedMountain(Mountain* mountain)
+{
+    m_selectedMountain = mountain;
+}
+
+bool ForecastViewportLoader::isLoaded(Mountain* mountain) const
+{
+    return m_loaded.contains(mountain);
+}
+
+bool ForecastViewportLoader::isPending(Mountain* mountain) const
+{
+    return m_pending.contains(mountain);
+}
+
+QList<Mountain*> ForecastViewportLoader::loadedMountains() const
+{
+    return m_loaded.keys();
+}
+
+int ForecastViewportLoader::loadedCount() const
+{
+    return static_cast<int>(m_loaded.size());
+}
+
+int ForecastViewportLoader::pendingCount() const
+{
+    return static_cast<int>(m_pending.size());
+}
+
+qint64 ForecastViewportLoader::memoryBytes() const
+{
+    return m_loadedBytes;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+QList<Mountain*> ForecastViewportLoader::mountainsWithin(const QRectF& area) const
+{
+    QList<Mountain*> mountains;
+    const int lastColumn = cellColumn(area.right());
+    const int lastRow = cellRow(area.bottom());
+    for (int row = cellRow(area.top()); row <= lastRow; ++row)
+    {
+        for (int column = cellColumn(area.left()); column <= lastColumn; ++column)
+        {
+            const auto cell = m_cells.constFind(cellKey(column, row));
+            if (cell == m_cells.cend())
+                continue;
+
+            for (Mountain* mountain : *cell)
+            {
+                if (area.contains(position(mountain)))
+                    mountains.append(mountain);
+            }
+        }
+    }
+    return mountains;
+}
+
+void ForecastViewportLoader::loadFailed(Mountain* mountain)
+{
+    // It is requested again the next time the map moves.
+    if (m_pending.remove(mountain))
+        emit statisticsChanged();
+}
+
+void ForecastViewportLoader::planLoading()
+{
+    TRACE_SCOPE("planViewportLoading");
+    m_planTimer.stop();
+
+    if (m_viewport.isNull())
+        return;
+
+    const QPointF panDirection = m_plannedViewport.isNull() ? QPointF() : m_viewport.center() - m_plannedViewport.center();
+    m_plannedViewport = m_viewport;
+
+    const QRectF area = prefetchArea(m_viewport, panDirection);
+    const QPointF centre = m_viewport.center();
+
+    // Visible mountains are loaded before the margin, and each nearest the centre first.
+    QList<std::pair<double, Mountain*>> visible;
+    QList<std::pair<double, Mountain*>> margin;
+    for (Mountain* mountain : mountainsWithin(area))
+    {
+        if (m_loaded.contains(mountain) || m_pending.contains(mountain))
+            continue;
+
+        const QPointF mountainPosition = position(mountain);
+        (m_viewport.contains(mountainPosition) ? visible : margin).append({squaredDistance(centre, mountainPosition), mountain});
+    }
+    sortByDistance(&visible);
+    sortByDistance(&margin);
+
+    const qint64 forecastBytes = estimatedForecastBytes();
+    evict((visible.size() + margin.size() + m_pending.size()) * forecastBytes, area);
+
+    // When even the viewport holds more mountains than the budget allows, those farthest from the
+    // centre stay unloaded until the map is zoomed in.
+    qint64 projectedBytes = m_loadedBytes + m_pending.size() * forecastBytes;
+    for (const QList<std::pair<double, Mountain*>>* mountains : {&visible, &margin})
+    {
+        for (const auto& [distance, mountain] : *mountains)
+        {
+            if (projectedBytes + forecastBytes > m_memoryBudget)
+                break;
+
+            projectedBytes += forecastBytes;
+            m_pending.insert(mountain);
+            emit loadRequested(mountain);
+        }
+    }
+
+    emit statisticsChanged();
+}
+
+void ForecastViewportLoader::reload()
+{
+    for (auto loaded = m_loaded.cbegin(); loaded != m_loaded.cend(); ++loaded)
+    {
+        if (m_pending.contains(loaded.key()))
+            continue;
+
+        m_pending.insert(loaded.key());
+        emit loadRequested(loaded.key());
+    }
+
+    planLoading();
+}
+
+QRectF ForecastViewportLoader::prefetchArea(const QRectF& viewport, const QPointF& panDirection)
+{
+    const double marginWidth = viewport.width() * prefetchMargin;
+    const double marginHeight = viewport.height() * prefetchMargin;
+    QRectF area = viewport.adjusted(-marginWidth, -marginHeight, marginWidth, marginHeight);
+
+    const double panWidth = viewport.width() * panPrefetchMargin;
+    const double panHeight = viewport.height() * panPrefetchMargin;
+    if (panDirection.x() > 0)
+        area.setRight(area.right() + panWidth);
+    else if (panDirection.x() < 0)
+        area.setLeft(area.left() - panWidth);
+
+    if (panDirection.y() > 0)
+        area.setBottom(area.bottom() + panHeight);
+    else if (panDirection.y() < 0)
+        area.setTop(area.top() - panHeight);
+
+    return area;
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+qint64 ForecastViewportLoader::estimatedForecastBytes() const
+{
+    return m_loaded.isEmpty() ? initialForecastSizeInBytes : m_loadedBytes / m_loaded.size();
+}
+
+void ForecastViewportLoader::evict(qint64 bytesNeeded, const QRectF& keepArea)
+{
+    const qint64 targetBytes = m_memoryBudget - bytesNeeded;
+    if (m_loadedBytes <= targetBytes)
+        return;
+
+    const QPointF centre = keepArea.center();
+    QList<std::pair<double, Mountain*>> candidates;
+    for (auto loaded = m_loaded.cbegin(); loaded != m_loaded.cend(); ++loaded)
+    {
+        Mountain* const mountain = loaded.key();
+        if (mountain != m_selectedMountain && !m_pending.contains(mountain) && !keepArea.contains(position(mountain)))
+            candidates.append({squaredDistance(centre, position(mountain)), mountain});
+    }
+    sortByDistance(&candidates);
+
+    while (m_loadedBytes > targetBytes && !candidates.isEmpty())
+    {
+        Mountain* const mountain = candidates.takeLast().second;
+        m_loadedBytes -= m_loaded.take(mountain);
+
+        // Readers still holding the dropped generation keep it alive until they have finished with it,
+        // and only then is it reused by the pool.
+        std::shared_ptr<const MountainForecast> evicted = mountain->publishForecast(std::make_shared<MountainForecast>());
+        if (m_bufferPool)
+            m_bufferPool->recycle(std::move(evicted));
+        emit forecastEvicted(mountain);
+    }
+}
+
+void ForecastViewportLoader::forecastUpdated(Mountain* mountain)
+{
+    m_pending.remove(mountain);
+
+    const std::shared_ptr<const MountainForecast> forecast = mountain->getForecast();
+    if (forecast->getHourlyTimeAxis().isEmpty())
+    {
+        m_loadedBytes -= m_loaded.take(mountain);
+        emit statisticsChanged();
+        return;
+    }
+
+    const qsizetype forecastBytes = forecast->memoryFootprint();
+    m_loadedBytes += forecastBytes - m_loaded.value(mountain);
+    m_loaded.insert(mountain, forecastBytes);
+
+    emit forecastLoaded(mountain);
+    emit statisticsChanged();
+}
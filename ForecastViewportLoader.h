@@ -0,0 +1,99 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FORECASTVIEWPORTLOADER_H
+#define FORECASTVIEWPORTLOADER_H
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QRectF>
+#include <QSet>
+#include <QTimer>
+
+class ForecastBufferPool;
+class Mountain;
+
+// Decides which forecasts to load from the part of the map that is visible, so that a catalog of
+// tens of thousands of mountains costs about as much as the few hundred on screen. Viewports are
+// rectangles of longitude (x) and latitude (y). A margin around the viewport is prefetched, wider
+// on the side the map is being panned towards. Once the loaded forecasts exceed the memory budget,
+// those of mountains outside the margin are dropped, farthest first, apart from the selected mountain
+// and those still loading. A mountain whose forecast has not been loaded, or has been dropped, has an
+// empty forecast.
+class ForecastViewportLoader : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int loadedCount READ loadedCount NOTIFY statisticsChanged)
+    Q_PROPERTY(int pendingCount READ pendingCount NOTIFY statisticsChanged)
+    Q_PROPERTY(qint64 memoryBytes READ memoryBytes NOTIFY statisticsChanged)
+
+public:
+    explicit ForecastViewportLoader(QObject* parent = nullptr);
+
+    // Dropped forecasts are returned to the pool, so that loading them again reuses their storage. The
+    // loader does not take ownership of it.
+    void setBufferPool(ForecastBufferPool* bufferPool);
+    qint64 getMemoryBudget() const;
+    void setMemoryBudget(qint64 memoryBudget);
+    QRectF getViewport() const;
+    // The map reports a new viewport for every frame while it moves, so loading is planned at most
+    // a few times a second.
+    void setViewport(const QRectF& viewport);
+    void setMountains(const QList<Mountain*>& mountains);
+    // The selected mountain's forecast is shown in the drawer, so it is kept wherever the map is.
+    void setSelectedMountain(Mountain* mountain);
+
+    bool isLoaded(Mountain* mountain) const;
+    bool isPending(Mountain* mountain) const;
+    QList<Mountain*> loadedMountains() const;
+    QList<Mountain*> mountainsWithin(const QRectF& area) const;
+    int loadedCount() const;
+    int pendingCount() const;
+    qint64 memoryBytes() const;
+
+    void loadFailed(Mountain* mountain);
+    // Plans loading for the current viewport without waiting for it to settle.
+    void planLoading();
+    // Requests every loaded forecast again, for when the source of the forecasts has restarted.
+    void reload();
+
+    static QRectF prefetchArea(const QRectF& viewport, const QPointF& panDirection);
+
+signals:
+    void loadRequested(Mountain* mountain);
+    void forecastLoaded(Mountain* mountain);
+    void forecastEvicted(Mountain* mountain);
+    void statisticsChanged();
+
+private:
+    qint64 estimatedForecastBytes() const;
+    void evict(qint64 bytesNeeded, const QRectF& keepArea);
+    void forecastUpdated(Mountain* mountain);
+
+    ForecastBufferPool* m_bufferPool = nullptr;
+    // The mountains in each cell of a one degree grid, so a viewport only visits the cells it covers.
+    QHash<quint32, QList<Mountain*>> m_cells;
+    QHash<Mountain*, qsizetype> m_loaded;
+    qint64 m_loadedBytes = 0;
+    qint64 m_memoryBudget;
+    QSet<Mountain*> m_pending;
+    QTimer m_planTimer;
+    QRectF m_plannedViewport;
+    const Mountain* m_selectedMountain = nullptr;
+    QRectF m_viewport;
+};
+
+#endif // FORECASTVIEWPORTLOADER_H
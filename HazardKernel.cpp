@@ -0,0 +1,201 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "HazardKernel.h"
+#include "Tracer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace
+{
+    constexpr double notAvailable = std::numeric_limits<double>::quiet_NaN();
+
+    // The wind chill index used by the Met Office and others, for the temperature in degrees Celsius and
+    // the wind speed in km/h. It is only defined for temperatures up to 10 °C and winds of at least
+    // 4.8 km/h; otherwise the wind chill is the temperature.
+    constexpr double windChillMaximumTemperature = 10.0;
+    constexpr double windChillMinimumWindSpeed = 4.8;
+
+    // The cloud base rises by about 125 m for every degree between the temperature and the dewpoint.
+    constexpr double cloudBaseMetresPerDegree = 125.0;
+
+    double toDouble(double value)
+    {
+        return value;
+    }
+
+    double toDouble(const QVariant& value)
+    {
+        return value.isNull() ? notAvailable : value.toDouble();
+    }
+
+    // Appends the series, padded with NaN to the number of hours, and returns whether it had any values.
+    template<typename T>
+    bool appendPadded(QList<double>* batchSeries, const QList<T>& series, qsizetype numberOfHours)
+    {
+        const qsizetype start = batchSeries->size();
+        const qsizetype numberOfValues = std::min(series.size(), numberOfHours);
+        batchSeries->resize(start + numberOfHours);
+        double* const data = batchSeries->data() + start;
+        std::transform(series.constBegin(), series.constBegin() + numberOfValues, data, [](const T& value){ return toDouble(value); });
+        std::fill(data + numberOfValues, data + numberOfHours, notAvailable);
+        return numberOfValues > 0;
+    }
+
+    template<typename T>
+    void appendSeries(HazardKernel::Batch* batch, double summitElevation, qsizetype numberOfHours,
+                      const QList<T>& temperature, const QList<T>& dewpoint, const QList<T>& windSpeed,
+                      const QList<T>& freezingLevel, const QList<T>& lowCloudCover)
+    {
+        batch->locationStarts.append(batch->numberOfHours());
+        batch->summitElevation.insert(batch->summitElevation.size(), numberOfHours, summitElevation);
+
+        const bool hasTemperature = appendPadded(&batch->temperature, temperature, numberOfHours);
+        const bool hasDewpoint = appendPadded(&batch->dewpoint, dewpoint, numberOfHours);
+        const bool hasWindSpeed = appendPadded(&batch->windSpeed, windSpeed, numberOfHours);
+        const bool hasFreezingLevel = appendPadded(&batch->freezingLevel, freezingLevel, numberOfHours);
+        const bool hasLowCloudCover = appendPadded(&batch->lowCloudCover, lowCloudCover, numberOfHours);
+
+        batch->hasWindChillInputs |= hasTemperature && hasWindSpeed;
+        batch->hasFreezingLevelInputs |= hasFreezingLevel;
+        batch->hasCloudInputs |= hasTemperature && hasDewpoint && hasLowCloudCover;
+    }
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+void HazardKernel::Batch::appendLocation(double summitElevation, qsizetype numberOfHours,
+                                         const QList<double>& temperature, const QList<double>& dewpoint,
+                                         const QList<double>& windSpeed, const QList<double>& freezingLevel,
+                                         const QList<double>& lowCloudCover)
+{
+    appendSeries(this, summitElevation, numberOfHours, temperature, dewpoint, windSpeed, freezingLevel, lowCloudCover);
+}
+
+void HazardKernel::Batch::appendLocation(double summitElevation, qsizetype numberOfHours,
+                                         const QVariantList& temperature, const QVariantList& dewpoint,
+                                         const QVariantList& windSpeed, const QVariantList& freezingLevel,
+                                         const QVariantList& lowCloudCover)
+{
+    appendSeries(this, summitElevation, numberOfHours, temperature, dewpoint, windSpeed, freezingLevel, lowCloudCover);
+}
+
+void HazardKernel::Batch::clear()
+{
+    // Keeps the storage for the next batch.
+    for (QList<double>* series : {&summitElevation, &temperature, &dewpoint, &windSpeed, &freezingLevel, &lowCloudCover})
+        series->resize(0);
+    locationStarts.resize(0);
+    hasWindChillInputs = false;
+    hasFreezingLevelInputs = false;
+    hasCloudInputs = false;
+}
+
+qsizetype HazardKernel::Batch::numberOfHours() const
+{
+    return summitElevation.size();
+}
+
+qsizetype HazardKernel::Batch::numberOfLocations() const
+{
+    return locationStarts.size();
+}
+
+qsizetype HazardKernel::Batch::numberOfHours(qsizetype location) const
+{
+    const qsizetype end = location + 1 < locationStarts.size() ? locationStarts.at(location + 1) : numberOfHours();
+    return end - locationStarts.at(location);
+}
+
+void HazardKernel::Hazards::assignLocation(const Hazards& batchHazards, const Batch& batch, qsizetype location)
+{
+    const qsizetype start = batch.locationStarts.at(location);
+    const qsizetype numberOfHours = batch.numberOfHours(location);
+    const std::pair<QList<double>*, const QList<double>*> series[] = {
+        {&windChill, &batchHazards.windChill},
+        {&freezingLevelMargin, &batchHazards.freezingLevelMargin},
+        {&cloudBaseMargin, &batchHazards.cloudBaseMargin},
+        {&summitInCloud, &batchHazards.summitInCloud}
+    };
+    for (const auto& [locationSeries, batchSeries] : series)
+    {
+        // A series the batch has no inputs for stays empty, as it would for a batch of this location.
+        const qsizetype size = batchSeries->isEmpty() ? 0 : numberOfHours;
+        locationSeries->resize(size);
+        std::copy_n(batchSeries->constData() + start, size, locationSeries->data());
+    }
+}
+
+void HazardKernel::run(const Batch& batch, Hazards* hazards)
+{
+    TRACE_SCOPE("deriveHazards");
+
+    const qsizetype numberOfHours = batch.numberOfHours();
+    hazards->windChill.resize(batch.hasWindChillInputs ? numberOfHours : 0);
+    hazards->freezingLevelMargin.resize(batch.hasFreezingLevelInputs ? numberOfHours : 0);
+    hazards->cloudBaseMargin.resize(batch.hasCloudInputs ? numberOfHours : 0);
+    hazards->summitInCloud.resize(batch.hasCloudInputs ? numberOfHours : 0);
+
+    const double* const summitElevation = batch.summitElevation.constData();
+    const double* const temperature = batch.temperature.constData();
+    const double* const dewpoint = batch.dewpoint.constData();
+    const double* const windSpeed = batch.windSpeed.constData();
+    const double* const freezingLevel = batch.freezingLevel.constData();
+    const double* const lowCloudCover = batch.lowCloudCover.constData();
+
+    if (batch.hasWindChillInputs)
+    {
+        double* const windChill = hazards->windChill.data();
+        for (qsizetype hour = 0; hour < numberOfHours; ++hour)
+        {
+            const double celsius = temperature[hour];
+            const double speedFactor = std::pow(windSpeed[hour], 0.16);
+            const double chill = 13.12 + 0.6215 * celsius - 11.37 * speedFactor + 0.3965 * celsius * speedFactor;
+            const bool isDefined = celsius <= windChillMaximumTemperature && windSpeed[hour] >= windChillMinimumWindSpeed;
+            windChill[hour] = isDefined ? chill : celsius;
+        }
+    }
+
+    if (batch.hasFreezingLevelInputs)
+    {
+        double* const freezingLevelMargin = hazards->freezingLevelMargin.data();
+        for (qsizetype hour = 0; hour < numberOfHours; ++hour)
+            freezingLevelMargin[hour] = freezingLevel[hour] - summitElevation[hour];
+    }
+
+    if (batch.hasCloudInputs)
+    {
+        double* const cloudBaseMargin = hazards->cloudBaseMargin.data();
+        double* const summitInCloud = hazards->summitInCloud.data();
+        for (qsizetype hour = 0; hour < numberOfHours; ++hour)
+        {
+            const double spread = temperature[hour] - dewpoint[hour];
+            // Written so that a missing temperature or dewpoint gives NaN rather than 0.
+            const double margin = cloudBaseMetresPerDegree * (spread < 0.0 ? 0.0 : spread);
+            cloudBaseMargin[hour] = margin;
+            summitInCloud[hour] = margin <= summitInCloudMargin && lowCloudCover[hour] >= summitInCloudLowCloudCover ? 1.0 : 0.0;
+        }
+    }
+}
+
+HazardKernel::Hazards HazardKernel::run(const Batch& batch)
+{
+    Hazards hazards;
+    run(batch, &hazards);
+    return hazards;
+}
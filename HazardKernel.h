@@ -0,0 +1,86 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HAZARDKERNEL_H
+#define HAZARDKERNEL_H
+
+#include <QList>
+#include <QVariant>
+
+// Derives the hazards that decide a day on the hills from the hourly forecast at summit height:
+// the wind chill, how far the freezing level is above the summit and whether the summit is in
+// cloud. Open-Meteo corrects the temperature and dewpoint to the elevation given in the request,
+// which is the summit's, so the cloud base above the summit can be estimated from the difference
+// between them. The hours of any number of locations are laid end to end and derived in a single
+// pass over flat arrays, with no branches in the loops, so that it can be vectorised.
+class HazardKernel
+{
+public:
+    // The hourly inputs of every location in the batch, one location after another. Series that a
+    // location does not have, or that are shorter than its hours, are filled with NaN.
+    struct Batch
+    {
+        QList<double> summitElevation;
+        QList<double> temperature;
+        QList<double> dewpoint;
+        QList<double> windSpeed;
+        QList<double> freezingLevel;
+        QList<double> lowCloudCover;
+        // Where the hours of each location start.
+        QList<qsizetype> locationStarts;
+        bool hasWindChillInputs = false;
+        bool hasFreezingLevelInputs = false;
+        bool hasCloudInputs = false;
+
+        void appendLocation(double summitElevation, qsizetype numberOfHours,
+                            const QList<double>& temperature, const QList<double>& dewpoint,
+                            const QList<double>& windSpeed, const QList<double>& freezingLevel,
+                            const QList<double>& lowCloudCover);
+        // The same for decoded series, which are converted as they are appended. Null values are NaN.
+        void appendLocation(double summitElevation, qsizetype numberOfHours,
+                            const QVariantList& temperature, const QVariantList& dewpoint,
+                            const QVariantList& windSpeed, const QVariantList& freezingLevel,
+                            const QVariantList& lowCloudCover);
+        void clear();
+        qsizetype numberOfHours() const;
+        qsizetype numberOfLocations() const;
+        qsizetype numberOfHours(qsizetype location) const;
+    };
+
+    // One value per hour of the batch. A series is empty if no location in the batch had its inputs.
+    struct Hazards
+    {
+        // Degrees Celsius.
+        QList<double> windChill;
+        // Metres from the summit up to the freezing level, negative when the summit is above it.
+        QList<double> freezingLevelMargin;
+        // Metres from the summit up to the estimated cloud base.
+        QList<double> cloudBaseMargin;
+        // 1 for hours in which the summit is in cloud, otherwise 0.
+        QList<double> summitInCloud;
+
+        // Copies the hours of one location from the hazards of a batch, reusing this storage.
+        void assignLocation(const Hazards& batchHazards, const Batch& batch, qsizetype location);
+    };
+
+    // Reuses the storage of the hazards from a previous run.
+    static void run(const Batch& batch, Hazards* hazards);
+    static Hazards run(const Batch& batch);
+
+    // The summit is in cloud when the cloud base is at most this far above it and there is enough
+    // low cloud for the air at the summit not to be clear.
+    static constexpr double summitInCloudMargin = 100.0;
+    static constexpr double summitInCloudLowCloudCover = 50.0;
+};
+
+#endif // HAZARDKERNEL_H
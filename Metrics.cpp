@@ -0,0 +1,368 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Metrics.h"
+
+#include <QMutexLocker>
+#include <QStringList>
+#include <QtAlgorithms>
+
+#include <cmath>
+
+namespace
+{
+    const QList<qint64> requestRoundTripBounds{10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000, 5000000, 10000000};
+    const QList<qint64> processingBounds{100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000};
+    const QList<qint64> responseBytesBounds{1024, 4096, 16384, 65536, 262144, 1048576};
+
+    void appendCounter(QByteArray& output, const char* name, const char* help, quint64 value)
+    {
+        output += QByteArray("# HELP ") + name + ' ' + help + '\n';
+        output += QByteArray("# TYPE ") + name + " counter\n";
+        output += QByteArray(name) + ' ' + QByteArray::number(value) + '\n';
+    }
+
+    void appendGauge(QByteArray& output, const char* name, const char* help, qint64 value)
+    {
+        output += QByteArray("# HELP ") + name + ' ' + help + '\n';
+        output += QByteArray("# TYPE ") + name + " gauge\n";
+        output += QByteArray(name) + ' ' + QByteArray::number(value) + '\n';
+    }
+
+    // Prometheus expects base units, so durations are converted from microseconds to seconds by the scale.
+    // The histogram cannot tell values within one of its buckets apart, so each bound is exported at the
+    // upper edge of the bucket it falls in, for which the count is exact. 100 µs becomes 103 µs, for example.
+    void appendHistogram(QByteArray& output, const char* name, const char* help, const LatencyHistogram& histogram,
+                         const QList<qint64>& bounds, double scale)
+    {
+        output += QByteArray("# HELP ") + name + ' ' + help + '\n';
+        output += QByteArray("# TYPE ") + name + " histogram\n";
+        qint64 previousEdge = -1;
+        for (qint64 bound : bounds)
+        {
+            const qint64 edge = LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(bound));
+            if (edge == previousEdge)
+                continue;
+
+            previousEdge = edge;
+            output += QByteArray(name) + "_bucket{le=\"" + QByteArray::number(edge * scale) + "\"} " +
+                      QByteArray::number(histogram.countAtOrBelow(edge)) + '\n';
+        }
+        output += QByteArray(name) + "_bucket{le=\"+Inf\"} " + QByteArray::number(histogram.count()) + '\n';
+        output += QByteArray(name) + "_sum " + QByteArray::number(histogram.sum() * scale) + '\n';
+        output += QByteArray(name) + "_count " + QByteArray::number(histogram.count()) + '\n';
+    }
+
+    double toMilliseconds(qint64 microseconds)
+    {
+        return microseconds / 1000.0;
+    }
+}
+
+// ------------------------------------- //
+//           LatencyHistogram            //
+// ------------------------------------- //
+
+void LatencyHistogram::record(qint64 value)
+{
+    value = std::max<qint64>(value, 0);
+    m_counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    qint64 currentMax = m_max.load(std::memory_order_relaxed);
+    while (value > currentMax && !m_max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (std::atomic<quint64>& count : m_counts)
+        count.store(0, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
+
+quint64 LatencyHistogram::count() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+qint64 LatencyHistogram::sum() const
+{
+    return m_sum.load(std::memory_order_relaxed);
+}
+
+qint64 LatencyHistogram::max() const
+{
+    return m_max.load(std::memory_order_relaxed);
+}
+
+qint64 LatencyHistogram::valueAtPercentile(double percentile) const
+{
+    const quint64 total = count();
+    if (total == 0)
+        return 0;
+
+    const quint64 target = std::max<quint64>(1, static_cast<quint64>(std::ceil(percentile / 100.0 * total)));
+    quint64 cumulative = 0;
+    for (int index = 0; index < BucketCount; ++index)
+    {
+        cumulative += m_counts[index].load(std::memory_order_relaxed);
+        if (cumulative >= target)
+            return std::min(bucketUpperBound(index), max());
+    }
+    return max();
+}
+
+quint64 LatencyHistogram::countAtOrBelow(qint64 value) const
+{
+    const int lastIndex = bucketIndex(value);
+    quint64 cumulative = 0;
+    for (int index = 0; index <= lastIndex; ++index)
+        cumulative += m_counts[index].load(std::memory_order_relaxed);
+    return cumulative;
+}
+
+int LatencyHistogram::bucketIndex(qint64 value)
+{
+    if (value < 2 * SubBucketCount)
+        return static_cast<int>(std::max<qint64>(value, 0));
+
+    // The highest set bit picks the power of two, the next SubBucketBits bits pick the bucket within it.
+    const int magnitude = 63 - qCountLeadingZeroBits(static_cast<quint64>(value));
+    const int shift = magnitude - SubBucketBits;
+    return shift * SubBucketCount + static_cast<int>(value >> shift);
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < 2 * SubBucketCount)
+        return index;
+
+    const int shift = index / SubBucketCount - 1;
+    const qint64 subBucket = index % SubBucketCount + SubBucketCount;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+// ------------------------------------- //
+//               Metrics                 //
+// ------------------------------------- //
+
+Metrics& Metrics::instance()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+void Metrics::requestStarted()
+{
+    m_requestsStarted.fetch_add(1, std::memory_order_relaxed);
+    m_requestsInFlight.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::requestFinished(qint64 roundTripMicroseconds, qint64 bytesReceived)
+{
+    m_requestsInFlight.fetch_sub(1, std::memory_order_relaxed);
+    m_requestsSucceeded.fetch_add(1, std::memory_order_relaxed);
+    m_bytesReceived.fetch_add(bytesReceived, std::memory_order_relaxed);
+    m_requestRoundTrip.record(roundTripMicroseconds);
+    m_responseBytes.record(bytesReceived);
+}
+
+void Metrics::requestFailed(const QString& failureType, qint64 roundTripMicroseconds)
+{
+    m_requestsInFlight.fetch_sub(1, std::memory_order_relaxed);
+    m_requestRoundTrip.record(roundTripMicroseconds);
+    recordFailure(failureType);
+}
+
+void Metrics::recordFailure(const QString& failureType)
+{
+    QMutexLocker locker(&m_failuresMutex);
+    ++m_failuresByType[failureType];
+}
+
+void Metrics::recordDecode(qint64 microseconds)
+{
+    m_decode.record(microseconds);
+}
+
+void Metrics::recordFilterEvaluation(qint64 microseconds)
+{
+    m_filterEvaluation.record(microseconds);
+}
+
+void Metrics::recordPushReceived(qint64 bytes, bool isSnapshot)
+{
+    if (isSnapshot)
+    {
+        m_snapshotsReceived.fetch_add(1, std::memory_order_relaxed);
+        m_snapshotBytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    else
+    {
+        m_deltasReceived.fetch_add(1, std::memory_order_relaxed);
+        m_deltaBytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void Metrics::recordDeltaApply(qint64 microseconds)
+{
+    m_deltaApply.record(microseconds);
+}
+
+void Metrics::recordRefreshPlan(int refreshesPlanned, int refreshesDeferred)
+{
+    m_refreshesPlanned.fetch_add(refreshesPlanned, std::memory_order_relaxed);
+    m_refreshesDeferred.store(refreshesDeferred, std::memory_order_relaxed);
+}
+
+void Metrics::recordRequestBudget(int requestsToday, int dailyRequestBudget)
+{
+    m_requestsToday.store(requestsToday, std::memory_order_relaxed);
+    m_dailyRequestBudget.store(dailyRequestBudget, std::memory_order_relaxed);
+}
+
+int Metrics::requestsInFlight() const
+{
+    return m_requestsInFlight.load(std::memory_order_relaxed);
+}
+
+QMap<QString, quint64> Metrics::failuresByType() const
+{
+    QMutexLocker locker(&m_failuresMutex);
+    return m_failuresByType;
+}
+
+QVariantMap Metrics::summary() const
+{
+    const QMap<QString, quint64> failures = failuresByType();
+    quint64 failureCount = 0;
+    QStringList failureDescriptions;
+    for (auto failure = failures.cbegin(); failure != failures.cend(); ++failure)
+    {
+        failureCount += failure.value();
+        failureDescriptions.append(QString("%1 %2").arg(failure.key()).arg(failure.value()));
+    }
+
+    return QVariantMap{
+        {"requestsStarted", m_requestsStarted.load(std::memory_order_relaxed)},
+        {"requestsSucceeded", m_requestsSucceeded.load(std::memory_order_relaxed)},
+        {"requestsFailed", failureCount},
+        {"requestsInFlight", requestsInFlight()},
+        {"failures", failureDescriptions.join(", ")},
+        {"bytesReceived", m_bytesReceived.load(std::memory_order_relaxed)},
+        {"roundTripP50Milliseconds", toMilliseconds(m_requestRoundTrip.valueAtPercentile(50))},
+        {"roundTripP99Milliseconds", toMilliseconds(m_requestRoundTrip.valueAtPercentile(99))},
+        {"roundTripMaxMilliseconds", toMilliseconds(m_requestRoundTrip.max())},
+        {"decodeP50Milliseconds", toMilliseconds(m_decode.valueAtPercentile(50))},
+        {"decodeP99Milliseconds", toMilliseconds(m_decode.valueAtPercentile(99))},
+        {"filterP50Milliseconds", toMilliseconds(m_filterEvaluation.valueAtPercentile(50))},
+        {"filterMaxMilliseconds", toMilliseconds(m_filterEvaluation.max())},
+        {"deltasReceived", m_deltasReceived.load(std::memory_order_relaxed)},
+        {"deltaBytesReceived", m_deltaBytesReceived.load(std::memory_order_relaxed)},
+        {"snapshotsReceived", m_snapshotsReceived.load(std::memory_order_relaxed)},
+        {"snapshotBytesReceived", m_snapshotBytesReceived.load(std::memory_order_relaxed)},
+        {"deltaApplyP50Milliseconds", toMilliseconds(m_deltaApply.valueAtPercentile(50))},
+        {"deltaApplyMaxMilliseconds", toMilliseconds(m_deltaApply.max())},
+        {"refreshesPlanned", m_refreshesPlanned.load(std::memory_order_relaxed)},
+        {"refreshesDeferred", m_refreshesDeferred.load(std::memory_order_relaxed)},
+        {"requestsToday", m_requestsToday.load(std::memory_order_relaxed)},
+        {"dailyRequestBudget", m_dailyRequestBudget.load(std::memory_order_relaxed)}
+    };
+}
+
+void Metrics::reset()
+{
+    m_requestRoundTrip.reset();
+    m_responseBytes.reset();
+    m_decode.reset();
+    m_filterEvaluation.reset();
+    m_deltaApply.reset();
+    m_requestsStarted.store(0, std::memory_order_relaxed);
+    m_requestsSucceeded.store(0, std::memory_order_relaxed);
+    m_bytesReceived.store(0, std::memory_order_relaxed);
+    m_deltasReceived.store(0, std::memory_order_relaxed);
+    m_deltaBytesReceived.store(0, std::memory_order_relaxed);
+    m_snapshotsReceived.store(0, std::memory_order_relaxed);
+    m_snapshotBytesReceived.store(0, std::memory_order_relaxed);
+    m_refreshesPlanned.store(0, std::memory_order_relaxed);
+
+    // Requests that are still in flight are left counted, otherwise the gauge would go negative. The
+    // budget gauges describe the day so far and are left too.
+    QMutexLocker locker(&m_failuresMutex);
+    m_failuresByType.clear();
+}
+
+QByteArray Metrics::toPrometheusText() const
+{
+    QByteArray output;
+    output.reserve(8192);
+
+    appendCounter(output, "conditions_navigator_forecast_requests_started_total",
+                  "Forecast requests sent to Open-Meteo.", m_requestsStarted.load(std::memory_order_relaxed));
+    appendCounter(output, "conditions_navigator_forecast_requests_succeeded_total",
+                  "Forecast requests that returned a response.", m_requestsSucceeded.load(std::memory_order_relaxed));
+    appendGauge(output, "conditions_navigator_forecast_requests_in_flight",
+                "Forecast requests awaiting a response.", requestsInFlight());
+    appendCounter(output, "conditions_navigator_forecast_response_bytes_total",
+                  "Bytes received in forecast responses.", m_bytesReceived.load(std::memory_order_relaxed));
+
+    output += "# HELP conditions_navigator_forecast_request_failures_total Forecast requests that failed, by type.\n";
+    output += "# TYPE conditions_navigator_forecast_request_failures_total counter\n";
+    const QMap<QString, quint64> failures = failuresByType();
+    for (auto failure = failures.cbegin(); failure != failures.cend(); ++failure)
+    {
+        output += "conditions_navigator_forecast_request_failures_total{type=\"" + failure.key().toUtf8() + "\"} " +
+                  QByteArray::number(failure.value()) + '\n';
+    }
+
+    appendCounter(output, "conditions_navigator_forecast_deltas_received_total",
+                  "Forecast deltas pushed by the forecast service.", m_deltasReceived.load(std::memory_order_relaxed));
+    appendCounter(output, "conditions_navigator_forecast_delta_bytes_received_total",
+                  "Bytes of forecast deltas pushed by the forecast service.", m_deltaBytesReceived.load(std::memory_order_relaxed));
+    appendCounter(output, "conditions_navigator_forecast_snapshots_received_total",
+                  "Full forecast snapshots pushed by the forecast service.", m_snapshotsReceived.load(std::memory_order_relaxed));
+    appendCounter(output, "conditions_navigator_forecast_snapshot_bytes_received_total",
+                  "Bytes of full forecast snapshots pushed by the forecast service.", m_snapshotBytesReceived.load(std::memory_order_relaxed));
+
+    appendCounter(output, "conditions_navigator_refreshes_planned_total",
+                  "Stale forecasts the refresh planner requested again.", m_refreshesPlanned.load(std::memory_order_relaxed));
+    appendGauge(output, "conditions_navigator_refreshes_deferred",
+                "Stale forecasts of interest left for a later plan to stay within the request budget.",
+                m_refreshesDeferred.load(std::memory_order_relaxed));
+    appendGauge(output, "conditions_navigator_requests_today",
+                "Open-Meteo calls counted against today's budget since 00:00 UTC, rounded up.", m_requestsToday.load(std::memory_order_relaxed));
+    appendGauge(output, "conditions_navigator_daily_request_budget",
+                "Open-Meteo calls allowed each day.", m_dailyRequestBudget.load(std::memory_order_relaxed));
+
+    appendHistogram(output, "conditions_navigator_forecast_request_duration_seconds",
+                    "Time from sending a forecast request to receiving the whole response.",
+                    m_requestRoundTrip, requestRoundTripBounds, 1e-6);
+    appendHistogram(output, "conditions_navigator_forecast_response_size_bytes",
+                    "Size of each forecast response.", m_responseBytes, responseBytesBounds, 1.0);
+    appendHistogram(output, "conditions_navigator_forecast_decode_duration_seconds",
+                    "Time to decode a forecast response and build the next generation of its forecast, before it is published.",
+                    m_decode, processingBounds, 1e-6);
+    appendHistogram(output, "conditions_navigator_filter_evaluation_duration_seconds",
+                    "Time to classify every mountain for the selected days.",
+                    m_filterEvaluation, processingBounds, 1e-6);
+    appendHistogram(output, "conditions_navigator_delta_apply_duration_seconds",
+                    "Time to update the mountains changed by a pushed forecast delta.",
+                    m_deltaApply, processingBounds, 1e-6);
+
+    return output;
+}
@@ -0,0 +1,138 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+#include <QVariantMap>
+
+#include <array>
+#include <atomic>
+
+// A histogram with log-linear buckets in the style of HdrHistogram: every power of two is split
+// into 16 buckets, so any recorded value is reported to within about 6%. Recording is lock free
+// and may happen on any thread.
+class LatencyHistogram
+{
+public:
+    void record(qint64 value);
+    void reset();
+
+    quint64 count() const;
+    qint64 sum() const;
+    qint64 max() const;
+    qint64 valueAtPercentile(double percentile) const;
+    // Includes the whole bucket the value falls in, so it is only exact at a bucket's upper bound.
+    quint64 countAtOrBelow(qint64 value) const;
+
+    static int bucketIndex(qint64 value);
+    static qint64 bucketUpperBound(int index);
+
+private:
+    static constexpr int SubBucketBits = 4;
+    static constexpr int SubBucketCount = 1 << SubBucketBits;
+    static constexpr int BucketCount = 64 * SubBucketCount;
+
+    std::array<std::atomic<quint64>, BucketCount> m_counts{};
+    std::atomic<quint64> m_count{0};
+    std::atomic<qint64> m_sum{0};
+    std::atomic<qint64> m_max{0};
+};
+
+// Counters and histograms describing forecast retrieval and filtering. The values are shown in
+// the debug overlay (Ctrl+Shift+M) and, if enabled, served in the Prometheus text format by
+// MetricsEndpoint. Durations are recorded in microseconds.
+class Metrics : public QObject
+{
+    Q_OBJECT
+
+public:
+    static Metrics& instance();
+
+    void requestStarted();
+    void requestFinished(qint64 roundTripMicroseconds, qint64 bytesReceived);
+    void requestFailed(const QString& failureType, qint64 roundTripMicroseconds);
+    void recordFailure(const QString& failureType);
+    void recordDecode(qint64 microseconds);
+    void recordFilterEvaluation(qint64 microseconds);
+    void recordPushReceived(qint64 bytes, bool isSnapshot);
+    void recordDeltaApply(qint64 microseconds);
+    // The forecasts a RefreshPlanner asked for and those it left stale to stay within the budget.
+    void recordRefreshPlan(int refreshesPlanned, int refreshesDeferred);
+    // How much of the day's request budget has been used, in Open-Meteo calls rounded up.
+    void recordRequestBudget(int requestsToday, int dailyRequestBudget);
+
+    int requestsInFlight() const;
+    QMap<QString, quint64> failuresByType() const;
+
+    Q_INVOKABLE QVariantMap summary() const;
+    Q_INVOKABLE void reset();
+    QByteArray toPrometheusText() const;
+
+private:
+    Metrics() = default;
+
+    LatencyHistogram m_requestRoundTrip;
+    LatencyHistogram m_responseBytes;
+    LatencyHistogram m_decode;
+    LatencyHistogram m_filterEvaluation;
+    LatencyHistogram m_deltaApply;
+
+    std::atomic<quint64> m_requestsStarted{0};
+    std::atomic<quint64> m_requestsSucceeded{0};
+    std::atomic<quint64> m_bytesReceived{0};
+    std::atomic_int m_requestsInFlight{0};
+    std::atomic<quint64> m_deltasReceived{0};
+    std::atomic<quint64> m_deltaBytesReceived{0};
+    std::atomic<quint64> m_snapshotsReceived{0};
+    std::atomic<quint64> m_snapshotBytesReceived{0};
+    std::atomic<quint64> m_refreshesPlanned{0};
+    std::atomic_int m_refreshesDeferred{0};
+    std::atomic_int m_requestsToday{0};
+    std::atomic_int m_dailyRequestBudget{0};
+
+    mutable QMutex m_failuresMutex;
+    QMap<QString, quint64> m_failuresByType;
+};
+
+// Records the time between its construction and destruction through the given Metrics method.
+class ScopedMetricsTimer
+{
+public:
+    using Recorder = void (Metrics::*)(qint64);
+
+    explicit ScopedMetricsTimer(Recorder recorder) :
+        m_recorder(recorder)
+    {
+        m_timer.start();
+    }
+
+    ~ScopedMetricsTimer()
+    {
+        (Metrics::instance().*m_recorder)(m_timer.nsecsElapsed() / 1000);
+    }
+
+    ScopedMetricsTimer(const ScopedMetricsTimer&) = delete;
+    ScopedMetricsTimer& operator=(const ScopedMetricsTimer&) = delete;
+
+private:
+    const Recorder m_recorder;
+    QElapsedTimer m_timer;
+};
+
+#endif // METRICS_H
@@ -0,0 +1,134 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MetricsEndpoint.h"
+#include "Metrics.h"
+
+#include <QDebug>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+namespace
+{
+    // Requests are only a request line and a few headers; anything larger is not a scrape.
+    constexpr qint64 maximumRequestSize = 8192;
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+MetricsEndpoint::MetricsEndpoint(QObject* parent) :
+    QObject{parent},
+    m_server(new QTcpServer(this))
+{
+    connect(m_server, &QTcpServer::newConnection, this, &MetricsEndpoint::handleNewConnections);
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+bool MetricsEndpoint::configure(const QStringList& arguments)
+{
+    QString portText = qEnvironmentVariable("CONDITIONS_NAVIGATOR_METRICS_PORT");
+
+    const qsizetype portOption = arguments.indexOf("--metrics-port");
+    if (portOption >= 0 && portOption + 1 < arguments.size())
+        portText = arguments.at(portOption + 1);
+
+    if (portText.isEmpty())
+        return false;
+
+    bool isNumber = false;
+    const uint port = portText.toUInt(&isNumber);
+    if (!isNumber || port == 0 || port > 65535)
+    {
+        qWarning() << "Invalid metrics port" << portText;
+        return false;
+    }
+
+    return listen(static_cast<quint16>(port));
+}
+
+bool MetricsEndpoint::listen(quint16 port)
+{
+    if (!m_server->listen(QHostAddress::LocalHost, port))
+    {
+        qWarning() << "Unable to serve metrics on port" << port << m_server->errorString();
+        return false;
+    }
+    return true;
+}
+
+quint16 MetricsEndpoint::port() const
+{
+    return m_server->serverPort();
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+void MetricsEndpoint::handleNewConnections()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection())
+    {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket](){
+            respond(socket);
+        });
+    }
+}
+
+void MetricsEndpoint::respond(QTcpSocket* socket)
+{
+    // Wait until the whole request header has arrived.
+    if (!socket->peek(maximumRequestSize).contains("\r\n\r\n"))
+    {
+        if (socket->bytesAvailable() >= maximumRequestSize)
+            socket->abort();
+        return;
+    }
+
+    const QByteArray requestLine = socket->readLine().trimmed();
+    socket->readAll();
+    disconnect(socket, &QTcpSocket::readyRead, this, nullptr);
+
+    const QList<QByteArray> requestParts = requestLine.split(' ');
+    const bool isScrape = requestParts.size() >= 2 && requestParts.at(0) == "GET" &&
+                          (requestParts.at(1) == "/metrics" || requestParts.at(1) == "/");
+
+    QByteArray body;
+    QByteArray status;
+    QByteArray contentType;
+    if (isScrape)
+    {
+        status = "200 OK";
+        contentType = "text/plain; version=0.0.4; charset=utf-8";
+        body = Metrics::instance().toPrometheusText();
+    }
+    else
+    {
+        status = "404 Not Found";
+        contentType = "text/plain; charset=utf-8";
+        body = "Metrics are served at /metrics\n";
+    }
+
+    socket->write("HTTP/1.1 " + status + "\r\n" +
+                  "Content-Type: " + contentType + "\r\n" +
+                  "Content-Length: " + QByteArray::number(body.size()) + "\r\n" +
+                  "Connection: close\r\n\r\n" + body);
+    socket->disconnectFromHost();
+}
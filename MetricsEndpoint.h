@@ -0,0 +1,44 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef METRICSENDPOINT_H
+#define METRICSENDPOINT_H
+
+#include <QObject>
+#include <QStringList>
+
+class QTcpServer;
+class QTcpSocket;
+
+// Serves the Metrics in the Prometheus text format at http://127.0.0.1:<port>/metrics. The endpoint
+// is only started when the CONDITIONS_NAVIGATOR_METRICS_PORT environment variable or the
+// --metrics-port command line option gives a port, and it only listens on the loopback interface.
+class MetricsEndpoint : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsEndpoint(QObject* parent = nullptr);
+
+    bool configure(const QStringList& arguments);
+    bool listen(quint16 port);
+    quint16 port() const;
+
+private:
+    QTcpServer* m_server = nullptr;
+
+    void handleNewConnections();
+    void respond(QTcpSocket* socket);
+};
+
+#endif // METRICSENDPOINT_H
@@ -0,0 +1,343 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MountainForecast.h"
+
+#include <QHashFunctions>
+
+#include <algorithm>
+
+namespace
+{
+    // A daily series longer than the dates has no days for its extra values.
+    template<typename T>
+    QList<T> alignedWithDates(const QList<T>& values, qsizetype numberOfDates)
+    {
+        return values.size() > numberOfDates ? values.first(numberOfDates) : values;
+    }
+
+    template<typename T>
+    qsizetype listFootprint(const QList<T>& list)
+    {
+        return list.capacity() * static_cast<qsizetype>(sizeof(T));
+    }
+
+    template<typename T>
+    size_t hashList(const QList<T>& list, size_t seed)
+    {
+        return qHashRange(list.cbegin(), list.cend(), seed);
+    }
+
+    // QList::clear would copy the storage of a list that a reader still shares, so such a list is
+    // released instead and only unshared storage is kept for reuse.
+    template<typename T>
+    void clearKeepingStorage(QList<T>* list)
+    {
+        if (list->isDetached())
+            list->clear();
+        else
+            *list = QList<T>();
+    }
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+QList<int> MountainForecast::getDailyFreezingLevelBelowSummitHours() const
+{
+    return alignedWithDates(m_series.dailyFreezingLevelBelowSummitHours, m_series.dates.size());
+}
+
+QList<double> MountainForecast::getDailyMinimumWindChill() const
+{
+    return alignedWithDates(m_series.dailyMinimumWindChill, m_series.dates.size());
+}
+
+QList<double> MountainForecast::getDailyPrecipitation() const
+{
+    return alignedWithDates(m_series.dailyPrecipitation, m_series.dates.size());
+}
+
+QList<int> MountainForecast::getDailySummitInCloudHours() const
+{
+    return alignedWithDates(m_series.dailySummitInCloudHours, m_series.dates.size());
+}
+
+QList<QString> MountainForecast::getDailyWeatherConditions() const
+{
+    const qsizetype numberOfDays = std::min(m_series.dates.size(), m_series.dailyWeatherCode.size());
+    QList<QString> weatherConditions;
+    weatherConditions.reserve(numberOfDays);
+    for (qsizetype day = 0; day < numberOfDays; ++day)
+        weatherConditions.append(convertWeatherCodeToConditions(m_series.dailyWeatherCode.at(day)));
+    return weatherConditions;
+}
+
+QList<QString> MountainForecast::getDailyWindDirection() const
+{
+    const qsizetype numberOfDays = std::min(m_series.dates.size(), m_series.dailyWindDirection.size());
+    QList<QString> windDirection;
+    windDirection.reserve(numberOfDays);
+    for (qsizetype day = 0; day < numberOfDays; ++day)
+        windDirection.append(convertWindDirectionToOrientation(m_series.dailyWindDirection.at(day)));
+    return windDirection;
+}
+
+QList<double> MountainForecast::getDailyWindGusts() const
+{
+    return alignedWithDates(m_series.dailyWindGusts, m_series.dates.size());
+}
+
+QList<double> MountainForecast::getDailyWindSpeed() const
+{
+    return alignedWithDates(m_series.dailyWindSpeed, m_series.dates.size());
+}
+
+QList<QDate> MountainForecast::getDates() const
+{
+    return m_series.dates;
+}
+
+QList<QString> MountainForecast::getDays() const
+{
+    QList<QString> days;
+    for (const auto date : m_series.dates)
+        days.append(date.toString("ddd"));
+    return days;
+}
+
+ForecastEnsemble::Statistics MountainForecast::getEnsembleStatistics(const QString& variable) const
+{
+    return m_ensembleStatistics.value(variable);
+}
+
+void MountainForecast::setEnsembleStatistics(const QString& variable, const ForecastEnsemble::Statistics& statistics)
+{
+    m_ensembleStatistics.insert(variable, statistics);
+}
+
+QList<double> MountainForecast::getHourlyApparentTemperature() const
+{
+    return m_series.hourlyApparentTemperature;
+}
+
+QList<double> MountainForecast::getHourlyCloudBaseMargin() const
+{
+    return m_series.hourlyCloudBaseMargin;
+}
+
+QList<QDateTime> MountainForecast::getHourlyDateTime() const
+{
+    // To ensure the lines marking the days on the date/time axis on the results plots
+    // are in the correct place, add an extra step to the data to make the last data point
+    // fall at the end of the last day.
+    return m_series.hourlyTime.toDateTimes(1);
+}
+
+QList<double> MountainForecast::getHourlyFreezingLevelMargin() const
+{
+    return m_series.hourlyFreezingLevelMargin;
+}
+
+QList<double> MountainForecast::getHourlyPrecipitation() const
+{
+    return m_series.hourlyPrecipitation;
+}
+
+QList<double> MountainForecast::getHourlyTemperature() const
+{
+    return m_series.hourlyTemperature;
+}
+
+TimeAxis MountainForecast::getHourlyTimeAxis() const
+{
+    return m_series.hourlyTime;
+}
+
+QList<int> MountainForecast::getHourlyVisibility() const
+{
+    return m_series.hourlyVisibility;
+}
+
+QList<double> MountainForecast::getHourlyWindChill() const
+{
+    return m_series.hourlyWindChill;
+}
+
+const MountainForecast::Series& MountainForecast::getSeries() const
+{
+    return m_series;
+}
+
+qsizetype MountainForecast::memoryFootprint() const
+{
+    qsizetype bytes = sizeof(MountainForecast);
+    bytes += listFootprint(m_series.hourlyApparentTemperature) + listFootprint(m_series.hourlyPrecipitation) +
+             listFootprint(m_series.hourlyTemperature) + listFootprint(m_series.hourlyVisibility) +
+             listFootprint(m_series.hourlyCloudBaseMargin) + listFootprint(m_series.hourlyFreezingLevelMargin) +
+             listFootprint(m_series.hourlyWindChill);
+    bytes += listFootprint(m_series.dates) + listFootprint(m_series.dailyPrecipitation) +
+             listFootprint(m_series.dailyWeatherCode) + listFootprint(m_series.dailyWindDirection) +
+             listFootprint(m_series.dailyWindGusts) + listFootprint(m_series.dailyWindSpeed) +
+             listFootprint(m_series.dailyFreezingLevelBelowSummitHours) + listFootprint(m_series.dailyMinimumWindChill) +
+             listFootprint(m_series.dailySummitInCloudHours);
+    for (const ForecastEnsemble::Statistics& statistics : m_ensembleStatistics)
+    {
+        bytes += listFootprint(statistics.mean) + listFootprint(statistics.minimum) + listFootprint(statistics.maximum) +
+                 listFootprint(statistics.spread) + listFootprint(statistics.percentile);
+    }
+    return bytes;
+}
+
+MountainForecast::SeriesHashes MountainForecast::hashSeries() const
+{
+    const TimeAxis& time = m_series.hourlyTime;
+    const size_t timeHash = qHashMulti(0, time.getOriginSeconds(), time.getStepSeconds(), time.size(), time.getUtcOffsetSeconds(),
+                                       time.getCoarseStartIndex(), time.getCoarseStepSeconds());
+
+    SeriesHashes hashes;
+    hashes.hourlyTime = timeHash;
+    hashes.hourlyApparentTemperature = hashList(m_series.hourlyApparentTemperature, timeHash);
+    hashes.hourlyCloudBaseMargin = hashList(m_series.hourlyCloudBaseMargin, timeHash);
+    hashes.hourlyFreezingLevelMargin = hashList(m_series.hourlyFreezingLevelMargin, timeHash);
+    hashes.hourlyPrecipitation = hashList(m_series.hourlyPrecipitation, timeHash);
+    hashes.hourlyTemperature = hashList(m_series.hourlyTemperature, timeHash);
+    hashes.hourlyVisibility = hashList(m_series.hourlyVisibility, timeHash);
+    hashes.hourlyWindChill = hashList(m_series.hourlyWindChill, timeHash);
+
+    size_t daily = hashList(m_series.dates, 0);
+    daily = hashList(m_series.dailyPrecipitation, daily);
+    daily = hashList(m_series.dailyWeatherCode, daily);
+    daily = hashList(m_series.dailyWindDirection, daily);
+    daily = hashList(m_series.dailyWindGusts, daily);
+    daily = hashList(m_series.dailyWindSpeed, daily);
+    daily = hashList(m_series.dailyFreezingLevelBelowSummitHours, daily);
+    daily = hashList(m_series.dailyMinimumWindChill, daily);
+    hashes.daily = hashList(m_series.dailySummitInCloudHours, daily);
+    return hashes;
+}
+
+MountainForecast::Series* MountainForecast::mutableSeries()
+{
+    return &m_series;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+void MountainForecast::clear()
+{
+    m_series.hourlyTime = TimeAxis();
+    clearKeepingStorage(&m_series.hourlyApparentTemperature);
+    clearKeepingStorage(&m_series.hourlyPrecipitation);
+    clearKeepingStorage(&m_series.hourlyTemperature);
+    clearKeepingStorage(&m_series.hourlyVisibility);
+    clearKeepingStorage(&m_series.hourlyCloudBaseMargin);
+    clearKeepingStorage(&m_series.hourlyFreezingLevelMargin);
+    clearKeepingStorage(&m_series.hourlyWindChill);
+    clearKeepingStorage(&m_series.dates);
+    clearKeepingStorage(&m_series.dailyPrecipitation);
+    clearKeepingStorage(&m_series.dailyWeatherCode);
+    clearKeepingStorage(&m_series.dailyWindDirection);
+    clearKeepingStorage(&m_series.dailyWindGusts);
+    clearKeepingStorage(&m_series.dailyWindSpeed);
+    clearKeepingStorage(&m_series.dailyFreezingLevelBelowSummitHours);
+    clearKeepingStorage(&m_series.dailyMinimumWindChill);
+    clearKeepingStorage(&m_series.dailySummitInCloudHours);
+    m_ensembleStatistics.clear();
+}
+
+const QString& MountainForecast::convertWeatherCodeToConditions(const int weatherCode)
+{
+    static const QString unknown;
+
+    const auto conditions = dailyConditionsMap().constFind(weatherCode);
+    return conditions != dailyConditionsMap().cend() ? *conditions : unknown;
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+const QString& MountainForecast::convertWindDirectionToOrientation(const int windDirection)
+{
+    // The names are created once so that reading them does not allocate.
+    static const QString north{"N"};
+    static const QString northEast{"NE"};
+    static const QString east{"E"};
+    static const QString southEast{"SE"};
+    static const QString south{"S"};
+    static const QString southWest{"SW"};
+    static const QString west{"W"};
+    static const QString northWest{"NW"};
+    static const QString unknown{"?"};
+
+    if (windDirection >= 338 && windDirection <= 360)
+        return north;
+    if (windDirection >= 0 && windDirection <= 22)
+        return north;
+    if (windDirection >= 23 && windDirection <= 67)
+        return northEast;
+    if (windDirection >= 68 && windDirection <= 112)
+        return east;
+    if (windDirection >= 113 && windDirection <= 157)
+        return southEast;
+    if (windDirection >= 158 && windDirection <= 202)
+        return south;
+    if (windDirection >= 203 && windDirection <= 247)
+        return southWest;
+    if (windDirection >= 248 && windDirection <= 292)
+        return west;
+    if (windDirection >= 293 && windDirection <= 337)
+        return northWest;
+
+    return unknown;
+}
+
+const QMap<int, QString>& MountainForecast::dailyConditionsMap()
+{
+    // Forecasts are built on worker threads, so the map is created once, thread safely, and only read.
+    static const QMap<int, QString> conditionsMap{
+        {0, QString{"Clear"}},
+        {1, QString{"Mainly Clear"}},
+        {2, QString{"Partly cloudy"}},
+        {3, QString{"Overcast"}},
+        {45, QString{"Fog"}},
+        {48, QString{"Fog (with rime)"}},
+        {51, QString{"Drizzle (light)"}},
+        {53, QString{"Drizzle (moderate)"}},
+        {55, QString{"Drizzle (dense)"}},
+        {56, QString{"Drizzle (freezing)"}},
+        {57, QString{"Drizzle (freezing)"}},
+        {61, QString{"Rain (slight)"}},
+        {63, QString{"Rain (moderate)"}},
+        {65, QString{"Rain (heavy)"}},
+        {66, QString{"Rain (freezing)"}},
+        {67, QString{"Rain (freezing)"}},
+        {71, QString{"Snow (slight)"}},
+        {73, QString{"Snow (moderate)"}},
+        {75, QString{"Snow (heavy)"}},
+        {77, QString{"Snow"}},
+        {80, QString{"Rain Showers (slight)"}},
+        {81, QString{"Rain Showers (moderate)"}},
+        {82, QString{"Rain Showers (violent)"}},
+        {85, QString{"Snow Showers"}},
+        {86, QString{"Snow Showers"}},
+        {95, QString{"Thunderstorms"}},
+        {96, QString{"Thunderstorms"}},
+        {99, QString{"Thunderstorms"}}
+    };
+    return conditionsMap;
+}
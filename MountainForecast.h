@@ -0,0 +1,117 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOUNTAINFORECAST_H
+#define MOUNTAINFORECAST_H
+
+#include <QDate>
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+#include <QString>
+
+#include "ForecastEnsemble.h"
+#include "TimeAxis.h"
+
+// One generation of the forecast for a mountain. A generation is built completely, on any thread,
+// and then published to its Mountain, after which it is never modified. Readers hold a reference
+// counted pointer to the generation they are reading, so they never see a forecast that is partly
+// old and partly new.
+class MountainForecast
+{
+public:
+    // The series as they are stored. Builders fill them in place so that a recycled generation reuses
+    // its storage (see ForecastBufferPool). The daily series are in the order of the dates, and the
+    // weather and wind direction are kept as codes and degrees until they are read.
+    struct Series
+    {
+        TimeAxis hourlyTime;
+        QList<double> hourlyApparentTemperature;
+        QList<double> hourlyPrecipitation;
+        QList<double> hourlyTemperature;
+        QList<int> hourlyVisibility;
+        // Derived by HazardKernel; empty when the response lacks the variables they need.
+        QList<double> hourlyCloudBaseMargin;
+        QList<double> hourlyFreezingLevelMargin;
+        QList<double> hourlyWindChill;
+        QList<QDate> dates;
+        QList<double> dailyPrecipitation;
+        QList<int> dailyWeatherCode;
+        QList<int> dailyWindDirection;
+        QList<double> dailyWindGusts;
+        QList<double> dailyWindSpeed;
+        QList<int> dailyFreezingLevelBelowSummitHours;
+        QList<double> dailyMinimumWindChill;
+        QList<int> dailySummitInCloudHours;
+    };
+
+    // Hashes of the series, so that the ones that differ between two generations can be found without
+    // comparing every value. The hash of each hourly series includes its times, and the daily values
+    // have a single hash between them as they are shown together.
+    struct SeriesHashes
+    {
+        size_t hourlyTime = 0;
+        size_t hourlyApparentTemperature = 0;
+        size_t hourlyCloudBaseMargin = 0;
+        size_t hourlyFreezingLevelMargin = 0;
+        size_t hourlyPrecipitation = 0;
+        size_t hourlyTemperature = 0;
+        size_t hourlyVisibility = 0;
+        size_t hourlyWindChill = 0;
+        size_t daily = 0;
+    };
+
+    QList<int> getDailyFreezingLevelBelowSummitHours() const;
+    QList<double> getDailyMinimumWindChill() const;
+    QList<double> getDailyPrecipitation() const;
+    QList<int> getDailySummitInCloudHours() const;
+    QList<QString> getDailyWeatherConditions() const;
+    QList<QString> getDailyWindDirection() const;
+    QList<double> getDailyWindGusts() const;
+    QList<double> getDailyWindSpeed() const;
+    QList<QDate> getDates() const;
+    QList<QString> getDays() const;
+    ForecastEnsemble::Statistics getEnsembleStatistics(const QString& variable) const;
+    QList<double> getHourlyApparentTemperature() const;
+    QList<double> getHourlyCloudBaseMargin() const;
+    QList<QDateTime> getHourlyDateTime() const;
+    QList<double> getHourlyFreezingLevelMargin() const;
+    QList<double> getHourlyPrecipitation() const;
+    QList<double> getHourlyTemperature() const;
+    TimeAxis getHourlyTimeAxis() const;
+    QList<int> getHourlyVisibility() const;
+    QList<double> getHourlyWindChill() const;
+    // The series as stored, for reading many values without copying them, as when classifying.
+    const Series& getSeries() const;
+    // An estimate of the memory held by this generation, for budgeting how many are kept loaded.
+    qsizetype memoryFootprint() const;
+    SeriesHashes hashSeries() const;
+
+    // Only for building a generation before it is published.
+    Series* mutableSeries();
+    void setEnsembleStatistics(const QString& variable, const ForecastEnsemble::Statistics& statistics);
+    // Empties every series but keeps their storage.
+    void clear();
+
+    // The description of a weather code, or an empty string for a code that is not known.
+    static const QString& convertWeatherCodeToConditions(const int weatherCode);
+
+private:
+    QMap<QString, ForecastEnsemble::Statistics> m_ensembleStatistics;
+    Series m_series;
+
+    static const QString& convertWindDirectionToOrientation(const int windDirection);
+    static const QMap<int, QString>& dailyConditionsMap();
+};
+
+#endif // MOUNTAINFORECAST_H
@@ -1,326 +1,326 @@
-// Copyright 2023 Esri
-
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-
-// Unless required by applicable law or agreed to in writing, software
-// distributed under the License is distributed on an "AS IS" BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-// See the License for the specific language governing permissions and
-// limitations under the License.
-
-#ifndef MOUNTAINLOCATIONS_H
-#define MOUNTAINLOCATIONS_H
-
-#include <QList>
-#include <QObject>
-
-#include "Mountain.h"
-
-Q_MOC_INCLUDE("MountainLocations.h")
-
-class MountainLocations : public QObject
-{
-  Q_OBJECT
-
-public:
-    explicit MountainLocations(QObject* parent = nullptr):
-      m_parent(parent){}
-
-    const QList<Mountain*> getLocations() const
-    {
-        return m_scottishMunroLocations;
-    }
-
-private:
-    QObject* m_parent = nullptr;
-
-    const QList<Mountain*> m_scottishMunroLocations {
-        new Mountain("Ben Chonzie", 56.453847, -3.992056, 931, m_parent),
-        new Mountain("Ben Vorlich", 56.342678, -4.219454, 985.3, m_parent),
-        new Mountain("Stuc a' Chroin", 56.329313, -4.237539, 973, m_parent),
-        new Mountain("Ben Lomond", 56.190293, -4.633016, 973.7, m_parent),
-        new Mountain("Ben More", 56.385956, -4.540084, 1174, m_parent),
-        new Mountain("Stob Binnein", 56.370721, -4.535749, 1165, m_parent),
-        new Mountain("Cruach Ardrain", 56.356433, -4.576146, 1045.9, m_parent),
-        new Mountain("An Caisteal", 56.338596, -4.624361, 995.9, m_parent),
-        new Mountain("Beinn Tulaichean", 56.34222, -4.563326, 945.8, m_parent),
-        new Mountain("Beinn a' Chroin", 56.331987, -4.609638, 941.4, m_parent),
-        new Mountain("Beinn Chabhair", 56.325775, -4.641485, 932.2, m_parent),
-        new Mountain("Ben Lui [Beinn Laoigh]", 56.397005, -4.810513, 1131.4, m_parent),
-        new Mountain("Ben Oss", 56.389274, -4.775494, 1029, m_parent),
-        new Mountain("Beinn Dubhchraig", 56.391297, -4.743199, 978, m_parent),
-        new Mountain("Beinn a' Chleibh", 56.390231, -4.835632, 916.3, m_parent),
-        new Mountain("Ben Vorlich", 56.274018, -4.75505, 943, m_parent),
-        new Mountain("Beinn Ime", 56.236792, -4.817126, 1012.2, m_parent),
-        new Mountain("Ben Vane", 56.249783, -4.781658, 915.76, m_parent),
-        new Mountain("Beinn Narnain", 56.220954, -4.789006, 927, m_parent),
-        new Mountain("Beinn Bhuidhe", 56.326662, -4.906722, 948.5, m_parent),
-        new Mountain("Schiehallion", 56.66693, -4.100228, 1083, m_parent),
-        new Mountain("Carn Mairg", 56.634633, -4.145605, 1042, m_parent),
-        new Mountain("Carn Gorm", 56.622535, -4.226015, 1029, m_parent),
-        new Mountain("Meall Garbh", 56.637378, -4.207468, 968, m_parent),
-        new Mountain("Meall na Aighean", 56.620626, -4.128738, 981, m_parent),
-        new Mountain("Stuc an Lochain [Stuchd an Lochain]", 56.570905, -4.470605, 960, m_parent),
-        new Mountain("Meall Buidhe", 56.617226, -4.448644, 932.1, m_parent),
-        new Mountain("Beinn Dorain", 56.502868, -4.72215, 1076, m_parent),
-        new Mountain("Beinn an Dothaidh", 56.530127, -4.713958, 1004, m_parent),
-        new Mountain("Beinn Achaladair", 56.551887, -4.694525, 1038.6, m_parent),
-        new Mountain("Beinn a' Chreachain", 56.560382, -4.647618, 1080.6, m_parent),
-        new Mountain("Beinn Mhanach", 56.534038, -4.646038, 953, m_parent),
-        new Mountain("Ben Lawers", 56.544922, -4.220853, 1214, m_parent),
-        new Mountain("An Stuc", 56.560093, -4.216258, 1117.1, m_parent),
-        new Mountain("Meall Garbh", 56.566122, -4.207707, 1123.1, m_parent),
-        new Mountain("Meall Greigh", 56.567426, -4.159554, 1001, m_parent),
-        new Mountain("Beinn Ghlas", 56.535997, -4.236985, 1103, m_parent),
-        new Mountain("Meall Corranaich", 56.540947, -4.253461, 1069, m_parent),
-        new Mountain("Meall a' Choire Leith", 56.566312, -4.259609, 925.6, m_parent),
-        new Mountain("Meall nan Tarmachan", 56.521656, -4.301349, 1043.6, m_parent),
-        new Mountain("Meall Ghaordaidh", 56.52581, -4.416657, 1039.8, m_parent),
-        new Mountain("Beinn Sheasgarnaich [Beinn Heasgarnich]", 56.510271, -4.579216, 1077.4, m_parent),
-        new Mountain("Creag Mhor", 56.489518, -4.614034, 1046.8, m_parent),
-        new Mountain("Beinn Challuim [Ben Challum]", 56.454574, -4.619179, 1025, m_parent),
-        new Mountain("Meall Glas", 56.455713, -4.546818, 959, m_parent),
-        new Mountain("Sgiath Chuil", 56.453149, -4.495653, 920.1, m_parent),
-        new Mountain("Sgorr nam Fiannaidh (Aonach Eagach)", 56.679368, -5.037129, 967.7, m_parent),
-        new Mountain("Meall Dearg (Aonach Eagach)", 56.68072, -5.003271, 952.3, m_parent),
-        new Mountain("Stob Dearg (Buachaille Etive Mor)", 56.646229, -4.900337, 1021.4, m_parent),
-        new Mountain("Stob na Broige (Buachaille Etive Mor)", 56.62988, -4.951151, 953.4, m_parent),
-        new Mountain("Stob Dubh (Buachaille Etive Beag)", 56.638159, -4.970752, 958, m_parent),
-        new Mountain("Stob Coire Raineach (Buachaille Etive Beag) ", 56.649895, -4.951607, 924.5, m_parent),
-        new Mountain("Bidean nam Bian", 56.642768, -5.029338, 1149.4, m_parent),
-        new Mountain("Stob Coire Sgreamhach", 56.638314, -5.010287, 1072, m_parent),
-        new Mountain("Sgorr Dhearg (Beinn a' Bheithir)", 56.653921, -5.171509, 1024, m_parent),
-        new Mountain("Sgorr Dhonuill (Beinn a' Bheithir)", 56.650498, -5.197755, 1001, m_parent),
-        new Mountain("Sgurr na h-Ulaidh [Sgor na h-Ulaidh]", 56.619797, -5.08006, 994, m_parent),
-        new Mountain("Beinn Fhionnlaidh", 56.60098, -5.104748, 959, m_parent),
-        new Mountain("Beinn Sgulaird", 56.566235, -5.170363, 937, m_parent),
-        new Mountain("Ben Cruachan", 56.426839, -5.131828, 1127, m_parent),
-        new Mountain("Stob Daimh [Stob Diamh]", 56.431325, -5.091313, 999.2, m_parent),
-        new Mountain("Beinn Eunaich", 56.450351, -5.026636, 989, m_parent),
-        new Mountain("Beinn a' Chochuill", 56.449779, -5.068531, 980, m_parent),
-        new Mountain("Beinn nan Aighenan", 56.520217, -5.011249, 960, m_parent),
-        new Mountain("Ben Starav", 56.538926, -5.049747, 1079.5, m_parent),
-        new Mountain("Glas Bheinn Mhor", 56.54242, -5.005268, 997.7, m_parent),
-        new Mountain("Stob Coir' an Albannaich", 56.554907, -4.979811, 1044, m_parent),
-        new Mountain("Meall nan Eun", 56.561179, -4.94293, 928, m_parent),
-        new Mountain("Stob Ghabhar", 56.568106, -4.882105, 1090, m_parent),
-        new Mountain("Stob a' Choire Odhair", 56.573312, -4.83831, 945, m_parent),
-        new Mountain("Creise", 56.614449, -4.871995, 1099.8, m_parent),
-        new Mountain("Meall a' Bhuiridh", 56.612219, -4.852119, 1107.9, m_parent),
-        new Mountain("Ben Nevis", 56.796887, -5.003683, 1344.53, m_parent),
-        new Mountain("Aonach Beag", 56.799995, -4.954114, 1234, m_parent),
-        new Mountain("Aonach Mor", 56.812938, -4.961705, 1220.4, m_parent),
-        new Mountain("Carn Mor Dearg", 56.805242, -4.986624, 1220, m_parent),
-        new Mountain("Sgurr Choinnich Mor", 56.800427, -4.903954, 1094, m_parent),
-        new Mountain("Stob Coire an Laoigh", 56.810874, -4.884886, 1116, m_parent),
-        new Mountain("Stob Choire Claurigh", 56.823783, -4.849621, 1177, m_parent),
-        new Mountain("Stob Ban", 56.810653, -4.840873, 977, m_parent),
-        new Mountain("Stob Coire Easain", 56.818196, -4.773709, 1115, m_parent),
-        new Mountain("Stob a' Choire Mheadhoin", 56.823682, -4.760182, 1105, m_parent),
-        new Mountain("Sgurr Eilde Mor", 56.750013, -4.89543, 1010, m_parent),
-        new Mountain("Binnein Beag", 56.766958, -4.911155, 943, m_parent),
-        new Mountain("Binnein Mor", 56.754373, -4.925789, 1130, m_parent),
-        new Mountain("Na Gruagaichean", 56.743687, -4.939875, 1054.3, m_parent),
-        new Mountain("An Gearanach", 56.759169, -4.966238, 981.5, m_parent),
-        new Mountain("Stob Coire a' Chairn", 56.750754, -4.968993, 981.3, m_parent),
-        new Mountain("Am Bodach", 56.741727, -4.983394, 1031.8, m_parent),
-        new Mountain("Sgurr a' Mhaim", 56.755917, -5.003697, 1099, m_parent),
-        new Mountain("Stob Ban", 56.743704, -5.030333, 999.7, m_parent),
-        new Mountain("Mullach nan Coirean", 56.749863, -5.07245, 939.3, m_parent),
-        new Mountain("Stob Coire Sgriodain", 56.831742, -4.694919, 979, m_parent),
-        new Mountain("Chno Dearg", 56.830083, -4.660833, 1046, m_parent),
-        new Mountain("Beinn na Lap", 56.789388, -4.659995, 935, m_parent),
-        new Mountain("Carn Dearg", 56.75993, -4.589892, 941, m_parent),
-        new Mountain("Sgor Gaibhre", 56.772553, -4.546503, 955, m_parent),
-        new Mountain("Beinn Eibhinn", 56.825254, -4.542082, 1103.3, m_parent),
-        new Mountain("Aonach Beag", 56.833496, -4.529181, 1115.8, m_parent),
-        new Mountain("Geal-Charn", 56.837835, -4.509701, 1132, m_parent),
-        new Mountain("Carn Dearg", 56.85524, -4.454701, 1034, m_parent),
-        new Mountain("Beinn a' Chlachair", 56.869523, -4.509691, 1087, m_parent),
-        new Mountain("Creag Pitridh", 56.89971, -4.484947, 924, m_parent),
-        new Mountain("Geal Charn", 56.897761, -4.457228, 1049, m_parent),
-        new Mountain("Ben Alder", 56.813795, -4.465097, 1148, m_parent),
-        new Mountain("Beinn Bheoil", 56.813276, -4.430655, 1019, m_parent),
-        new Mountain("Beinn Udlamain", 56.835444, -4.329972, 1010.2, m_parent),
-        new Mountain("Sgairneach Mhor", 56.828448, -4.297788, 991, m_parent),
-        new Mountain("A' Mharconaich", 56.857002, -4.290665, 973.2, m_parent),
-        new Mountain("Geal-charn", 56.874432, -4.304515, 917.1, m_parent),
-        new Mountain("Meall Chuaich", 56.963849, -4.112571, 951, m_parent),
-        new Mountain("Carn na Caim", 56.911739, -4.174478, 940.8, m_parent),
-        new Mountain("A' Bhuidheanach Bheag", 56.870342, -4.199, 936.1, m_parent),
-        new Mountain("Beinn Dearg", 56.877349, -3.883712, 1008.7, m_parent),
-        new Mountain("An Sgarsoch", 56.932111, -3.75429, 1006.5, m_parent),
-        new Mountain("Carn an Fhidhleir [Carn Ealar]", 56.936021, -3.80153, 994, m_parent),
-        new Mountain("Carn a' Chlamain", 56.860968, -3.77963, 963.5, m_parent),
-        new Mountain("Carn nan Gabhar (Beinn a' Ghlo)", 56.83984, -3.688052, 1121.9, m_parent),
-        new Mountain("Braigh Coire Chruinn-bhalgain (Beinn a' Ghlo)", 56.831087, -3.729501, 1070, m_parent),
-        new Mountain("Carn Liath (Beinn a' Ghlo)", 56.807766, -3.744085, 976, m_parent),
-        new Mountain("Glas Tulaichean", 56.865761, -3.558164, 1051, m_parent),
-        new Mountain("Carn an Righ", 56.876587, -3.595272, 1029, m_parent),
-        new Mountain("Beinn Iutharn Mhor", 56.894997, -3.56823, 1045, m_parent),
-        new Mountain("Carn Bhac", 56.930543, -3.560881, 945.1, m_parent),
-        new Mountain("An Socach", 56.902298, -3.513167, 944, m_parent),
-        new Mountain("Carn a' Gheoidh", 56.873061, -3.466619, 975, m_parent),
-        new Mountain("The Cairnwell", 56.879515, -3.421203, 933, m_parent),
-        new Mountain("Carn Aosda", 56.8957, -3.423279, 915.3, m_parent),
-        new Mountain("Cac Carn Beag (Lochnagar)", 56.960274, -3.245254, 1155.7, m_parent),
-        new Mountain("Carn a' Choire Bhoidheach", 56.945776, -3.272699, 1109.9, m_parent),
-        new Mountain("Carn an t-Sagairt Mor", 56.942973, -3.303227, 1047, m_parent),
-        new Mountain("Glas Maol", 56.873063, -3.368242, 1068, m_parent),
-        new Mountain("Creag Leacach", 56.854627, -3.387756, 988.2, m_parent),
-        new Mountain("Cairn of Claise", 56.894174, -3.338644, 1064, m_parent),
-        new Mountain("Carn an Tuirc", 56.908277, -3.357131, 1019, m_parent),
-        new Mountain("Tom Buidhe", 56.893619, -3.292364, 957, m_parent),
-        new Mountain("Tolmount", 56.904737, -3.297937, 958, m_parent),
-        new Mountain("Cairn Bannoch", 56.927732, -3.278411, 1012, m_parent),
-        new Mountain("Broad Cairn", 56.919152, -3.249074, 998, m_parent),
-        new Mountain("Mayar", 56.848932, -3.246291, 928, m_parent),
-        new Mountain("Driesh", 56.847981, -3.196531, 947, m_parent),
-        new Mountain("Mount Keen", 56.969754, -2.973622, 939, m_parent),
-        new Mountain("Mullach Clach a' Bhlair", 57.011878, -3.841282, 1019, m_parent),
-        new Mountain("Sgor Gaoith", 57.068558, -3.810853, 1118, m_parent),
-        new Mountain("Braeriach", 57.078304, -3.728372, 1296, m_parent),
-        new Mountain("Sgor an Lochain Uaine", 57.058365, -3.725895, 1258, m_parent),
-        new Mountain("Cairn Toul", 57.054404, -3.710773, 1291, m_parent),
-        new Mountain("The Devil's Point", 57.035709, -3.688802, 1006.9, m_parent),
-        new Mountain("Monadh Mor", 57.026799, -3.750067, 1113, m_parent),
-        new Mountain("Beinn Bhrotain", 57.009868, -3.723795, 1157, m_parent),
-        new Mountain("Carn a' Mhaim", 57.03687, -3.658383, 1037, m_parent),
-        new Mountain("Ben Macdui [Beinn Macduibh]", 57.070366, -3.669099, 1309, m_parent),
-        new Mountain("Cairn Gorm", 57.11671, -3.644478, 1244.8, m_parent),
-        new Mountain("Bynack More", 57.138216, -3.58472, 1090, m_parent),
-        new Mountain("Beinn Mheadhoin", 57.095846, -3.611466, 1182.9, m_parent),
-        new Mountain("Derry Cairngorm", 57.0628, -3.622006, 1155, m_parent),
-        new Mountain("Beinn Bhreac", 57.055071, -3.553475, 931, m_parent),
-        new Mountain("Beinn a' Chaorainn", 57.093269, -3.577437, 1083, m_parent),
-        new Mountain("Leabaidh an Daimh Bhuidhe (Ben Avon)", 57.099345, -3.434445, 1172, m_parent),
-        new Mountain("Beinn a' Bhuird North Top", 57.087589, -3.499371, 1197, m_parent),
-        new Mountain("Geal Charn", 57.057422, -4.37357, 926, m_parent),
-        new Mountain("Carn Dearg", 57.092264, -4.253247, 945.7, m_parent),
-        new Mountain("A' Chailleach", 57.109567, -4.179288, 929.3, m_parent),
-        new Mountain("Carn Sgulain", 57.124371, -4.176986, 920.3, m_parent),
-        new Mountain("Creag Meagaidh", 56.952019, -4.602122, 1128.1, m_parent),
-        new Mountain("Stob Poite Coire Ardair", 56.964041, -4.585769, 1054, m_parent),
-        new Mountain("Carn Liath", 56.97878, -4.51528, 1006, m_parent),
-        new Mountain("Beinn a' Chaorainn", 56.92862, -4.653647, 1049.1, m_parent),
-        new Mountain("Beinn Teallach", 56.935927, -4.694757, 914.6, m_parent),
-        new Mountain("Gleouraich", 57.097161, -5.238028, 1035, m_parent),
-        new Mountain("Sgurr a' Mhaoraich", 57.105845, -5.330516, 1027, m_parent),
-        new Mountain("Spidean Mialach", 57.088962, -5.193608, 996, m_parent),
-        new Mountain("The Saddle", 57.162395, -5.414721, 1011.5, m_parent),
-        new Mountain("Sgurr na Sgine", 57.147101, -5.39664, 946, m_parent),
-        new Mountain("Creag a' Mhaim", 57.120968, -5.160044, 946.2, m_parent),
-        new Mountain("Druim Shionnach", 57.126791, -5.182836, 985.2, m_parent),
-        new Mountain("Aonach air Chrith", 57.12464, -5.221291, 1019.5, m_parent),
-        new Mountain("Maol Chinn-dearg", 57.12756, -5.252651, 980.3, m_parent),
-        new Mountain("Sgurr an Doire Leathain", 57.136883, -5.281525, 1010, m_parent),
-        new Mountain("Sgurr an Lochain", 57.1413, -5.297476, 1004, m_parent),
-        new Mountain("Creag nan Damh", 57.147266, -5.334969, 917.2, m_parent),
-        new Mountain("Beinn Sgritheall", 57.153815, -5.579712, 974, m_parent),
-        new Mountain("Sgurr na Ciche", 57.013465, -5.456907, 1040.2, m_parent),
-        new Mountain("Garbh Chioch Mhor", 57.008553, -5.444324, 1012.9, m_parent),
-        new Mountain("Sgurr nan Coireachan", 57.007155, -5.405443, 953.8, m_parent),
-        new Mountain("Sgurr Mor", 57.028444, -5.354195, 1003, m_parent),
-        new Mountain("Gairich", 57.044877, -5.255835, 919, m_parent),
-        new Mountain("Meall Buidhe", 57.031556, -5.546334, 946, m_parent),
-        new Mountain("Ladhar Bheinn", 57.075265, -5.591744, 1020, m_parent),
-        new Mountain("Luinne Bheinn", 57.048329, -5.513609, 939, m_parent),
-        new Mountain("Sron a' Choire Ghairbh", 57.00784, -4.928745, 937, m_parent),
-        new Mountain("Meall na Teanga", 56.989012, -4.930953, 916.8, m_parent),
-        new Mountain("Gulvain [Gaor Bheinn]", 56.936212, -5.284515, 987, m_parent),
-        new Mountain("Sgurr Thuilm", 56.937055, -5.389209, 963, m_parent),
-        new Mountain("Sgurr nan Coireachan", 56.935727, -5.448552, 956, m_parent),
-        new Mountain("Sgurr Fhuaran", 57.196153, -5.347642, 1068.8, m_parent),
-        new Mountain("Sgurr na Carnach", 57.189036, -5.349216, 1002, m_parent),
-        new Mountain("Sgurr na Ciste Duibhe", 57.180927, -5.337127, 1027, m_parent),
-        new Mountain("Saileag", 57.181267, -5.281325, 956, m_parent),
-        new Mountain("Sgurr a' Bhealaich Dheirg", 57.177829, -5.252172, 1036, m_parent),
-        new Mountain("Aonach Meadhoin", 57.173031, -5.229161, 1001, m_parent),
-        new Mountain("Ciste Dhubh", 57.199237, -5.209028, 981.1, m_parent),
-        new Mountain("Beinn Fhada", 57.221004, -5.283497, 1031.9, m_parent),
-        new Mountain("A' Ghlas-bheinn", 57.255082, -5.303681, 918, m_parent),
-        new Mountain("Sgurr nan Ceathramhnan [Sgurr nan Ceathreamhnan]", 57.254912, -5.222729, 1151, m_parent),
-        new Mountain("Mullach na Dheiragain", 57.2834, -5.186348, 982, m_parent),
-        new Mountain("An Socach", 57.257552, -5.17131, 919.7, m_parent),
-        new Mountain("Mam Sodhail", 57.279801, -5.120267, 1179.4, m_parent),
-        new Mountain("Carn Eighe", 57.287702, -5.11516, 1182.8, m_parent),
-        new Mountain("Beinn Fhionnlaidh", 57.305978, -5.12991, 1004.8, m_parent),
-        new Mountain("Tom a' Choinich", 57.299519, -5.048961, 1112, m_parent),
-        new Mountain("Toll Creagach", 57.309228, -4.999957, 1054, m_parent),
-        new Mountain("Mullach Fraoch-choire", 57.205382, -5.15565, 1102, m_parent),
-        new Mountain("A' Chraileag [A' Chralaig]", 57.18419, -5.154834, 1120, m_parent),
-        new Mountain("Sail Chaorainn", 57.191626, -5.091198, 999.2, m_parent),
-        new Mountain("Sgurr nan Conbhairean", 57.177626, -5.095406, 1109, m_parent),
-        new Mountain("Carn Ghluasaid", 57.165955, -5.068157, 957, m_parent),
-        new Mountain("Sgurr na Ruaidhe", 57.441497, -4.852458, 993, m_parent),
-        new Mountain("Carn nan Gobhar", 57.452331, -4.879928, 992, m_parent),
-        new Mountain("Sgurr a' Choire Ghlais", 57.444288, -4.903765, 1083, m_parent),
-        new Mountain("Sgurr Fhuar-thuill", 57.449679, -4.941787, 1049, m_parent),
-        new Mountain("Moruisg", 57.499716, -5.170635, 928, m_parent),
-        new Mountain("Maoile Lunndaidh", 57.464477, -5.111002, 1004.9, m_parent),
-        new Mountain("Sgurr a' Chaorachain", 57.452497, -5.189303, 1053, m_parent),
-        new Mountain("Sgurr Choinnich", 57.451026, -5.207916, 999.3, m_parent),
-        new Mountain("Bidein a' Choire Sheasgaich", 57.419716, -5.250473, 945, m_parent),
-        new Mountain("Lurg Mhor", 57.413088, -5.223667, 987, m_parent),
-        new Mountain("Carn nan Gobhar", 57.363303, -5.024549, 993, m_parent),
-        new Mountain("Sgurr na Lapaich", 57.36931, -5.059729, 1151, m_parent),
-        new Mountain("An Riabhachan", 57.362437, -5.104731, 1129, m_parent),
-        new Mountain("An Socach", 57.350228, -5.158604, 1069, m_parent),
-        new Mountain("Sgurr Mhor (Beinn Alligin)", 57.590819, -5.572759, 986, m_parent),
-        new Mountain("Tom na Gruagaich (Beinn Alligin)", 57.580518, -5.581907, 922, m_parent),
-        new Mountain("Spidean a' Choire Leith (Liathach)", 57.564189, -5.463605, 1054.8, m_parent),
-        new Mountain("Mullach an Rathain (Liathach)", 57.560875, -5.492494, 1023.8, m_parent),
-        new Mountain("Ruadh-stac Mor (Beinn Eighe)", 57.593735, -5.429453, 1010, m_parent),
-        new Mountain("Spidean Coire nan Clach (Beinn Eighe)", 57.582099, -5.403706, 993, m_parent),
-        new Mountain("Sgorr Ruadh", 57.498625, -5.407744, 960.7, m_parent),
-        new Mountain("Maol Chean-dearg", 57.491699, -5.465544, 933, m_parent),
-        new Mountain("Beinn Liath Mhor", 57.512085, -5.400616, 926, m_parent),
-        new Mountain("Slioch", 57.667175, -5.347051, 981, m_parent),
-        new Mountain("Ruadh Stac Mor", 57.726781, -5.329288, 918.7, m_parent),
-        new Mountain("A' Mhaighdean", 57.719651, -5.346725, 967, m_parent),
-        new Mountain("Beinn Tarsuinn", 57.70205, -5.291639, 933.8, m_parent),
-        new Mountain("Mullach Coire Mhic Fhearchair", 57.709022, -5.271348, 1015.2, m_parent),
-        new Mountain("Sgurr Ban", 57.718537, -5.265908, 989, m_parent),
-        new Mountain("Bidein a' Ghlas Thuill (An Teallach)", 57.807095, -5.251774, 1062.5, m_parent),
-        new Mountain("Sgurr Fiona (An Teallach)", 57.800723, -5.259449, 1058.7, m_parent),
-        new Mountain("A' Chailleach", 57.693774, -5.12872, 998.6, m_parent),
-        new Mountain("Sgurr Breac", 57.691944, -5.091318, 999.6, m_parent),
-        new Mountain("Meall a' Chrasgaidh", 57.712868, -5.048734, 934, m_parent),
-        new Mountain("Sgurr nan Clach Geala", 57.69628, -5.048245, 1093, m_parent),
-        new Mountain("Sgurr nan Each", 57.68101, -5.046358, 923, m_parent),
-        new Mountain("Sgurr Mor", 57.700136, -5.016757, 1108.9, m_parent),
-        new Mountain("Beinn Liath Mhor Fannaich", 57.706097, -4.989768, 954, m_parent),
-        new Mountain("Meall Gorm", 57.68084, -4.983794, 949.7, m_parent),
-        new Mountain("An Coileachan", 57.667625, -4.949499, 924, m_parent),
-        new Mountain("Fionn Bheinn", 57.611151, -5.102719, 933, m_parent),
-        new Mountain("Am Faochagach", 57.771803, -4.853896, 953, m_parent),
-        new Mountain("Cona' Mheall", 57.791078, -4.903413, 978, m_parent),
-        new Mountain("Beinn Dearg", 57.786351, -4.929552, 1084, m_parent),
-        new Mountain("Meall nan Ceapraichean", 57.798515, -4.934007, 977, m_parent),
-        new Mountain("Eididh nan Clach Geala", 57.813501, -4.934198, 927, m_parent),
-        new Mountain("Seana Bhraigh", 57.84733, -4.896616, 926, m_parent),
-        new Mountain("Glas Leathad Mor (Ben Wyvis)", 57.678911, -4.579252, 1046, m_parent),
-        new Mountain("Ben Hope", 58.413114, -4.607863, 927, m_parent),
-        new Mountain("Ben Klibreck - Meall nan Con", 58.235202, -4.41113, 962.1, m_parent),
-        new Mountain("Ben More Assynt", 58.138166, -4.858216, 998, m_parent),
-        new Mountain("Conival", 58.135691, -4.883505, 987, m_parent),
-        new Mountain("Sgurr nan Gillean", 57.248216, -6.193162, 966.1, m_parent),
-        new Mountain("Am Basteir", 57.247942, -6.202968, 934, m_parent),
-        new Mountain("Bruach na Frithe", 57.246745, -6.210778, 958.8, m_parent),
-        new Mountain("Sgurr a' Mhadaidh", 57.230871, -6.231932, 918, m_parent),
-        new Mountain("Sgurr a' Ghreadaidh", 57.227315, -6.234426, 972.1, m_parent),
-        new Mountain("Sgurr na Banachdich", 57.220974, -6.241638, 965, m_parent),
-        new Mountain("Sgurr Dearg - Inaccessible Pinnacle", 57.213255, -6.234818, 985.8, m_parent),
-        new Mountain("Sgurr Mhic Choinnich", 57.20893, -6.224113, 948.1, m_parent),
-        new Mountain("Sgurr Alasdair", 57.20659, -6.224176, 992, m_parent),
-        new Mountain("Sgurr Dubh Mor", 57.204897, -6.211422, 944, m_parent),
-        new Mountain("Sgurr nan Eag", 57.19581, -6.211264, 926.3, m_parent),
-        new Mountain("Blabheinn [Bla Bheinn]", 57.219567, -6.093215, 929, m_parent),
-        new Mountain("Ben More", 56.424829, -6.014016, 966, m_parent)
-    };
-};
-
-#endif // MOUNTAINLOCATIONS_H
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOUNTAINLOCATIONS_H
+#define MOUNTAINLOCATIONS_H
+
+#include <QList>
+#include <QObject>
+
+#include "Mountain.h"
+
+Q_MOC_INCLUDE("MountainLocations.h")
+
+class MountainLocations : public QObject
+{
+  Q_OBJECT
+
+public:
+    explicit MountainLocations(QObject* parent = nullptr):
+      m_parent(parent){}
+
+    const QList<Mountain*> getLocations() const
+    {
+        return m_scottishMunroLocations;
+    }
+
+private:
+    QObject* m_parent = nullptr;
+
+    const QList<Mountain*> m_scottishMunroLocations {
+        new Mountain("Ben Chonzie", 56.453847, -3.992056, 931, m_parent),
+        new Mountain("Ben Vorlich", 56.342678, -4.219454, 985.3, m_parent),
+        new Mountain("Stuc a' Chroin", 56.329313, -4.237539, 973, m_parent),
+        new Mountain("Ben Lomond", 56.190293, -4.633016, 973.7, m_parent),
+        new Mountain("Ben More", 56.385956, -4.540084, 1174, m_parent),
+        new Mountain("Stob Binnein", 56.370721, -4.535749, 1165, m_parent),
+        new Mountain("Cruach Ardrain", 56.356433, -4.576146, 1045.9, m_parent),
+        new Mountain("An Caisteal", 56.338596, -4.624361, 995.9, m_parent),
+        new Mountain("Beinn Tulaichean", 56.34222, -4.563326, 945.8, m_parent),
+        new Mountain("Beinn a' Chroin", 56.331987, -4.609638, 941.4, m_parent),
+        new Mountain("Beinn Chabhair", 56.325775, -4.641485, 932.2, m_parent),
+        new Mountain("Ben Lui [Beinn Laoigh]", 56.397005, -4.810513, 1131.4, m_parent),
+        new Mountain("Ben Oss", 56.389274, -4.775494, 1029, m_parent),
+        new Mountain("Beinn Dubhchraig", 56.391297, -4.743199, 978, m_parent),
+        new Mountain("Beinn a' Chleibh", 56.390231, -4.835632, 916.3, m_parent),
+        new Mountain("Ben Vorlich", 56.274018, -4.75505, 943, m_parent),
+        new Mountain("Beinn Ime", 56.236792, -4.817126, 1012.2, m_parent),
+        new Mountain("Ben Vane", 56.249783, -4.781658, 915.76, m_parent),
+        new Mountain("Beinn Narnain", 56.220954, -4.789006, 927, m_parent),
+        new Mountain("Beinn Bhuidhe", 56.326662, -4.906722, 948.5, m_parent),
+        new Mountain("Schiehallion", 56.66693, -4.100228, 1083, m_parent),
+        new Mountain("Carn Mairg", 56.634633, -4.145605, 1042, m_parent),
+        new Mountain("Carn Gorm", 56.622535, -4.226015, 1029, m_parent),
+        new Mountain("Meall Garbh", 56.637378, -4.207468, 968, m_parent),
+        new Mountain("Meall na Aighean", 56.620626, -4.128738, 981, m_parent),
+        new Mountain("Stuc an Lochain [Stuchd an Lochain]", 56.570905, -4.470605, 960, m_parent),
+        new Mountain("Meall Buidhe", 56.617226, -4.448644, 932.1, m_parent),
+        new Mountain("Beinn Dorain", 56.502868, -4.72215, 1076, m_parent),
+        new Mountain("Beinn an Dothaidh", 56.530127, -4.713958, 1004, m_parent),
+        new Mountain("Beinn Achaladair", 56.551887, -4.694525, 1038.6, m_parent),
+        new Mountain("Beinn a' Chreachain", 56.560382, -4.647618, 1080.6, m_parent),
+        new Mountain("Beinn Mhanach", 56.534038, -4.646038, 953, m_parent),
+        new Mountain("Ben Lawers", 56.544922, -4.220853, 1214, m_parent),
+        new Mountain("An Stuc", 56.560093, -4.216258, 1117.1, m_parent),
+        new Mountain("Meall Garbh", 56.566122, -4.207707, 1123.1, m_parent),
+        new Mountain("Meall Greigh", 56.567426, -4.159554, 1001, m_parent),
+        new Mountain("Beinn Ghlas", 56.535997, -4.236985, 1103, m_parent),
+        new Mountain("Meall Corranaich", 56.540947, -4.253461, 1069, m_parent),
+        new Mountain("Meall a' Choire Leith", 56.566312, -4.259609, 925.6, m_parent),
+        new Mountain("Meall nan Tarmachan", 56.521656, -4.301349, 1043.6, m_parent),
+        new Mountain("Meall Ghaordaidh", 56.52581, -4.416657, 1039.8, m_parent),
+        new Mountain("Beinn Sheasgarnaich [Beinn Heasgarnich]", 56.510271, -4.579216, 1077.4, m_parent),
+        new Mountain("Creag Mhor", 56.489518, -4.614034, 1046.8, m_parent),
+        new Mountain("Beinn Challuim [Ben Challum]", 56.454574, -4.619179, 1025, m_parent),
+        new Mountain("Meall Glas", 56.455713, -4.546818, 959, m_parent),
+        new Mountain("Sgiath Chuil", 56.453149, -4.495653, 920.1, m_parent),
+        new Mountain("Sgorr nam Fiannaidh (Aonach Eagach)", 56.679368, -5.037129, 967.7, m_parent),
+        new Mountain("Meall Dearg (Aonach Eagach)", 56.68072, -5.003271, 952.3, m_parent),
+        new Mountain("Stob Dearg (Buachaille Etive Mor)", 56.646229, -4.900337, 1021.4, m_parent),
+        new Mountain("Stob na Broige (Buachaille Etive Mor)", 56.62988, -4.951151, 953.4, m_parent),
+        new Mountain("Stob Dubh (Buachaille Etive Beag)", 56.638159, -4.970752, 958, m_parent),
+        new Mountain("Stob Coire Raineach (Buachaille Etive Beag) ", 56.649895, -4.951607, 924.5, m_parent),
+        new Mountain("Bidean nam Bian", 56.642768, -5.029338, 1149.4, m_parent),
+        new Mountain("Stob Coire Sgreamhach", 56.638314, -5.010287, 1072, m_parent),
+        new Mountain("Sgorr Dhearg (Beinn a' Bheithir)", 56.653921, -5.171509, 1024, m_parent),
+        new Mountain("Sgorr Dhonuill (Beinn a' Bheithir)", 56.650498, -5.197755, 1001, m_parent),
+        new Mountain("Sgurr na h-Ulaidh [Sgor na h-Ulaidh]", 56.619797, -5.08006, 994, m_parent),
+        new Mountain("Beinn Fhionnlaidh", 56.60098, -5.104748, 959, m_parent),
+        new Mountain("Beinn Sgulaird", 56.566235, -5.170363, 937, m_parent),
+        new Mountain("Ben Cruachan", 56.426839, -5.131828, 1127, m_parent),
+        new Mountain("Stob Daimh [Stob Diamh]", 56.431325, -5.091313, 999.2, m_parent),
+        new Mountain("Beinn Eunaich", 56.450351, -5.026636, 989, m_parent),
+        new Mountain("Beinn a' Chochuill", 56.449779, -5.068531, 980, m_parent),
+        new Mountain("Beinn nan Aighenan", 56.520217, -5.011249, 960, m_parent),
+        new Mountain("Ben Starav", 56.538926, -5.049747, 1079.5, m_parent),
+        new Mountain("Glas Bheinn Mhor", 56.54242, -5.005268, 997.7, m_parent),
+        new Mountain("Stob Coir' an Albannaich", 56.554907, -4.979811, 1044, m_parent),
+        new Mountain("Meall nan Eun", 56.561179, -4.94293, 928, m_parent),
+        new Mountain("Stob Ghabhar", 56.568106, -4.882105, 1090, m_parent),
+        new Mountain("Stob a' Choire Odhair", 56.573312, -4.83831, 945, m_parent),
+        new Mountain("Creise", 56.614449, -4.871995, 1099.8, m_parent),
+        new Mountain("Meall a' Bhuiridh", 56.612219, -4.852119, 1107.9, m_parent),
+        new Mountain("Ben Nevis", 56.796887, -5.003683, 1344.53, m_parent),
+        new Mountain("Aonach Beag", 56.799995, -4.954114, 1234, m_parent),
+        new Mountain("Aonach Mor", 56.812938, -4.961705, 1220.4, m_parent),
+        new Mountain("Carn Mor Dearg", 56.805242, -4.986624, 1220, m_parent),
+        new Mountain("Sgurr Choinnich Mor", 56.800427, -4.903954, 1094, m_parent),
+        new Mountain("Stob Coire an Laoigh", 56.810874, -4.884886, 1116, m_parent),
+        new Mountain("Stob Choire Claurigh", 56.823783, -4.849621, 1177, m_parent),
+        new Mountain("Stob Ban", 56.810653, -4.840873, 977, m_parent),
+        new Mountain("Stob Coire Easain", 56.818196, -4.773709, 1115, m_parent),
+        new Mountain("Stob a' Choire Mheadhoin", 56.823682, -4.760182, 1105, m_parent),
+        new Mountain("Sgurr Eilde Mor", 56.750013, -4.89543, 1010, m_parent),
+        new Mountain("Binnein Beag", 56.766958, -4.911155, 943, m_parent),
+        new Mountain("Binnein Mor", 56.754373, -4.925789, 1130, m_parent),
+        new Mountain("Na Gruagaichean", 56.743687, -4.939875, 1054.3, m_parent),
+        new Mountain("An Gearanach", 56.759169, -4.966238, 981.5, m_parent),
+        new Mountain("Stob Coire a' Chairn", 56.750754, -4.968993, 981.3, m_parent),
+        new Mountain("Am Bodach", 56.741727, -4.983394, 1031.8, m_parent),
+        new Mountain("Sgurr a' Mhaim", 56.755917, -5.003697, 1099, m_parent),
+        new Mountain("Stob Ban", 56.743704, -5.030333, 999.7, m_parent),
+        new Mountain("Mullach nan Coirean", 56.749863, -5.07245, 939.3, m_parent),
+        new Mountain("Stob Coire Sgriodain", 56.831742, -4.694919, 979, m_parent),
+        new Mountain("Chno Dearg", 56.830083, -4.660833, 1046, m_parent),
+        new Mountain("Beinn na Lap", 56.789388, -4.659995, 935, m_parent),
+        new Mountain("Carn Dearg", 56.75993, -4.589892, 941, m_parent),
+        new Mountain("Sgor Gaibhre", 56.772553, -4.546503, 955, m_parent),
+        new Mountain("Beinn Eibhinn", 56.825254, -4.542082, 1103.3, m_parent),
+        new Mountain("Aonach Beag", 56.833496, -4.529181, 1115.8, m_parent),
+        new Mountain("Geal-Charn", 56.837835, -4.509701, 1132, m_parent),
+        new Mountain("Carn Dearg", 56.85524, -4.454701, 1034, m_parent),
+        new Mountain("Beinn a' Chlachair", 56.869523, -4.509691, 1087, m_parent),
+        new Mountain("Creag Pitridh", 56.89971, -4.484947, 924, m_parent),
+        new Mountain("Geal Charn", 56.897761, -4.457228, 1049, m_parent),
+        new Mountain("Ben Alder", 56.813795, -4.465097, 1148, m_parent),
+        new Mountain("Beinn Bheoil", 56.813276, -4.430655, 1019, m_parent),
+        new Mountain("Beinn Udlamain", 56.835444, -4.329972, 1010.2, m_parent),
+        new Mountain("Sgairneach Mhor", 56.828448, -4.297788, 991, m_parent),
+        new Mountain("A' Mharconaich", 56.857002, -4.290665, 973.2, m_parent),
+        new Mountain("Geal-charn", 56.874432, -4.304515, 917.1, m_parent),
+        new Mountain("Meall Chuaich", 56.963849, -4.112571, 951, m_parent),
+        new Mountain("Carn na Caim", 56.911739, -4.174478, 940.8, m_parent),
+        new Mountain("A' Bhuidheanach Bheag", 56.870342, -4.199, 936.1, m_parent),
+        new Mountain("Beinn Dearg", 56.877349, -3.883712, 1008.7, m_parent),
+        new Mountain("An Sgarsoch", 56.932111, -3.75429, 1006.5, m_parent),
+        new Mountain("Carn an Fhidhleir [Carn Ealar]", 56.936021, -3.80153, 994, m_parent),
+        new Mountain("Carn a' Chlamain", 56.860968, -3.77963, 963.5, m_parent),
+        new Mountain("Carn nan Gabhar (Beinn a' Ghlo)", 56.83984, -3.688052, 1121.9, m_parent),
+        new Mountain("Braigh Coire Chruinn-bhalgain (Beinn a' Ghlo)", 56.831087, -3.729501, 1070, m_parent),
+        new Mountain("Carn Liath (Beinn a' Ghlo)", 56.807766, -3.744085, 976, m_parent),
+        new Mountain("Glas Tulaichean", 56.865761, -3.558164, 1051, m_parent),
+        new Mountain("Carn an Righ", 56.876587, -3.595272, 1029, m_parent),
+        new Mountain("Beinn Iutharn Mhor", 56.894997, -3.56823, 1045, m_parent),
+        new Mountain("Carn Bhac", 56.930543, -3.560881, 945.1, m_parent),
+        new Mountain("An Socach", 56.902298, -3.513167, 944, m_parent),
+        new Mountain("Carn a' Gheoidh", 56.873061, -3.466619, 975, m_parent),
+        new Mountain("The Cairnwell", 56.879515, -3.421203, 933, m_parent),
+        new Mountain("Carn Aosda", 56.8957, -3.423279, 915.3, m_parent),
+        new Mountain("Cac Carn Beag (Lochnagar)", 56.960274, -3.245254, 1155.7, m_parent),
+        new Mountain("Carn a' Choire Bhoidheach", 56.945776, -3.272699, 1109.9, m_parent),
+        new Mountain("Carn an t-Sagairt Mor", 56.942973, -3.303227, 1047, m_parent),
+        new Mountain("Glas Maol", 56.873063, -3.368242, 1068, m_parent),
+        new Mountain("Creag Leacach", 56.854627, -3.387756, 988.2, m_parent),
+        new Mountain("Cairn of Claise", 56.894174, -3.338644, 1064, m_parent),
+        new Mountain("Carn an Tuirc", 56.908277, -3.357131, 1019, m_parent),
+        new Mountain("Tom Buidhe", 56.893619, -3.292364, 957, m_parent),
+        new Mountain("Tolmount", 56.904737, -3.297937, 958, m_parent),
+        new Mountain("Cairn Bannoch", 56.927732, -3.278411, 1012, m_parent),
+        new Mountain("Broad Cairn", 56.919152, -3.249074, 998, m_parent),
+        new Mountain("Mayar", 56.848932, -3.246291, 928, m_parent),
+        new Mountain("Driesh", 56.847981, -3.196531, 947, m_parent),
+        new Mountain("Mount Keen", 56.969754, -2.973622, 939, m_parent),
+        new Mountain("Mullach Clach a' Bhlair", 57.011878, -3.841282, 1019, m_parent),
+        new Mountain("Sgor Gaoith", 57.068558, -3.810853, 1118, m_parent),
+        new Mountain("Braeriach", 57.078304, -3.728372, 1296, m_parent),
+        new Mountain("Sgor an Lochain Uaine", 57.058365, -3.725895, 1258, m_parent),
+        new Mountain("Cairn Toul", 57.054404, -3.710773, 1291, m_parent),
+        new Mountain("The Devil's Point", 57.035709, -3.688802, 1006.9, m_parent),
+        new Mountain("Monadh Mor", 57.026799, -3.750067, 1113, m_parent),
+        new Mountain("Beinn Bhrotain", 57.009868, -3.723795, 1157, m_parent),
+        new Mountain("Carn a' Mhaim", 57.03687, -3.658383, 1037, m_parent),
+        new Mountain("Ben Macdui [Beinn Macduibh]", 57.070366, -3.669099, 1309, m_parent),
+        new Mountain("Cairn Gorm", 57.11671, -3.644478, 1244.8, m_parent),
+        new Mountain("Bynack More", 57.138216, -3.58472, 1090, m_parent),
+        new Mountain("Beinn Mheadhoin", 57.095846, -3.611466, 1182.9, m_parent),
+        new Mountain("Derry Cairngorm", 57.0628, -3.622006, 1155, m_parent),
+        new Mountain("Beinn Bhreac", 57.055071, -3.553475, 931, m_parent),
+        new Mountain("Beinn a' Chaorainn", 57.093269, -3.577437, 1083, m_parent),
+        new Mountain("Leabaidh an Daimh Bhuidhe (Ben Avon)", 57.099345, -3.434445, 1172, m_parent),
+        new Mountain("Beinn a' Bhuird North Top", 57.087589, -3.499371, 1197, m_parent),
+        new Mountain("Geal Charn", 57.057422, -4.37357, 926, m_parent),
+        new Mountain("Carn Dearg", 57.092264, -4.253247, 945.7, m_parent),
+        new Mountain("A' Chailleach", 57.109567, -4.179288, 929.3, m_parent),
+        new Mountain("Carn Sgulain", 57.124371, -4.176986, 920.3, m_parent),
+        new Mountain("Creag Meagaidh", 56.952019, -4.602122, 1128.1, m_parent),
+        new Mountain("Stob Poite Coire Ardair", 56.964041, -4.585769, 1054, m_parent),
+        new Mountain("Carn Liath", 56.97878, -4.51528, 1006, m_parent),
+        new Mountain("Beinn a' Chaorainn", 56.92862, -4.653647, 1049.1, m_parent),
+        new Mountain("Beinn Teallach", 56.935927, -4.694757, 914.6, m_parent),
+        new Mountain("Gleouraich", 57.097161, -5.238028, 1035, m_parent),
+        new Mountain("Sgurr a' Mhaoraich", 57.105845, -5.330516, 1027, m_parent),
+        new Mountain("Spidean Mialach", 57.088962, -5.193608, 996, m_parent),
+        new Mountain("The Saddle", 57.162395, -5.414721, 1011.5, m_parent),
+        new Mountain("Sgurr na Sgine", 57.147101, -5.39664, 946, m_parent),
+        new Mountain("Creag a' Mhaim", 57.120968, -5.160044, 946.2, m_parent),
+        new Mountain("Druim Shionnach", 57.126791, -5.182836, 985.2, m_parent),
+        new Mountain("Aonach air Chrith", 57.12464, -5.221291, 1019.5, m_parent),
+        new Mountain("Maol Chinn-dearg", 57.12756, -5.252651, 980.3, m_parent),
+        new Mountain("Sgurr an Doire Leathain", 57.136883, -5.281525, 1010, m_parent),
+        new Mountain("Sgurr an Lochain", 57.1413, -5.297476, 1004, m_parent),
+        new Mountain("Creag nan Damh", 57.147266, -5.334969, 917.2, m_parent),
+        new Mountain("Beinn Sgritheall", 57.153815, -5.579712, 974, m_parent),
+        new Mountain("Sgurr na Ciche", 57.013465, -5.456907, 1040.2, m_parent),
+        new Mountain("Garbh Chioch Mhor", 57.008553, -5.444324, 1012.9, m_parent),
+        new Mountain("Sgurr nan Coireachan", 57.007155, -5.405443, 953.8, m_parent),
+        new Mountain("Sgurr Mor", 57.028444, -5.354195, 1003, m_parent),
+        new Mountain("Gairich", 57.044877, -5.255835, 919, m_parent),
+        new Mountain("Meall Buidhe", 57.031556, -5.546334, 946, m_parent),
+        new Mountain("Ladhar Bheinn", 57.075265, -5.591744, 1020, m_parent),
+        new Mountain("Luinne Bheinn", 57.048329, -5.513609, 939, m_parent),
+        new Mountain("Sron a' Choire Ghairbh", 57.00784, -4.928745, 937, m_parent),
+        new Mountain("Meall na Teanga", 56.989012, -4.930953, 916.8, m_parent),
+        new Mountain("Gulvain [Gaor Bheinn]", 56.936212, -5.284515, 987, m_parent),
+        new Mountain("Sgurr Thuilm", 56.937055, -5.389209, 963, m_parent),
+        new Mountain("Sgurr nan Coireachan", 56.935727, -5.448552, 956, m_parent),
+        new Mountain("Sgurr Fhuaran", 57.196153, -5.347642, 1068.8, m_parent),
+        new Mountain("Sgurr na Carnach", 57.189036, -5.349216, 1002, m_parent),
+        new Mountain("Sgurr na Ciste Duibhe", 57.180927, -5.337127, 1027, m_parent),
+        new Mountain("Saileag", 57.181267, -5.281325, 956, m_parent),
+        new Mountain("Sgurr a' Bhealaich Dheirg", 57.177829, -5.252172, 1036, m_parent),
+        new Mountain("Aonach Meadhoin", 57.173031, -5.229161, 1001, m_parent),
+        new Mountain("Ciste Dhubh", 57.199237, -5.209028, 981.1, m_parent),
+        new Mountain("Beinn Fhada", 57.221004, -5.283497, 1031.9, m_parent),
+        new Mountain("A' Ghlas-bheinn", 57.255082, -5.303681, 918, m_parent),
+        new Mountain("Sgurr nan Ceathramhnan [Sgurr nan Ceathreamhnan]", 57.254912, -5.222729, 1151, m_parent),
+        new Mountain("Mullach na Dheiragain", 57.2834, -5.186348, 982, m_parent),
+        new Mountain("An Socach", 57.257552, -5.17131, 919.7, m_parent),
+        new Mountain("Mam Sodhail", 57.279801, -5.120267, 1179.4, m_parent),
+        new Mountain("Carn Eighe", 57.287702, -5.11516, 1182.8, m_parent),
+        new Mountain("Beinn Fhionnlaidh", 57.305978, -5.12991, 1004.8, m_parent),
+        new Mountain("Tom a' Choinich", 57.299519, -5.048961, 1112, m_parent),
+        new Mountain("Toll Creagach", 57.309228, -4.999957, 1054, m_parent),
+        new Mountain("Mullach Fraoch-choire", 57.205382, -5.15565, 1102, m_parent),
+        new Mountain("A' Chraileag [A' Chralaig]", 57.18419, -5.154834, 1120, m_parent),
+        new Mountain("Sail Chaorainn", 57.191626, -5.091198, 999.2, m_parent),
+        new Mountain("Sgurr nan Conbhairean", 57.177626, -5.095406, 1109, m_parent),
+        new Mountain("Carn Ghluasaid", 57.165955, -5.068157, 957, m_parent),
+        new Mountain("Sgurr na Ruaidhe", 57.441497, -4.852458, 993, m_parent),
+        new Mountain("Carn nan Gobhar", 57.452331, -4.879928, 992, m_parent),
+        new Mountain("Sgurr a' Choire Ghlais", 57.444288, -4.903765, 1083, m_parent),
+        new Mountain("Sgurr Fhuar-thuill", 57.449679, -4.941787, 1049, m_parent),
+        new Mountain("Moruisg", 57.499716, -5.170635, 928, m_parent),
+        new Mountain("Maoile Lunndaidh", 57.464477, -5.111002, 1004.9, m_parent),
+        new Mountain("Sgurr a' Chaorachain", 57.452497, -5.189303, 1053, m_parent),
+        new Mountain("Sgurr Choinnich", 57.451026, -5.207916, 999.3, m_parent),
+        new Mountain("Bidein a' Choire Sheasgaich", 57.419716, -5.250473, 945, m_parent),
+        new Mountain("Lurg Mhor", 57.413088, -5.223667, 987, m_parent),
+        new Mountain("Carn nan Gobhar", 57.363303, -5.024549, 993, m_parent),
+        new Mountain("Sgurr na Lapaich", 57.36931, -5.059729, 1151, m_parent),
+        new Mountain("An Riabhachan", 57.362437, -5.104731, 1129, m_parent),
+        new Mountain("An Socach", 57.350228, -5.158604, 1069, m_parent),
+        new Mountain("Sgurr Mhor (Beinn Alligin)", 57.590819, -5.572759, 986, m_parent),
+        new Mountain("Tom na Gruagaich (Beinn Alligin)", 57.580518, -5.581907, 922, m_parent),
+        new Mountain("Spidean a' Choire Leith (Liathach)", 57.564189, -5.463605, 1054.8, m_parent),
+        new Mountain("Mullach an Rathain (Liathach)", 57.560875, -5.492494, 1023.8, m_parent),
+        new Mountain("Ruadh-stac Mor (Beinn Eighe)", 57.593735, -5.429453, 1010, m_parent),
+        new Mountain("Spidean Coire nan Clach (Beinn Eighe)", 57.582099, -5.403706, 993, m_parent),
+        new Mountain("Sgorr Ruadh", 57.498625, -5.407744, 960.7, m_parent),
+        new Mountain("Maol Chean-dearg", 57.491699, -5.465544, 933, m_parent),
+        new Mountain("Beinn Liath Mhor", 57.512085, -5.400616, 926, m_parent),
+        new Mountain("Slioch", 57.667175, -5.347051, 981, m_parent),
+        new Mountain("Ruadh Stac Mor", 57.726781, -5.329288, 918.7, m_parent),
+        new Mountain("A' Mhaighdean", 57.719651, -5.346725, 967, m_parent),
+        new Mountain("Beinn Tarsuinn", 57.70205, -5.291639, 933.8, m_parent),
+        new Mountain("Mullach Coire Mhic Fhearchair", 57.709022, -5.271348, 1015.2, m_parent),
+        new Mountain("Sgurr Ban", 57.718537, -5.265908, 989, m_parent),
+        new Mountain("Bidein a' Ghlas Thuill (An Teallach)", 57.807095, -5.251774, 1062.5, m_parent),
+        new Mountain("Sgurr Fiona (An Teallach)", 57.800723, -5.259449, 1058.7, m_parent),
+        new Mountain("A' Chailleach", 57.693774, -5.12872, 998.6, m_parent),
+        new Mountain("Sgurr Breac", 57.691944, -5.091318, 999.6, m_parent),
+        new Mountain("Meall a' Chrasgaidh", 57.712868, -5.048734, 934, m_parent),
+        new Mountain("Sgurr nan Clach Geala", 57.69628, -5.048245, 1093, m_parent),
+        new Mountain("Sgurr nan Each", 57.68101, -5.046358, 923, m_parent),
+        new Mountain("Sgurr Mor", 57.700136, -5.016757, 1108.9, m_parent),
+        new Mountain("Beinn Liath Mhor Fannaich", 57.706097, -4.989768, 954, m_parent),
+        new Mountain("Meall Gorm", 57.68084, -4.983794, 949.7, m_parent),
+        new Mountain("An Coileachan", 57.667625, -4.949499, 924, m_parent),
+        new Mountain("Fionn Bheinn", 57.611151, -5.102719, 933, m_parent),
+        new Mountain("Am Faochagach", 57.771803, -4.853896, 953, m_parent),
+        new Mountain("Cona' Mheall", 57.791078, -4.903413, 978, m_parent),
+        new Mountain("Beinn Dearg", 57.786351, -4.929552, 1084, m_parent),
+        new Mountain("Meall nan Ceapraichean", 57.798515, -4.934007, 977, m_parent),
+        new Mountain("Eididh nan Clach Geala", 57.813501, -4.934198, 927, m_parent),
+        new Mountain("Seana Bhraigh", 57.84733, -4.896616, 926, m_parent),
+        new Mountain("Glas Leathad Mor (Ben Wyvis)", 57.678911, -4.579252, 1046, m_parent),
+        new Mountain("Ben Hope", 58.413114, -4.607863, 927, m_parent),
+        new Mountain("Ben Klibreck - Meall nan Con", 58.235202, -4.41113, 962.1, m_parent),
+        new Mountain("Ben More Assynt", 58.138166, -4.858216, 998, m_parent),
+        new Mountain("Conival", 58.135691, -4.883505, 987, m_parent),
+        new Mountain("Sgurr nan Gillean", 57.248216, -6.193162, 966.1, m_parent),
+        new Mountain("Am Basteir", 57.247942, -6.202968, 934, m_parent),
+        new Mountain("Bruach na Frithe", 57.246745, -6.210778, 958.8, m_parent),
+        new Mountain("Sgurr a' Mhadaidh", 57.230871, -6.231932, 918, m_parent),
+        new Mountain("Sgurr a' Ghreadaidh", 57.227315, -6.234426, 972.1, m_parent),
+        new Mountain("Sgurr na Banachdich", 57.220974, -6.241638, 965, m_parent),
+        new Mountain("Sgurr Dearg - Inaccessible Pinnacle", 57.213255, -6.234818, 985.8, m_parent),
+        new Mountain("Sgurr Mhic Choinnich", 57.20893, -6.224113, 948.1, m_parent),
+        new Mountain("Sgurr Alasdair", 57.20659, -6.224176, 992, m_parent),
+        new Mountain("Sgurr Dubh Mor", 57.204897, -6.211422, 944, m_parent),
+        new Mountain("Sgurr nan Eag", 57.19581, -6.211264, 926.3, m_parent),
+        new Mountain("Blabheinn [Bla Bheinn]", 57.219567, -6.093215, 929, m_parent),
+        new Mountain("Ben More", 56.424829, -6.014016, 966, m_parent)
+    };
+};
+
+#endif // MOUNTAINLOCATIONS_H
@@ -0,0 +1,276 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MountainNameIndex.h"
+#include "Tracer.h"
+
+#include <QSet>
+
+#include <algorithm>
+
+namespace
+{
+    // Longer queries add nothing to the ranking, and the trigram counts are kept in a byte.
+    constexpr qsizetype maximumQueryLength = 64;
+
+    // Scores are ordered by how the name matched, and within that by how much of it the query covers.
+    constexpr double namePrefixScore = 3.0;
+    constexpr double wordPrefixScore = 2.0;
+    constexpr double substringScore = 1.0;
+
+    bool isApostrophe(QChar character)
+    {
+        return character == u'\'' || character == u'`' || character == QChar(0x2018) || character == QChar(0x2019);
+    }
+
+    quint64 trigramAt(QStringView text, qsizetype position)
+    {
+        return (static_cast<quint64>(text.at(position).unicode()) << 32) |
+               (static_cast<quint64>(text.at(position + 1).unicode()) << 16) |
+               static_cast<quint64>(text.at(position + 2).unicode());
+    }
+
+    // A space before the text marks the start of the first word, as the spaces within it mark the
+    // others. Queries have no space at the end as the last word may not be finished.
+    QSet<quint64> trigramsOf(const QString& normalisedText, bool isQuery)
+    {
+        const QString padded = isQuery ? QLatin1Char(' ') + normalisedText : QLatin1Char(' ') + normalisedText + QLatin1Char(' ');
+        QSet<quint64> trigrams;
+        for (qsizetype position = 0; position + 3 <= padded.size(); ++position)
+            trigrams.insert(trigramAt(padded, position));
+        return trigrams;
+    }
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+MountainNameIndex::MountainNameIndex(const QStringList& names) :
+    m_numberOfEntries(names.size())
+{
+    TRACE_SCOPE("buildMountainNameIndex");
+
+    for (int entry = 0; entry < names.size(); ++entry)
+    {
+        for (const QString& alias : aliases(names.at(entry)))
+        {
+            const QString normalisedName = normalise(alias);
+            if (normalisedName.isEmpty())
+                continue;
+
+            const int key = static_cast<int>(m_keys.size());
+            const QSet<quint64> trigrams = trigramsOf(normalisedName, false);
+            m_keys.append({normalisedName, alias, entry, static_cast<int>(trigrams.size())});
+
+            // Keys are added in increasing order, so every list stays sorted.
+            for (const quint64 trigram : trigrams)
+                m_trigrams[trigram].append(key);
+
+            m_wordStarts.append({key, 0});
+            for (qsizetype position = 1; position < normalisedName.size(); ++position)
+            {
+                if (normalisedName.at(position - 1) == u' ')
+                    m_wordStarts.append({key, static_cast<int>(position)});
+            }
+        }
+    }
+
+    std::sort(m_wordStarts.begin(), m_wordStarts.end(), [this](const WordStart& first, const WordStart& second)
+    {
+        return QStringView(m_keys.at(first.key).normalisedName).mid(first.position) <
+               QStringView(m_keys.at(second.key).normalisedName).mid(second.position);
+    });
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+qsizetype MountainNameIndex::size() const
+{
+    return m_numberOfEntries;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+QList<MountainNameIndex::Match> MountainNameIndex::search(QStringView query, int maximumResults) const
+{
+    const QString normalisedQuery = normalise(query.left(maximumQueryLength));
+    if (normalisedQuery.isEmpty() || maximumResults <= 0)
+        return {};
+
+    // The best score of each key that matches at all.
+    QHash<int, double> scores;
+    const auto addScore = [this, &scores, &normalisedQuery](int key, double baseScore)
+    {
+        const double coverage = static_cast<double>(normalisedQuery.size()) / m_keys.at(key).normalisedName.size();
+        double& score = scores[key];
+        score = std::max(score, baseScore + coverage);
+    };
+
+    for (const int position : findByPrefix(normalisedQuery))
+    {
+        const WordStart& wordStart = m_wordStarts.at(position);
+        addScore(wordStart.key, wordStart.position == 0 ? namePrefixScore : wordPrefixScore);
+    }
+
+    // Shorter queries have too few trigrams to tell names apart.
+    if (normalisedQuery.size() >= 3)
+    {
+        const QSet<quint64> queryTrigrams = trigramsOf(normalisedQuery, true);
+        const int numberOfQueryTrigrams = static_cast<int>(queryTrigrams.size());
+
+        QList<quint8> sharedTrigrams(m_keys.size(), 0);
+        QList<int> candidates;
+        for (const quint64 trigram : queryTrigrams)
+        {
+            const auto keys = m_trigrams.constFind(trigram);
+            if (keys == m_trigrams.cend())
+                continue;
+
+            for (const int key : *keys)
+            {
+                if (sharedTrigrams[key]++ == 0)
+                    candidates.append(key);
+            }
+        }
+
+        // A name containing the query has all of its trigrams. Otherwise it must share at least half
+        // of them, and is ranked by how similar its set of trigrams is to the query's.
+        for (const int key : candidates)
+        {
+            const int shared = sharedTrigrams.at(key);
+            if (shared == numberOfQueryTrigrams && m_keys.at(key).normalisedName.contains(normalisedQuery))
+            {
+                addScore(key, substringScore);
+            }
+            else if (2 * shared >= numberOfQueryTrigrams)
+            {
+                const double similarity = static_cast<double>(shared) / (numberOfQueryTrigrams + m_keys.at(key).numberOfTrigrams - shared);
+                double& score = scores[key];
+                score = std::max(score, similarity);
+            }
+        }
+    }
+
+    // An entry is listed once, under whichever of its names matched best.
+    QHash<int, Match> bestMatches;
+    for (auto score = scores.cbegin(); score != scores.cend(); ++score)
+    {
+        const Key& key = m_keys.at(score.key());
+        Match& match = bestMatches[key.entry];
+        if (match.entry < 0 || score.value() > match.score)
+            match = {key.entry, key.displayName, score.value()};
+    }
+
+    QList<Match> matches = bestMatches.values();
+    const qsizetype numberToKeep = std::min<qsizetype>(maximumResults, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + numberToKeep, matches.end(), [](const Match& first, const Match& second)
+    {
+        if (first.score != second.score)
+            return first.score > second.score;
+        if (first.matchedName.size() != second.matchedName.size())
+            return first.matchedName.size() < second.matchedName.size();
+        return first.entry < second.entry;
+    });
+    matches.resize(numberToKeep);
+    return matches;
+}
+
+QString MountainNameIndex::normalise(QStringView text)
+{
+    // Decomposing separates accents from their letters, so "ù" becomes "u" followed by a combining grave.
+    const QString decomposed = text.toString().normalized(QString::NormalizationForm_D);
+
+    QString normalised;
+    normalised.reserve(decomposed.size());
+    bool spaceNeeded = false;
+    for (const QChar character : decomposed)
+    {
+        if (character.category() == QChar::Mark_NonSpacing || isApostrophe(character))
+            continue;
+
+        if (!character.isLetterOrNumber())
+        {
+            spaceNeeded = !normalised.isEmpty();
+            continue;
+        }
+
+        if (spaceNeeded)
+            normalised.append(u' ');
+        spaceNeeded = false;
+        normalised.append(character.toLower());
+    }
+    return normalised;
+}
+
+QStringList MountainNameIndex::aliases(const QString& name)
+{
+    QString mainName;
+    QStringList bracketedNames;
+    QString bracketedName;
+    int depth = 0;
+    for (const QChar character : name)
+    {
+        if (character == u'(' || character == u'[')
+        {
+            ++depth;
+            continue;
+        }
+
+        if ((character == u')' || character == u']') && depth > 0)
+        {
+            if (--depth == 0)
+            {
+                bracketedNames.append(bracketedName.simplified());
+                bracketedName.clear();
+            }
+            continue;
+        }
+
+        (depth > 0 ? bracketedName : mainName).append(character);
+    }
+
+    QStringList names{mainName.simplified()};
+    for (const QString& bracketed : bracketedNames)
+    {
+        if (!bracketed.isEmpty() && !names.contains(bracketed))
+            names.append(bracketed);
+    }
+    return names;
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+QList<int> MountainNameIndex::findByPrefix(const QString& query) const
+{
+    const auto wordText = [this](const WordStart& wordStart)
+    {
+        return QStringView(m_keys.at(wordStart.key).normalisedName).mid(wordStart.position);
+    };
+
+    const auto first = std::lower_bound(m_wordStarts.cbegin(), m_wordStarts.cend(), query, [&wordText](const WordStart& wordStart, const QString& text)
+    {
+        return wordText(wordStart) < QStringView(text);
+    });
+
+    QList<int> positions;
+    for (auto wordStart = first; wordStart != m_wordStarts.cend() && wordText(*wordStart).startsWith(query); ++wordStart)
+        positions.append(static_cast<int>(wordStart - m_wordStarts.cbegin()));
+    return positions;
+}
@@ -0,0 +1,75 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOUNTAINNAMEINDEX_H
+#define MOUNTAINNAMEINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+// Finds catalog entries by name as the user types. Each entry is indexed under its full name and
+// its aliases, the parts in brackets of names such as "Ben Lui [Beinn Laoigh]" or
+// "Bidein a' Ghlas Thuill (An Teallach)". Names and queries are compared without case, accents or
+// apostrophes, so "sgurr a ghreadaidh" finds "Sgùrr a' Ghreadaidh". Names that start with the query,
+// or have a word that does, rank first, then names that contain it, then names that share most of
+// its trigrams, which allows for misspellings.
+class MountainNameIndex
+{
+public:
+    struct Match
+    {
+        // The position of the entry in the list the index was built from.
+        int entry = -1;
+        // The name or alias that matched.
+        QString matchedName;
+        double score = 0.0;
+    };
+
+    MountainNameIndex() = default;
+    explicit MountainNameIndex(const QStringList& names);
+
+    QList<Match> search(QStringView query, int maximumResults) const;
+    qsizetype size() const;
+
+    static QString normalise(QStringView text);
+    static QStringList aliases(const QString& name);
+
+private:
+    struct Key
+    {
+        QString normalisedName;
+        QString displayName;
+        int entry;
+        int numberOfTrigrams;
+    };
+
+    struct WordStart
+    {
+        int key;
+        int position;
+    };
+
+    QList<int> findByPrefix(const QString& query) const;
+
+    QList<Key> m_keys;
+    qsizetype m_numberOfEntries = 0;
+    // The keys holding each trigram, in increasing order.
+    QHash<quint64, QList<int>> m_trigrams;
+    // Every position where a word starts in any key, sorted by the text from there on.
+    QList<WordStart> m_wordStarts;
+};
+
+#endif // MOUNTAINNAMEINDEX_H
@@ -0,0 +1,133 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "MountainSearchModel.h"
+#include "Mountain.h"
+#include "Tracer.h"
+
+namespace
+{
+    // As many as fit in the drop down list without scrolling.
+    constexpr int maximumNumberOfResults = 8;
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+MountainSearchModel::MountainSearchModel(QObject* parent) :
+    QAbstractListModel{parent}
+{
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+int MountainSearchModel::count() const
+{
+    return static_cast<int>(m_matches.size());
+}
+
+QString MountainSearchModel::query() const
+{
+    return m_query;
+}
+
+void MountainSearchModel::setQuery(const QString& query)
+{
+    if (query == m_query)
+        return;
+
+    m_query = query;
+    emit queryChanged();
+    search();
+}
+
+void MountainSearchModel::setMountains(const QList<Mountain*>& mountains)
+{
+    QStringList names;
+    names.reserve(mountains.size());
+    for (const Mountain* mountain : mountains)
+        names.append(mountain->getName());
+
+    m_mountains = mountains;
+    m_index = MountainNameIndex(names);
+    search();
+}
+
+// ------------------------------------- //
+//           Model Implementation        //
+// ------------------------------------- //
+
+int MountainSearchModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant MountainSearchModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_matches.size())
+        return {};
+
+    Mountain* const mountain = m_mountains.at(m_matches.at(index.row()).entry);
+    switch (role)
+    {
+    case Qt::DisplayRole:
+    case NameRole:
+        return mountain->getName();
+    case ElevationRole:
+        return mountain->getElevation();
+    case MountainRole:
+        return QVariant::fromValue(mountain);
+    }
+    return {};
+}
+
+QHash<int, QByteArray> MountainSearchModel::roleNames() const
+{
+    return {
+        {NameRole, "name"},
+        {ElevationRole, "elevation"},
+        {MountainRole, "mountain"}
+    };
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+Mountain* MountainSearchModel::mountainAt(int row) const
+{
+    if (row < 0 || row >= m_matches.size())
+        return nullptr;
+
+    return m_mountains.at(m_matches.at(row).entry);
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+void MountainSearchModel::search()
+{
+    TRACE_SCOPE("searchMountainNames");
+
+    const qsizetype previousCount = m_matches.size();
+    beginResetModel();
+    m_matches = m_index.search(m_query, maximumNumberOfResults);
+    endResetModel();
+
+    if (m_matches.size() != previousCount)
+        emit countChanged();
+}
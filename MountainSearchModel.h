@@ -0,0 +1,67 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOUNTAINSEARCHMODEL_H
+#define MOUNTAINSEARCHMODEL_H
+
+#include <QAbstractListModel>
+#include <QList>
+#include <QString>
+
+#include "MountainNameIndex.h"
+
+class Mountain;
+
+// The mountains matching the text typed into the search field, best match first.
+class MountainSearchModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    enum Role
+    {
+        NameRole = Qt::UserRole + 1,
+        ElevationRole,
+        MountainRole
+    };
+
+    explicit MountainSearchModel(QObject* parent = nullptr);
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    int count() const;
+    QString query() const;
+    void setQuery(const QString& query);
+    void setMountains(const QList<Mountain*>& mountains);
+
+    Q_INVOKABLE Mountain* mountainAt(int row) const;
+
+signals:
+    void countChanged();
+    void queryChanged();
+
+private:
+    void search();
+
+    MountainNameIndex m_index;
+    QList<MountainNameIndex::Match> m_matches;
+    QList<Mountain*> m_mountains;
+    QString m_query;
+};
+
+#endif // MOUNTAINSEARCHMODEL_H
@@ -1,123 +1,713 @@
-// Copyright 2023 Esri
-
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-
-// Unless required by applicable law or agreed to in writing, software
-// distributed under the License is distributed on an "AS IS" BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-// See the License for the specific language governing permissions and
-// limitations under the License.
-
-#include "OpenMeteoForecastSource.h"
-#include "Mountain.h"
-
-#include <QDebug>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QNetworkRequest>
-#include <QUrl>
-#include <QUrlQuery>
-#include <QVariantMap>
-
-OpenMeteoForecastSource::OpenMeteoForecastSource(QObject* parent) :
-    QObject{parent}
-{
-    m_requestUrl.setScheme("https");
-    m_requestUrl.setHost("api.open-meteo.com");
-    m_requestUrl.setPath("/v1/forecast");
-}
-
-void OpenMeteoForecastSource::MakeRequest(const double mountainLong, const double mountainLat, const double mountainElev, Mountain* mountain)
-{
-    // Weather data is accessed from https://open-meteo.com/
-    // License information: https://open-meteo.com/en/license
-    QUrlQuery urlQuery;
-    urlQuery.addQueryItem("latitude", QString::number(mountainLat));
-    urlQuery.addQueryItem("longitude", QString::number(mountainLong));
-    urlQuery.addQueryItem("elevation", QString::number(mountainElev));
-    urlQuery.addQueryItem("timezone", "auto");
-    urlQuery.addQueryItem("hourly", "temperature_2m,apparent_temperature,precipitation,visibility");
-    urlQuery.addQueryItem("daily", "precipitation_sum,weathercode,windspeed_10m_max,windgusts_10m_max,winddirection_10m_dominant");
-    m_requestUrl.setQuery(urlQuery);
-
-    const QNetworkRequest networkRequest(m_requestUrl);
-    QNetworkAccessManager* const networkManager = new QNetworkAccessManager(this);
-
-    connect(networkManager, &QNetworkAccessManager::finished, this, [this, mountain](QNetworkReply* reply){
-        if (reply->error() == QNetworkReply::NetworkError::NoError)
-        {
-            if (mountain == nullptr)
-                return;
-            const QByteArray jsonBytes = reply->readAll();
-            reply->deleteLater();
-            const QJsonDocument jsonDocument = QJsonDocument::fromJson(jsonBytes);
-            processResponse(jsonDocument, mountain);
-        }
-    });
-    networkManager->get(networkRequest);
-}
-
-void OpenMeteoForecastSource::processResponse(const QJsonDocument& response, Mountain* mountain) const
-{
-    if (!response.isObject() || mountain == nullptr)
-        return;
-
-    const QJsonObject jsonObject = response.object();
-
-    if (jsonObject.isEmpty())
-        return;
-
-    const QVariantMap responseVariantMap = jsonObject.toVariantMap();
-
-    const QMap<QString, QVariant> hourlyData = responseVariantMap.value("hourly").toMap();
-    assignHourlyDataToMountain(hourlyData, mountain);
-
-    const QMap<QString, QVariant> dailyData = responseVariantMap.value("daily").toMap();
-    assignDailyDataToMountain(dailyData, mountain);
-
-    mountain->identifyMaxAndMinValues();
-}
-
-void OpenMeteoForecastSource::assignHourlyDataToMountain(const QMap<QString, QVariant>& hourlyData, Mountain* mountain) const
-{
-    const QList<QDateTime> time = convertQVariantListToTypedList<QDateTime>(hourlyData.value("time").toList());
-    mountain->setHourlyDateTime(time);
-
-    const QList<double> apparentTemperature = convertQVariantListToTypedList<double>(hourlyData.value("apparent_temperature").toList());
-    mountain->setHourlyApparentTemperature(apparentTemperature);
-
-    const QList<double> precipitation = convertQVariantListToTypedList<double>(hourlyData.value("precipitation").toList());
-    mountain->setHourlyPrecipitation(precipitation);
-
-    const QList<double> temperature2m = convertQVariantListToTypedList<double>(hourlyData.value("temperature_2m").toList());
-    mountain->setHourlyTemperature(temperature2m);
-
-    const QList<int> visibility = convertQVariantListToTypedList<int>(hourlyData.value("visibility").toList());
-    mountain->setHourlyVisibility(visibility);
-}
-
-void OpenMeteoForecastSource::assignDailyDataToMountain(const QMap<QString, QVariant>& dailyData, Mountain* mountain) const
-{
-    const QList<QDate> date = convertQVariantListToTypedList<QDate>(dailyData.value("time").toList());
-    mountain->setDates(date);
-
-    const QList<int> weatherCode = convertQVariantListToTypedList<int>(dailyData.value("weathercode").toList());
-    mountain->setDailyWeatherConditions(weatherCode);
-
-    const QList<int> windDirection = convertQVariantListToTypedList<int>(dailyData.value("winddirection_10m_dominant").toList());
-    mountain->setDailyWindDirection(windDirection);
-
-    const QList<double> windGusts = convertQVariantListToTypedList<double>(dailyData.value("windgusts_10m_max").toList());
-    mountain->setDailyWindGusts(windGusts);
-
-    const QList<double> windSpeed = convertQVariantListToTypedList<double>(dailyData.value("windspeed_10m_max").toList());
-    mountain->setDailyWindSpeed(windSpeed);
-
-    const QList<double> precipitation = convertQVariantListToTypedList<double>(dailyData.value("precipitation_sum").toList());
-    mountain->setDailyPrecipitation(precipitation);
-}
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "OpenMeteoForecastSource.h"
+#include "DailyAggregator.h"
+#include "ForecastEnsemble.h"
+#include "HazardKernel.h"
+#include "Metrics.h"
+#include "Mountain.h"
+#include "MountainForecast.h"
+#include "SolarEphemeris.h"
+#include "TimeAxis.h"
+#include "Tracer.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaEnum>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QVariantMap>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace
+{
+    const QStringList chartedHourlyVariables{"temperature_2m", "apparent_temperature", "precipitation", "visibility"};
+    const QStringList windHourlyVariables{"windspeed_10m", "windgusts_10m", "winddirection_10m", "weathercode"};
+    // The inputs of HazardKernel, along with temperature_2m.
+    const QStringList hazardHourlyVariables{"dewpoint_2m", "freezinglevel_height", "cloudcover_low", "windspeed_10m"};
+    const QStringList upstreamDailyVariables{"weathercode", "windspeed_10m_max", "windgusts_10m_max", "winddirection_10m_dominant"};
+
+    // What Open-Meteo counts as a single call.
+    constexpr double variablesPerCall = 10.0;
+    constexpr double daysPerCall = 14.0;
+
+    // Codes and directions cannot be averaged, so they are taken from the first model that has them.
+    const QStringList categoricalVariables{"weathercode", "winddirection_10m", "winddirection_10m_dominant"};
+
+    // Where the hours are tiered, the worst of them is kept for these rather than their average.
+    const QStringList lowestValueHourlyVariables{"visibility"};
+
+    ForecastTiering::Reduction hourlyReduction(const QString& variable)
+    {
+        return lowestValueHourlyVariables.contains(variable) ? ForecastTiering::Reduction::Minimum : ForecastTiering::Reduction::Mean;
+    }
+
+    // Lower values of these are worse for the hill, so a cautious percentile is taken from the other end of the models.
+    const QStringList lowerIsWorseVariables{"temperature_2m", "apparent_temperature", "visibility", "freezinglevel_height"};
+
+    double worstCasePercentile(const QString& variable, double percentile)
+    {
+        return lowerIsWorseVariables.contains(variable) ? 100.0 - percentile : percentile;
+    }
+
+    // Converts a decoded series into the buffer, reusing its storage when it is large enough.
+    void assignDoubles(QList<double>* buffer, const QVariantList& values)
+    {
+        buffer->resize(values.size());
+        double* const data = buffer->data();
+        for (qsizetype index = 0; index < values.size(); ++index)
+            data[index] = values.at(index).toDouble();
+    }
+
+    // Daily times are plain ISO dates, which are parsed without going through QVariant's conversions.
+    QList<QDate> parseDates(const QVariantList& times)
+    {
+        QList<QDate> dates;
+        dates.reserve(times.size());
+        for (const QVariant& time : times)
+        {
+            QDate date;
+            TimeAxis::parseIsoDate(time.toString(), &date);
+            dates.append(date);
+        }
+        return dates;
+    }
+
+    // Lines derived daily values up with the dates of the daily block.
+    template<typename T>
+    void insertAligned(QVariantMap* dailyData, const QString& variable, const QList<QDate>& dates,
+                       const QList<QDate>& derivedDates, const QList<T>& derivedValues)
+    {
+        if (derivedValues.isEmpty())
+            return;
+
+        QVariantList values;
+        values.reserve(dates.size());
+        for (const QDate& date : dates)
+        {
+            const qsizetype index = derivedDates.indexOf(date);
+            values.append(index >= 0 && index < derivedValues.size() ? derivedValues.at(index) : T{});
+        }
+        dailyData->insert(variable, values);
+    }
+}
+
+OpenMeteoForecastSource::OpenMeteoForecastSource(QObject* parent) :
+    QObject{parent}
+{
+    m_requestUrl.setScheme("https");
+    m_requestUrl.setHost("api.open-meteo.com");
+    m_requestUrl.setPath("/v1/forecast");
+
+    // Forecasts can be retrieved from a ConditionsNavigatorService instead of directly from Open-Meteo.
+    const QString forecastUrl = qEnvironmentVariable("CONDITIONS_NAVIGATOR_FORECAST_URL");
+    if (!forecastUrl.isEmpty())
+        setBaseUrl(QUrl(forecastUrl));
+
+    // Several models, for example ukmo_seamless,ecmwf_ifs025,icon_seamless, can be combined.
+    const QString models = qEnvironmentVariable("CONDITIONS_NAVIGATOR_FORECAST_MODELS");
+    if (!models.isEmpty())
+        setModels(models.split(',', Qt::SkipEmptyParts));
+
+    bool validPercentile = false;
+    const double percentile = qEnvironmentVariable("CONDITIONS_NAVIGATOR_FORECAST_PERCENTILE").toDouble(&validPercentile);
+    if (validPercentile)
+        setEnsemblePercentile(percentile);
+
+    if (qEnvironmentVariable("CONDITIONS_NAVIGATOR_DAILY_AGGREGATION") == "local")
+        setDailyAggregation(DailyAggregation::Local);
+
+    // For example 8-18 for the hours from 08:00 to 18:00, or sunrise or civil for the daylight at each mountain.
+    const QString daylight = qEnvironmentVariable("CONDITIONS_NAVIGATOR_DAYLIGHT_HOURS");
+    const QStringList daylightHours = daylight.split('-');
+    if (daylight == "sunrise")
+        setDaylightWindow(DaylightWindow::Sunlight);
+    else if (daylight == "civil")
+        setDaylightWindow(DaylightWindow::CivilTwilight);
+    else if (daylightHours.size() == 2)
+        setDaylightHours(daylightHours.first().toInt(), daylightHours.last().toInt());
+
+    bool validForecastDays = false;
+    const int forecastDays = qEnvironmentVariable("CONDITIONS_NAVIGATOR_FORECAST_DAYS").toInt(&validForecastDays);
+    if (validForecastDays)
+        setForecastDays(forecastDays);
+}
+
+OpenMeteoForecastSource::~OpenMeteoForecastSource()
+{
+    // Forecasts still being parsed are discarded along with this object.
+    m_threadPool.waitForDone();
+}
+
+QUrl OpenMeteoForecastSource::getBaseUrl() const
+{
+    return m_requestUrl.adjusted(QUrl::RemoveQuery);
+}
+
+void OpenMeteoForecastSource::setBaseUrl(const QUrl& baseUrl)
+{
+    if (!baseUrl.isValid() || baseUrl.host().isEmpty())
+    {
+        qWarning() << "Ignoring invalid forecast URL" << baseUrl;
+        return;
+    }
+
+    m_requestUrl = baseUrl.adjusted(QUrl::RemoveQuery);
+    if (m_requestUrl.path().isEmpty() || m_requestUrl.path() == "/")
+        m_requestUrl.setPath("/v1/forecast");
+}
+
+const ForecastBufferPool& OpenMeteoForecastSource::getBufferPool() const
+{
+    return m_bufferPool;
+}
+
+ForecastBufferPool& OpenMeteoForecastSource::getBufferPool()
+{
+    return m_bufferPool;
+}
+
+OpenMeteoForecastSource::DailyAggregation OpenMeteoForecastSource::getDailyAggregation() const
+{
+    return m_dailyAggregation;
+}
+
+void OpenMeteoForecastSource::setDailyAggregation(DailyAggregation dailyAggregation)
+{
+    m_dailyAggregation = dailyAggregation;
+}
+
+void OpenMeteoForecastSource::setDaylightHours(int firstHour, int lastHour)
+{
+    if (firstHour < 0 || lastHour > 24 || firstHour >= lastHour)
+    {
+        qWarning() << "Ignoring invalid daylight hours" << firstHour << lastHour;
+        return;
+    }
+
+    m_daylightFirstHour = firstHour;
+    m_daylightLastHour = lastHour;
+    m_daylightWindow = DaylightWindow::FixedHours;
+}
+
+OpenMeteoForecastSource::DaylightWindow OpenMeteoForecastSource::getDaylightWindow() const
+{
+    return m_daylightWindow;
+}
+
+void OpenMeteoForecastSource::setDaylightWindow(DaylightWindow daylightWindow)
+{
+    m_daylightWindow = daylightWindow;
+}
+
+double OpenMeteoForecastSource::getEnsemblePercentile() const
+{
+    return m_ensemblePercentile;
+}
+
+void OpenMeteoForecastSource::setEnsemblePercentile(double percentile)
+{
+    m_ensemblePercentile = std::clamp(percentile, 0.0, 100.0);
+}
+
+int OpenMeteoForecastSource::getForecastDays() const
+{
+    return m_forecastDays;
+}
+
+void OpenMeteoForecastSource::setForecastDays(int forecastDays)
+{
+    if (forecastDays < 1 || forecastDays > maximumForecastDays)
+    {
+        qWarning() << "Ignoring invalid number of forecast days" << forecastDays;
+        return;
+    }
+
+    m_forecastDays = forecastDays;
+}
+
+QStringList OpenMeteoForecastSource::getModels() const
+{
+    return m_models;
+}
+
+void OpenMeteoForecastSource::setModels(const QStringList& models)
+{
+    m_models.clear();
+    for (const QString& model : models)
+    {
+        if (!model.trimmed().isEmpty())
+            m_models.append(model.trimmed());
+    }
+}
+
+void OpenMeteoForecastSource::setNetworkAccessManager(QNetworkAccessManager* networkManager)
+{
+    m_networkManager = networkManager;
+}
+
+ForecastTiering OpenMeteoForecastSource::getTiering() const
+{
+    return m_tiering;
+}
+
+void OpenMeteoForecastSource::setTiering(const ForecastTiering& tiering)
+{
+    m_tiering = tiering;
+}
+
+double OpenMeteoForecastSource::getRequestCost() const
+{
+    const qsizetype numberOfVariables = hourlyVariables().size() + dailyVariables().size();
+    const double variableCalls = std::max(1.0, numberOfVariables / variablesPerCall);
+    const double dayCalls = std::max(1.0, m_forecastDays / daysPerCall);
+    return variableCalls * dayCalls * std::max<qsizetype>(1, m_models.size());
+}
+
+void OpenMeteoForecastSource::MakeRequest(const double mountainLong, const double mountainLat, const double mountainElev, Mountain* mountain)
+{
+    // Weather data is accessed from https://open-meteo.com/
+    // License information: https://open-meteo.com/en/license
+    QUrlQuery urlQuery;
+    urlQuery.addQueryItem("latitude", QString::number(mountainLat));
+    urlQuery.addQueryItem("longitude", QString::number(mountainLong));
+    urlQuery.addQueryItem("elevation", QString::number(mountainElev));
+    urlQuery.addQueryItem("timezone", "auto");
+    urlQuery.addQueryItem("forecast_days", QString::number(m_forecastDays));
+    urlQuery.addQueryItem("hourly", hourlyVariables().join(','));
+    const QStringList daily = dailyVariables();
+    if (!daily.isEmpty())
+        urlQuery.addQueryItem("daily", daily.join(','));
+
+    // Open-Meteo runs every model in the one request and returns each series once per model, so
+    // adding models does not add requests or round trips.
+    if (!m_models.isEmpty())
+        urlQuery.addQueryItem("models", m_models.join(','));
+    m_requestUrl.setQuery(urlQuery);
+
+    const QNetworkRequest networkRequest(m_requestUrl);
+
+    // One network access manager is shared by every request so connections to Open-Meteo are reused.
+    if (m_networkManager == nullptr)
+        m_networkManager = new QNetworkAccessManager(this);
+
+    const quint64 requestId = ++m_requestCounter;
+    ++m_requestsInFlight;
+    Tracer::instance().addAsyncBegin("forecastRequest", requestId, mountain ? mountain->getName() : QString());
+    Tracer::instance().addCounter("forecastRequestsInFlight", m_requestsInFlight);
+    Metrics::instance().requestStarted();
+
+    QElapsedTimer roundTripTimer;
+    roundTripTimer.start();
+
+    // The mountain may be destroyed while its request is in flight, for example when the catalog changes.
+    if (mountain)
+        connect(mountain, &QObject::destroyed, this, &OpenMeteoForecastSource::forgetMountain, Qt::UniqueConnection);
+
+    QNetworkReply* const reply = m_networkManager->get(networkRequest);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, mountain = QPointer<Mountain>(mountain), requestId, roundTripTimer](){
+        --m_requestsInFlight;
+        Tracer::instance().addAsyncEnd("forecastRequest", requestId);
+        Tracer::instance().addCounter("forecastRequestsInFlight", m_requestsInFlight);
+        reply->deleteLater();
+
+        const qint64 roundTripMicroseconds = roundTripTimer.nsecsElapsed() / 1000;
+        if (reply->error() != QNetworkReply::NetworkError::NoError)
+        {
+            const QString failureType = QMetaEnum::fromType<QNetworkReply::NetworkError>().valueToKey(reply->error());
+            Metrics::instance().requestFailed(failureType, roundTripMicroseconds);
+            emit forecastFailed(mountain, failureType);
+            return;
+        }
+
+        const QByteArray jsonBytes = reply->readAll();
+        Metrics::instance().requestFinished(roundTripMicroseconds, jsonBytes.size());
+
+        if (mountain.isNull())
+            return;
+
+        emit replyReceived(mountain, jsonBytes);
+
+        // The replies that arrive together, such as those of a refresh, are parsed together once this
+        // pass of the event loop is over, so that their hazards are derived in one pass.
+        m_pendingReplies.append({mountain, requestId, jsonBytes});
+        if (m_pendingReplies.size() == 1)
+            QMetaObject::invokeMethod(this, &OpenMeteoForecastSource::parsePendingReplies, Qt::QueuedConnection);
+    });
+}
+
+bool OpenMeteoForecastSource::processReply(const QByteArray& jsonBytes, Mountain* mountain) const
+{
+    if (mountain == nullptr)
+        return false;
+
+    std::shared_ptr<MountainForecast> forecast = parseReply(jsonBytes);
+    if (!forecast)
+        return false;
+
+    m_bufferPool.recycle(mountain->publishForecast(std::move(forecast)));
+    return true;
+}
+
+std::shared_ptr<MountainForecast> OpenMeteoForecastSource::parseReply(const QByteArray& jsonBytes) const
+{
+    return parseReplies({jsonBytes}).first();
+}
+
+QList<std::shared_ptr<MountainForecast>> OpenMeteoForecastSource::parseReplies(const QList<QByteArray>& replies) const
+{
+    TRACE_SCOPE("parseReplies");
+
+    // Kept by each parsing thread, so that the next replies it parses reuse the storage.
+    thread_local QList<DecodedResponse> decodedResponses;
+    thread_local HazardKernel::Batch batch;
+    thread_local HazardKernel::Hazards batchHazards;
+    thread_local HazardKernel::Hazards hazards;
+
+    decodedResponses.resize(replies.size());
+    batch.clear();
+    for (qsizetype index = 0; index < replies.size(); ++index)
+    {
+        QElapsedTimer decodeTimer;
+        decodeTimer.start();
+        DecodedResponse* const decoded = &decodedResponses[index];
+        decodeResponse(replies.at(index), decoded, &batch);
+        decoded->decodeNanoseconds = decodeTimer.nsecsElapsed();
+    }
+
+    HazardKernel::run(batch, &batchHazards);
+
+    QList<std::shared_ptr<MountainForecast>> forecasts(replies.size());
+    for (qsizetype index = 0; index < replies.size(); ++index)
+    {
+        DecodedResponse* const decoded = &decodedResponses[index];
+        if (decoded->location >= 0)
+        {
+            QElapsedTimer finishTimer;
+            finishTimer.start();
+            hazards.assignLocation(batchHazards, batch, decoded->location);
+            forecasts[index] = finishResponse(decoded, hazards);
+            decoded->decodeNanoseconds += finishTimer.nsecsElapsed();
+        }
+        Metrics::instance().recordDecode(decoded->decodeNanoseconds / 1000);
+    }
+
+    // The decoded responses are let go of, but their storage is kept for the next replies.
+    decodedResponses.resize(0);
+    return forecasts;
+}
+
+void OpenMeteoForecastSource::forgetMountain(QObject* mountain)
+{
+    m_publishedRequests.remove(mountain);
+}
+
+void OpenMeteoForecastSource::parsePendingReplies()
+{
+    // The next generations of the forecasts are built on a worker thread and only the swaps happen on
+    // this thread, so refreshing the whole catalog does not hold up the UI and nothing reading a
+    // mountain sees a forecast that is partly old and partly new.
+    const QList<PendingReply> pendingReplies = std::exchange(m_pendingReplies, QList<PendingReply>());
+    m_threadPool.start([this, pendingReplies]()
+    {
+        QList<QByteArray> replies;
+        replies.reserve(pendingReplies.size());
+        for (const PendingReply& reply : pendingReplies)
+            replies.append(reply.jsonBytes);
+
+        const QList<std::shared_ptr<MountainForecast>> forecasts = parseReplies(replies);
+        QMetaObject::invokeMethod(this, [this, pendingReplies, forecasts]()
+        {
+            for (qsizetype index = 0; index < pendingReplies.size(); ++index)
+                publishParsedForecast(pendingReplies.at(index), forecasts.at(index));
+        }, Qt::QueuedConnection);
+    });
+}
+
+void OpenMeteoForecastSource::publishParsedForecast(const PendingReply& reply, const std::shared_ptr<const MountainForecast>& forecast)
+{
+    const QPointer<Mountain>& mountain = reply.mountain;
+    if (mountain.isNull())
+    {
+        m_bufferPool.recycle(forecast);
+        return;
+    }
+
+    if (!forecast)
+    {
+        emit forecastFailed(mountain, "InvalidResponse");
+        return;
+    }
+
+    // The generation that is replaced, or this one if it arrived too late, goes back to the pool to be
+    // refilled once nobody is reading it.
+    if (reply.requestId > m_publishedRequests.value(mountain.data()))
+    {
+        m_publishedRequests.insert(mountain.data(), reply.requestId);
+        m_bufferPool.recycle(mountain->publishForecast(forecast));
+    }
+    else
+    {
+        m_bufferPool.recycle(forecast);
+    }
+    emit forecastReceived(mountain);
+}
+
+void OpenMeteoForecastSource::decodeResponse(const QByteArray& jsonBytes, DecodedResponse* decoded, HazardKernel::Batch* batch) const
+{
+    QJsonParseError parseError;
+    QJsonDocument jsonDocument;
+    {
+        TRACE_SCOPE("parseResponse");
+        jsonDocument = QJsonDocument::fromJson(jsonBytes, &parseError);
+    }
+
+    if (parseError.error != QJsonParseError::NoError)
+    {
+        Metrics::instance().recordFailure("ParseError");
+        return;
+    }
+
+    TRACE_SCOPE("processResponse");
+
+    if (!jsonDocument.isObject())
+        return;
+
+    const QJsonObject jsonObject = jsonDocument.object();
+
+    if (jsonObject.isEmpty())
+        return;
+
+    decoded->response = jsonObject.toVariantMap();
+    decoded->forecast = m_bufferPool.acquire();
+
+    decoded->hourlyData = decoded->response.value("hourly").toMap();
+    decoded->dailyData = decoded->response.value("daily").toMap();
+    if (m_models.size() > 1)
+    {
+        decoded->hourlyData = mergeModels(decoded->hourlyData, hourlyVariables(), &m_tiering, decoded->forecast.get());
+        decoded->dailyData = mergeModels(decoded->dailyData, dailyVariables(), nullptr, decoded->forecast.get());
+    }
+
+    // Only the first two times are needed to place every hour, but all of them are checked.
+    const QVariantList hourlyTimes = decoded->hourlyData.value("time").toList();
+    decoded->hourlyTimeAxis = TimeAxis::fromIsoStrings(hourlyTimes, decoded->response.value("utc_offset_seconds").toInt());
+    if (decoded->hourlyTimeAxis.size() != hourlyTimes.size())
+    {
+        m_bufferPool.recycle(std::exchange(decoded->forecast, nullptr));
+        return;
+    }
+
+    // Open-Meteo returns the elevation the forecast was corrected to, which is the summit's.
+    const double summitElevation = decoded->response.value("elevation", std::numeric_limits<double>::quiet_NaN()).toDouble();
+    decoded->location = batch->numberOfLocations();
+    batch->appendLocation(summitElevation, decoded->hourlyTimeAxis.size(),
+                          decoded->hourlyData.value("temperature_2m").toList(),
+                          decoded->hourlyData.value("dewpoint_2m").toList(),
+                          decoded->hourlyData.value("windspeed_10m").toList(),
+                          decoded->hourlyData.value("freezinglevel_height").toList(),
+                          decoded->hourlyData.value("cloudcover_low").toList());
+}
+
+std::shared_ptr<MountainForecast> OpenMeteoForecastSource::finishResponse(DecodedResponse* decoded, const HazardKernel::Hazards& hazards) const
+{
+    deriveDailyData(decoded->response, decoded->hourlyTimeAxis, decoded->hourlyData, hazards, &decoded->dailyData);
+
+    // The daily values above are worked out from every hour, and only what is kept is tiered.
+    MountainForecast* const forecast = decoded->forecast.get();
+    forecast->mutableSeries()->hourlyTime = m_tiering.apply(decoded->hourlyTimeAxis);
+    assignHourlyDataToForecast(decoded->hourlyData, forecast);
+    assignHazardsToForecast(hazards, forecast);
+    assignDailyDataToForecast(decoded->dailyData, forecast);
+    return std::move(decoded->forecast);
+}
+
+QStringList OpenMeteoForecastSource::hourlyVariables() const
+{
+    QStringList variables = chartedHourlyVariables + hazardHourlyVariables;
+    if (m_dailyAggregation == DailyAggregation::Local)
+        variables += windHourlyVariables;
+    variables.removeDuplicates();
+    return variables;
+}
+
+QStringList OpenMeteoForecastSource::dailyVariables() const
+{
+    if (m_dailyAggregation == DailyAggregation::Local)
+        return {};
+    return upstreamDailyVariables;
+}
+
+QVariantMap OpenMeteoForecastSource::mergeModels(const QVariantMap& data, const QStringList& variables, const ForecastTiering* tiering,
+                                                 MountainForecast* forecast) const
+{
+    // Each series is returned once per model, as <variable>_<model>. The merged map holds the chosen
+    // percentile of the models under the plain variable name, which is what the classifier, charts
+    // and table use, and the full statistics are kept with the forecast. The percentile is mirrored
+    // for the variables where the lower values are the worse ones.
+    QVariantMap mergedData;
+    mergedData.insert("time", data.value("time"));
+
+    for (const QString& variable : variables)
+    {
+        if (categoricalVariables.contains(variable))
+        {
+            for (const QString& model : m_models)
+            {
+                const QVariantList values = data.value(variable + '_' + model).toList();
+                if (!values.isEmpty() && !values.first().isNull())
+                {
+                    mergedData.insert(variable, values);
+                    break;
+                }
+            }
+            continue;
+        }
+
+        QList<QList<double>> members;
+        members.reserve(m_models.size());
+        for (const QString& model : m_models)
+        {
+            const QVariantList values = data.value(variable + '_' + model).toList();
+            if (values.isEmpty())
+                continue;
+
+            QList<double> member;
+            member.reserve(values.size());
+            for (const QVariant& value : values)
+                member.append(value.isNull() ? std::numeric_limits<double>::quiet_NaN() : value.toDouble());
+            members.append(member);
+        }
+
+        const ForecastEnsemble::Statistics statistics = ForecastEnsemble::merge(members, worstCasePercentile(variable, m_ensemblePercentile));
+        forecast->setEnsembleStatistics(variable, tiering ? tiering->apply(statistics, hourlyReduction(variable)) : statistics);
+
+        QVariantList percentileValues;
+        percentileValues.reserve(statistics.percentile.size());
+        for (double value : statistics.percentile)
+            percentileValues.append(value);
+        mergedData.insert(variable, percentileValues);
+    }
+    return mergedData;
+}
+
+void OpenMeteoForecastSource::deriveDailyData(const QVariantMap& response, const TimeAxis& hourlyTimeAxis, const QVariantMap& hourlyData,
+                                              const HazardKernel::Hazards& hazards, QVariantMap* dailyData) const
+{
+    // Kept by each parsing thread, so that the series of the next forecast it parses are converted
+    // into the same storage.
+    thread_local DailyAggregator::HourlySeries hourly;
+    hourly.time = hourlyTimeAxis;
+    assignDoubles(&hourly.precipitation, hourlyData.value("precipitation").toList());
+    assignDoubles(&hourly.windSpeed, hourlyData.value("windspeed_10m").toList());
+    assignDoubles(&hourly.windGusts, hourlyData.value("windgusts_10m").toList());
+    assignDoubles(&hourly.windDirection, hourlyData.value("winddirection_10m").toList());
+    assignDoubles(&hourly.weatherCode, hourlyData.value("weathercode").toList());
+    hourly.windChill = hazards.windChill;
+    hourly.freezingLevelMargin = hazards.freezingLevelMargin;
+    hourly.summitInCloud = hazards.summitInCloud;
+
+    // The daylight is worked out for the location and elevation of the forecast, which are the
+    // summit's to within the model's grid.
+    DailyAggregator::DailySeries daily;
+    if (m_daylightWindow == DaylightWindow::FixedHours)
+    {
+        daily = DailyAggregator::aggregate(hourly, m_daylightFirstHour, m_daylightLastHour);
+    }
+    else
+    {
+        const double solarAltitude = m_daylightWindow == DaylightWindow::Sunlight ? SolarEphemeris::sunriseAltitude
+                                                                                    : SolarEphemeris::civilTwilightAltitude;
+        daily = DailyAggregator::aggregate(hourly, response.value("latitude").toDouble(), response.value("longitude").toDouble(),
+                                           response.value("elevation").toDouble(), solarAltitude);
+    }
+
+    // The hazards are shared rather than copied, and are let go of so that the next forecast can
+    // derive its hazards into the same storage.
+    hourly.windChill = QList<double>();
+    hourly.freezingLevelMargin = QList<double>();
+    hourly.summitInCloud = QList<double>();
+
+    // Without a daily block, as in the Local mode, the days are those of the hourly series.
+    QList<QDate> dates = parseDates(dailyData->value("time").toList());
+    if (dates.isEmpty())
+    {
+        dates = daily.dates;
+        QVariantList time;
+        for (const QDate& date : dates)
+            time.append(date.toString(Qt::ISODate));
+        dailyData->insert("time", time);
+    }
+
+    insertAligned(dailyData, "precipitation_sum", dates, daily.dates, daily.precipitationSum);
+    insertAligned(dailyData, "windspeed_10m_max", dates, daily.dates, daily.windSpeedMax);
+    insertAligned(dailyData, "windgusts_10m_max", dates, daily.dates, daily.windGustsMax);
+    insertAligned(dailyData, "winddirection_10m_dominant", dates, daily.dates, daily.windDirectionDominant);
+    insertAligned(dailyData, "weathercode", dates, daily.dates, daily.weatherCode);
+
+    // Open-Meteo has no daily hazards, so these names are only used here.
+    insertAligned(dailyData, "windchill_min", dates, daily.dates, daily.minimumWindChill);
+    insertAligned(dailyData, "freezinglevel_below_summit_hours", dates, daily.dates, daily.freezingLevelBelowSummitHours);
+    insertAligned(dailyData, "summit_in_cloud_hours", dates, daily.dates, daily.summitInCloudHours);
+}
+
+void OpenMeteoForecastSource::assignHourlyDataToForecast(const QMap<QString, QVariant>& hourlyData, MountainForecast* forecast) const
+{
+    MountainForecast::Series* const series = forecast->mutableSeries();
+    assignTiered<double>(&series->hourlyApparentTemperature, hourlyData.value("apparent_temperature").toList(),
+                         hourlyReduction("apparent_temperature"));
+    assignTiered<double>(&series->hourlyPrecipitation, hourlyData.value("precipitation").toList(), hourlyReduction("precipitation"));
+    assignTiered<double>(&series->hourlyTemperature, hourlyData.value("temperature_2m").toList(), hourlyReduction("temperature_2m"));
+    assignTiered<int>(&series->hourlyVisibility, hourlyData.value("visibility").toList(), hourlyReduction("visibility"));
+}
+
+void OpenMeteoForecastSource::assignHazardsToForecast(const HazardKernel::Hazards& hazards, MountainForecast* forecast) const
+{
+    MountainForecast::Series* const series = forecast->mutableSeries();
+    // The hazards are only as good as their worst hour.
+    assignTiered(&series->hourlyCloudBaseMargin, hazards.cloudBaseMargin, ForecastTiering::Reduction::Minimum);
+    assignTiered(&series->hourlyFreezingLevelMargin, hazards.freezingLevelMargin, ForecastTiering::Reduction::Minimum);
+    assignTiered(&series->hourlyWindChill, hazards.windChill, ForecastTiering::Reduction::Minimum);
+}
+
+void OpenMeteoForecastSource::assignDailyDataToForecast(const QMap<QString, QVariant>& dailyData, MountainForecast* forecast) const
+{
+    MountainForecast::Series* const series = forecast->mutableSeries();
+
+    const QVariantList times = dailyData.value("time").toList();
+    m_bufferPool.prepare(&series->dates, times.size());
+    for (qsizetype day = 0; day < times.size(); ++day)
+    {
+        if (!TimeAxis::parseIsoDate(times.at(day).toString(), &series->dates[day]))
+            series->dates[day] = QDate();
+    }
+
+    m_bufferPool.assign<int>(&series->dailyWeatherCode, dailyData.value("weathercode").toList());
+    m_bufferPool.assign<int>(&series->dailyWindDirection, dailyData.value("winddirection_10m_dominant").toList());
+    m_bufferPool.assign<double>(&series->dailyWindGusts, dailyData.value("windgusts_10m_max").toList());
+    m_bufferPool.assign<double>(&series->dailyWindSpeed, dailyData.value("windspeed_10m_max").toList());
+    m_bufferPool.assign<double>(&series->dailyPrecipitation, dailyData.value("precipitation_sum").toList());
+    m_bufferPool.assign<double>(&series->dailyMinimumWindChill, dailyData.value("windchill_min").toList());
+    m_bufferPool.assign<int>(&series->dailyFreezingLevelBelowSummitHours, dailyData.value("freezinglevel_below_summit_hours").toList());
+    m_bufferPool.assign<int>(&series->dailySummitInCloudHours, dailyData.value("summit_in_cloud_hours").toList());
+}
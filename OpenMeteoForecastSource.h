@@ -1,51 +1,184 @@
-// Copyright 2023 Esri
-
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-
-// Unless required by applicable law or agreed to in writing, software
-// distributed under the License is distributed on an "AS IS" BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-// See the License for the specific language governing permissions and
-// limitations under the License.
-
-#ifndef OPENMETEOFORECASTSOURCE_H
-#define OPENMETEOFORECASTSOURCE_H
-
-#include <QUrl>
-#include <QVariant>
-
-class Mountain;
-
-class OpenMeteoForecastSource : public QObject
-{
-    Q_OBJECT
-public:
-    explicit OpenMeteoForecastSource(QObject* parent = nullptr);
-
-    void MakeRequest(const double mountainLong, const double mountainLat, const double mountainElev, Mountain* mountain);
-
-private:
-    QUrl m_requestUrl;
-
-    void processResponse(const QJsonDocument& response, Mountain* mountain) const;
-    void assignHourlyDataToMountain(const QMap<QString, QVariant>& hourlyData, Mountain* mountain) const;
-    void assignDailyDataToMountain(const QMap<QString, QVariant>& dailyData, Mountain* mountain) const;
-
-    template<typename T>
-    QList<T> convertQVariantListToTypedList(QList<QVariant> qVariantList) const
-    {
-        QList<T> convertedList;
-        convertedList.reserve(qVariantList.size());
-        for (QVariant element : qVariantList)
-        {
-            T value = element.value<T>();
-            convertedList.emplaceBack(value);
-        }
-        return convertedList;
-    }
-};
-
-#endif // OPENMETEOFORECASTSOURCE_H
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENMETEOFORECASTSOURCE_H
+#define OPENMETEOFORECASTSOURCE_H
+
+#include <QHash>
+#include <QPointer>
+#include <QStringList>
+#include <QThreadPool>
+#include <QUrl>
+#include <QVariant>
+
+#include "ForecastBufferPool.h"
+#include "ForecastTiering.h"
+#include "HazardKernel.h"
+#include "TimeAxis.h"
+
+#include <memory>
+
+class Mountain;
+class MountainForecast;
+class QNetworkAccessManager;
+
+class OpenMeteoForecastSource : public QObject
+{
+    Q_OBJECT
+public:
+    // Where the daily values come from. Upstream takes the wind and weather codes from Open-Meteo's
+    // daily block and derives only the precipitation sums, which the hourly series already cover.
+    // Local requests hourly wind and weather codes instead of the daily block and derives every
+    // daily value, so they can be limited to the daylight hours.
+    enum class DailyAggregation
+    {
+        Upstream,
+        Local
+    };
+
+    // The hours the daily values are limited to: fixed hours of the local day (see setDaylightHours),
+    // from sunrise to sunset, or from the start to the end of civil twilight. The last two are worked
+    // out for each mountain and day, as winter days are shorter in the north of the catalog.
+    enum class DaylightWindow
+    {
+        FixedHours,
+        Sunlight,
+        CivilTwilight
+    };
+
+    // The longest forecast Open-Meteo gives.
+    static constexpr int maximumForecastDays = 16;
+
+    explicit OpenMeteoForecastSource(QObject* parent = nullptr);
+    ~OpenMeteoForecastSource() override;
+
+    QUrl getBaseUrl() const;
+    void setBaseUrl(const QUrl& baseUrl);
+    DailyAggregation getDailyAggregation() const;
+    void setDailyAggregation(DailyAggregation dailyAggregation);
+    void setDaylightHours(int firstHour, int lastHour);
+    DaylightWindow getDaylightWindow() const;
+    void setDaylightWindow(DaylightWindow daylightWindow);
+    double getEnsemblePercentile() const;
+    void setEnsemblePercentile(double percentile);
+    int getForecastDays() const;
+    void setForecastDays(int forecastDays);
+    QStringList getModels() const;
+    void setModels(const QStringList& models);
+    // How many calls Open-Meteo counts each request as. A request for more than 10 variables or more
+    // than 2 weeks counts as several calls, in proportion, and so does each model.
+    double getRequestCost() const;
+    // Requests go through this manager instead of one created by the source, for example one that
+    // serves recorded responses. The source does not take ownership of it.
+    void setNetworkAccessManager(QNetworkAccessManager* networkManager);
+    // How the hourly series are stored. By default the first 3 days are kept hourly and the rest as
+    // 3 hour steps.
+    ForecastTiering getTiering() const;
+    void setTiering(const ForecastTiering& tiering);
+
+    void MakeRequest(const double mountainLong, const double mountainLat, const double mountainElev, Mountain* mountain);
+    bool processReply(const QByteArray& jsonBytes, Mountain* mountain) const;
+
+    // Builds the next generation of a forecast from a reply without touching any Mountain, so it can be
+    // called on any thread. Returns null if the reply is not a forecast. The settings above are read
+    // while it runs, so they should only be changed while no requests are in flight.
+    std::shared_ptr<MountainForecast> parseReply(const QByteArray& jsonBytes) const;
+    // The same for several replies, such as those of a refresh, whose hazards are derived together in
+    // one pass of HazardKernel. The forecasts are in the order of the replies.
+    QList<std::shared_ptr<MountainForecast>> parseReplies(const QList<QByteArray>& replies) const;
+    const ForecastBufferPool& getBufferPool() const;
+    // For returning the generations that are dropped elsewhere, such as by ForecastViewportLoader.
+    ForecastBufferPool& getBufferPool();
+
+signals:
+    void replyReceived(Mountain* mountain, const QByteArray& jsonBytes);
+    void forecastReceived(Mountain* mountain);
+    void forecastFailed(Mountain* mountain, const QString& failureType);
+
+private:
+    // A reply waiting to be parsed along with the others that arrived with it.
+    struct PendingReply
+    {
+        QPointer<Mountain> mountain;
+        quint64 requestId = 0;
+        QByteArray jsonBytes;
+    };
+
+    // A reply that has been decoded, and whose hourly inputs have been added to the hazard batch.
+    struct DecodedResponse
+    {
+        QVariantMap response;
+        QVariantMap hourlyData;
+        QVariantMap dailyData;
+        TimeAxis hourlyTimeAxis;
+        std::shared_ptr<MountainForecast> forecast;
+        // The location of the reply in the hazard batch.
+        qsizetype location = -1;
+        qint64 decodeNanoseconds = 0;
+    };
+
+    // Filled from the parsing threads, which only have const access to the source.
+    mutable ForecastBufferPool m_bufferPool;
+    DailyAggregation m_dailyAggregation = DailyAggregation::Upstream;
+    int m_daylightFirstHour = 0;
+    int m_daylightLastHour = 24;
+    DaylightWindow m_daylightWindow = DaylightWindow::FixedHours;
+    double m_ensemblePercentile = 50.0;
+    int m_forecastDays = maximumForecastDays;
+    QStringList m_models;
+    QNetworkAccessManager* m_networkManager = nullptr;
+    QList<PendingReply> m_pendingReplies;
+    // The newest request whose forecast has been published for each mountain, so that a forecast
+    // which finished parsing late does not replace a newer one. Mountains are removed when they are
+    // destroyed.
+    QHash<const QObject*, quint64> m_publishedRequests;
+    QUrl m_requestUrl;
+    quint64 m_requestCounter = 0;
+    int m_requestsInFlight = 0;
+    QThreadPool m_threadPool;
+    ForecastTiering m_tiering{72, 3};
+
+    void forgetMountain(QObject* mountain);
+    void parsePendingReplies();
+    void publishParsedForecast(const PendingReply& reply, const std::shared_ptr<const MountainForecast>& forecast);
+    // Leaves the location of the decoded response at -1 if the reply is not a forecast.
+    void decodeResponse(const QByteArray& jsonBytes, DecodedResponse* decoded, HazardKernel::Batch* batch) const;
+    std::shared_ptr<MountainForecast> finishResponse(DecodedResponse* decoded, const HazardKernel::Hazards& hazards) const;
+    QStringList hourlyVariables() const;
+    QStringList dailyVariables() const;
+    // The statistics of hourly variables are tiered along with the series, which a null tiering skips.
+    QVariantMap mergeModels(const QVariantMap& data, const QStringList& variables, const ForecastTiering* tiering, MountainForecast* forecast) const;
+    void deriveDailyData(const QVariantMap& response, const TimeAxis& hourlyTimeAxis, const QVariantMap& hourlyData,
+                         const HazardKernel::Hazards& hazards, QVariantMap* dailyData) const;
+    void assignHourlyDataToForecast(const QMap<QString, QVariant>& hourlyData, MountainForecast* forecast) const;
+    void assignHazardsToForecast(const HazardKernel::Hazards& hazards, MountainForecast* forecast) const;
+    void assignDailyDataToForecast(const QMap<QString, QVariant>& dailyData, MountainForecast* forecast) const;
+
+    // Fills the buffer with the tiered values, reusing its storage in the same way as ForecastBufferPool::assign.
+    template<typename T>
+    void assignTiered(QList<T>* buffer, const QList<T>& values, ForecastTiering::Reduction reduction) const
+    {
+        m_bufferPool.prepare(buffer, m_tiering.tieredSize(values.size()));
+        m_tiering.apply(values.constData(), values.size(), buffer->data(), reduction);
+    }
+
+    // The same for a decoded series, which is converted as it is tiered.
+    template<typename T>
+    void assignTiered(QList<T>* buffer, const QVariantList& values, ForecastTiering::Reduction reduction) const
+    {
+        m_bufferPool.prepare(buffer, m_tiering.tieredSize(values.size()));
+        m_tiering.apply(values, buffer->data(), reduction);
+    }
+};
+
+#endif // OPENMETEOFORECASTSOURCE_H
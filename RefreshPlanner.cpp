@@ -0,0 +1,382 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "RefreshPlanner.h"
+#include "Metrics.h"
+#include "Mountain.h"
+#include "Tracer.h"
+
+#include <QDebug>
+#include <QTimeZone>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr int planIntervalInMilliseconds = 5 * 60 * 1000;
+    // Long enough to gather the changes of a pan or a selection into one plan.
+    constexpr int planSoonDelayInMilliseconds = 1000;
+    constexpr qint64 retryDelayInSeconds = 15 * 60;
+    constexpr qint64 secondsInADay = 24 * 60 * 60;
+
+    qint64 floorDivide(qint64 value, qint64 divisor)
+    {
+        const qint64 quotient = value / divisor;
+        return quotient * divisor > value ? quotient - 1 : quotient;
+    }
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+RefreshPlanner::RefreshPlanner(QObject* parent) :
+    QObject{parent}
+{
+    m_planTimer.setInterval(planIntervalInMilliseconds);
+    connect(&m_planTimer, &QTimer::timeout, this, &RefreshPlanner::planAndRequest);
+
+    m_planSoonTimer.setSingleShot(true);
+    m_planSoonTimer.setInterval(planSoonDelayInMilliseconds);
+    connect(&m_planSoonTimer, &QTimer::timeout, this, &RefreshPlanner::planAndRequest);
+
+    bool validBudget = false;
+    const int dailyBudget = qEnvironmentVariable("CONDITIONS_NAVIGATOR_DAILY_REQUEST_BUDGET").toInt(&validBudget);
+    if (validBudget)
+        setDailyBudget(dailyBudget);
+
+    // For example 360/240 for models that run every 6 hours and can be retrieved 4 hours later.
+    const QStringList schedule = qEnvironmentVariable("CONDITIONS_NAVIGATOR_MODEL_RUN_SCHEDULE").split('/');
+    if (schedule.size() == 2)
+        setModelRunSchedule(schedule.first().toInt(), schedule.last().toInt());
+
+    publishBudget();
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+bool RefreshPlanner::isActive() const
+{
+    return m_active;
+}
+
+void RefreshPlanner::setActive(bool active)
+{
+    if (active == m_active)
+        return;
+
+    m_active = active;
+    if (m_active)
+    {
+        m_planTimer.start();
+        planSoon();
+    }
+    else
+    {
+        m_planTimer.stop();
+        m_planSoonTimer.stop();
+    }
+}
+
+int RefreshPlanner::getDailyBudget() const
+{
+    return m_dailyBudget;
+}
+
+void RefreshPlanner::setDailyBudget(int dailyBudget)
+{
+    if (dailyBudget < 0)
+    {
+        qWarning() << "Ignoring invalid daily request budget" << dailyBudget;
+        return;
+    }
+
+    m_dailyBudget = dailyBudget;
+    // The share of the current model run is worked out again from the new budget.
+    m_latestModelRun = QDateTime();
+    publishBudget();
+}
+
+double RefreshPlanner::getRequestCost() const
+{
+    return m_requestCost;
+}
+
+void RefreshPlanner::setRequestCost(double requestCost)
+{
+    if (!(requestCost >= 0.0))
+    {
+        qWarning() << "Ignoring invalid request cost" << requestCost;
+        return;
+    }
+
+    m_requestCost = requestCost;
+}
+
+int RefreshPlanner::getModelRunIntervalMinutes() const
+{
+    return m_modelRunIntervalMinutes;
+}
+
+int RefreshPlanner::getModelRunDelayMinutes() const
+{
+    return m_modelRunDelayMinutes;
+}
+
+void RefreshPlanner::setModelRunSchedule(int intervalMinutes, int delayMinutes)
+{
+    if (intervalMinutes <= 0 || delayMinutes < 0)
+    {
+        qWarning() << "Ignoring invalid model run schedule" << intervalMinutes << delayMinutes;
+        return;
+    }
+
+    m_modelRunIntervalMinutes = intervalMinutes;
+    m_modelRunDelayMinutes = delayMinutes;
+    m_latestModelRun = QDateTime();
+}
+
+void RefreshPlanner::setMountains(const QList<Mountain*>& mountains)
+{
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    for (Mountain* mountain : mountains)
+    {
+        // A mountain may already have a forecast, for example from a snapshot, whose age is unknown
+        // and so is taken to be stale.
+        if (!mountain->getForecast()->getHourlyTimeAxis().isEmpty())
+            m_retrievedAt.insert(mountain, now - secondsInADay);
+
+        connect(mountain, &Mountain::forecastUpdated, this, [this, mountain]()
+        {
+            forecastUpdated(mountain);
+        });
+    }
+}
+
+void RefreshPlanner::setViewport(const QRectF& viewport)
+{
+    m_viewport = viewport.normalized();
+    planSoon();
+}
+
+void RefreshPlanner::setSelectedMountain(Mountain* mountain)
+{
+    m_selectedMountain = mountain;
+    planSoon();
+}
+
+void RefreshPlanner::setFavourite(Mountain* mountain, bool favourite)
+{
+    if (favourite)
+        m_favourites.insert(mountain);
+    else
+        m_favourites.remove(mountain);
+}
+
+void RefreshPlanner::setFilteredGood(Mountain* mountain, bool filteredGood)
+{
+    if (filteredGood)
+        m_filteredGood.insert(mountain);
+    else
+        m_filteredGood.remove(mountain);
+}
+
+double RefreshPlanner::requestsToday() const
+{
+    return m_requestsToday;
+}
+
+double RefreshPlanner::remainingBudget() const
+{
+    return std::max(m_dailyBudget - m_requestsToday, 0.0);
+}
+
+int RefreshPlanner::deferredCount() const
+{
+    return m_deferredCount;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+int RefreshPlanner::interestOf(const Mountain* mountain) const
+{
+    int interest = NoInterest;
+    if (m_viewport.contains(mountain->getLongitude(), mountain->getLatitude()))
+        interest |= Viewed;
+    if (m_filteredGood.contains(mountain))
+        interest |= FilteredGood;
+    if (m_favourites.contains(mountain))
+        interest |= Favourite;
+    if (mountain == m_selectedMountain)
+        interest |= Selected;
+    return interest;
+}
+
+QDateTime RefreshPlanner::latestModelRun(const QDateTime& now) const
+{
+    const qint64 interval = m_modelRunIntervalMinutes * 60;
+    const qint64 delay = m_modelRunDelayMinutes * 60;
+    const qint64 latestRun = floorDivide(now.toSecsSinceEpoch() - delay, interval) * interval + delay;
+    return QDateTime::fromSecsSinceEpoch(latestRun, QTimeZone::UTC);
+}
+
+void RefreshPlanner::recordRequest()
+{
+    startDayIfNeeded(QDateTime::currentDateTimeUtc());
+    m_requestsToday += m_requestCost;
+    publishBudget();
+}
+
+void RefreshPlanner::refreshFailed(Mountain* mountain)
+{
+    refreshFailedAt(mountain, QDateTime::currentDateTimeUtc());
+}
+
+void RefreshPlanner::refreshFailedAt(Mountain* mountain, const QDateTime& failedAt)
+{
+    if (!m_pending.remove(mountain))
+        return;
+
+    m_lastFailure.insert(mountain, failedAt.toSecsSinceEpoch());
+}
+
+QList<Mountain*> RefreshPlanner::plan(const QDateTime& now)
+{
+    TRACE_SCOPE("planRefreshes");
+
+    startDayIfNeeded(now);
+
+    // The budget left for the day is shared between this model run and those still to come today.
+    const QDateTime latestRun = latestModelRun(now);
+    if (latestRun != m_latestModelRun)
+    {
+        m_latestModelRun = latestRun;
+        const qint64 secondsToMidnight = now.toUTC().secsTo(QDateTime(m_budgetDay.addDays(1), QTime(0, 0), QTimeZone::UTC));
+        const qint64 runsRemaining = 1 + secondsToMidnight / (m_modelRunIntervalMinutes * 60);
+        m_runAllowance = remainingBudget() / runsRemaining;
+    }
+
+    struct Candidate
+    {
+        Mountain* mountain;
+        double score;
+    };
+
+    const qint64 nowSeconds = now.toSecsSinceEpoch();
+    const qint64 latestRunSeconds = latestRun.toSecsSinceEpoch();
+    const double intervalSeconds = m_modelRunIntervalMinutes * 60.0;
+
+    QList<Candidate> candidates;
+    for (auto retrieved = m_retrievedAt.cbegin(); retrieved != m_retrievedAt.cend(); ++retrieved)
+    {
+        Mountain* mountain = retrieved.key();
+        if (retrieved.value() >= latestRunSeconds || m_pending.contains(mountain))
+            continue;
+
+        const auto lastFailure = m_lastFailure.constFind(mountain);
+        if (lastFailure != m_lastFailure.cend() && nowSeconds - *lastFailure < retryDelayInSeconds)
+            continue;
+
+        const int interest = interestOf(mountain);
+        if (interest == NoInterest)
+            continue;
+
+        // Interest comes first. Among mountains of the same interest, the oldest forecasts come first.
+        const double age = (nowSeconds - retrieved.value()) / intervalSeconds;
+        candidates.append({mountain, interest * 1000.0 + std::min(age, 999.0)});
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& first, const Candidate& second)
+    {
+        return first.score > second.score;
+    });
+
+    // Without a cost, as for requests answered by a forecast service, only the candidates limit the plan.
+    const double spendable = std::min(m_runAllowance, remainingBudget());
+    const qsizetype affordable = m_requestCost > 0.0 ? static_cast<qsizetype>(std::floor(spendable / m_requestCost)) : candidates.size();
+    const qsizetype numberToRefresh = std::min(candidates.size(), affordable);
+    QList<Mountain*> refreshes;
+    refreshes.reserve(numberToRefresh);
+    for (qsizetype index = 0; index < numberToRefresh; ++index)
+    {
+        Mountain* mountain = candidates.at(index).mountain;
+        m_pending.insert(mountain);
+        refreshes.append(mountain);
+    }
+
+    m_requestsToday += numberToRefresh * m_requestCost;
+    m_runAllowance -= numberToRefresh * m_requestCost;
+    m_deferredCount = static_cast<int>(candidates.size() - numberToRefresh);
+
+    Metrics::instance().recordRefreshPlan(static_cast<int>(numberToRefresh), m_deferredCount);
+    publishBudget();
+    return refreshes;
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+void RefreshPlanner::forecastUpdated(Mountain* mountain)
+{
+    m_pending.remove(mountain);
+    m_lastFailure.remove(mountain);
+
+    // A mountain whose forecast has been dropped is no longer refreshed.
+    if (mountain->getForecast()->getHourlyTimeAxis().isEmpty())
+        m_retrievedAt.remove(mountain);
+    else
+        m_retrievedAt.insert(mountain, QDateTime::currentSecsSinceEpoch());
+}
+
+void RefreshPlanner::planAndRequest()
+{
+    if (!m_active)
+        return;
+
+    const QList<Mountain*> refreshes = plan(QDateTime::currentDateTimeUtc());
+    for (Mountain* mountain : refreshes)
+        emit refreshRequested(mountain);
+}
+
+void RefreshPlanner::planSoon()
+{
+    if (m_active && !m_planSoonTimer.isActive())
+        m_planSoonTimer.start();
+}
+
+void RefreshPlanner::publishBudget()
+{
+    // Published whenever the budget changes rather than only with a plan, as nothing is planned while
+    // the app is in the background or takes its forecasts from a forecast service.
+    Metrics::instance().recordRequestBudget(static_cast<int>(std::ceil(m_requestsToday)), m_dailyBudget);
+    emit budgetChanged();
+}
+
+void RefreshPlanner::startDayIfNeeded(const QDateTime& now)
+{
+    const QDate today = now.toUTC().date();
+    if (today == m_budgetDay)
+        return;
+
+    m_budgetDay = today;
+    m_requestsToday = 0.0;
+    // The allowance of the current model run is worked out again from the new day's budget.
+    m_latestModelRun = QDateTime();
+    publishBudget();
+}
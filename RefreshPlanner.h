@@ -0,0 +1,131 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef REFRESHPLANNER_H
+#define REFRESHPLANNER_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QRectF>
+#include <QSet>
+#include <QTimer>
+
+class Mountain;
+
+// Decides which of the loaded forecasts to request again, and when, so that a daily request budget
+// such as that of Open-Meteo's free tier is spent where it matters. A forecast is only stale once the
+// forecast models have run again since it was retrieved, as requesting it sooner returns the same
+// forecast. Stale forecasts are refreshed only for the mountains the user is interested in, most
+// interesting and oldest first. The budget left for the day is shared equally between the model runs
+// still to come, so that it is not all spent on the first of them. Days and model runs follow UTC.
+// Requests are counted as the number of calls Open-Meteo charges them as (see
+// OpenMeteoForecastSource::getRequestCost), which is more than one for a long or wide request.
+//
+// Planning only happens while the planner is active, so nothing is requested while the app is in the
+// background. The planner only asks for refreshes (see refreshRequested); the caller makes them.
+class RefreshPlanner : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int dailyBudget READ getDailyBudget NOTIFY budgetChanged)
+    Q_PROPERTY(double requestsToday READ requestsToday NOTIFY budgetChanged)
+    Q_PROPERTY(int deferredCount READ deferredCount NOTIFY budgetChanged)
+
+public:
+    // The reasons a mountain is of interest. Each outranks all of those below it together.
+    enum Interest
+    {
+        NoInterest = 0x0,
+        Viewed = 0x1,
+        FilteredGood = 0x2,
+        Favourite = 0x4,
+        Selected = 0x8
+    };
+
+    explicit RefreshPlanner(QObject* parent = nullptr);
+
+    bool isActive() const;
+    // Plans straight away when made active, and then every few minutes.
+    void setActive(bool active);
+    int getDailyBudget() const;
+    void setDailyBudget(int dailyBudget);
+    double getRequestCost() const;
+    // What each request counts against the budget.
+    void setRequestCost(double requestCost);
+    int getModelRunIntervalMinutes() const;
+    int getModelRunDelayMinutes() const;
+    // The models run every interval from 00:00 UTC and their forecasts can be retrieved the delay after.
+    void setModelRunSchedule(int intervalMinutes, int delayMinutes);
+    void setMountains(const QList<Mountain*>& mountains);
+    // Viewports are rectangles of longitude (x) and latitude (y), as for ForecastViewportLoader.
+    void setViewport(const QRectF& viewport);
+    void setSelectedMountain(Mountain* mountain);
+    void setFavourite(Mountain* mountain, bool favourite);
+    void setFilteredGood(Mountain* mountain, bool filteredGood);
+
+    double requestsToday() const;
+    double remainingBudget() const;
+    // The stale forecasts of interest that the last plan left for a later one.
+    int deferredCount() const;
+    int interestOf(const Mountain* mountain) const;
+    // When the forecast of the newest model run could first be retrieved.
+    QDateTime latestModelRun(const QDateTime& now) const;
+
+    // Counts a request made for another reason, such as loading a mountain that came into view,
+    // against the budget.
+    void recordRequest();
+    // A refresh that failed is not tried again for a while, so a failing source does not use up the budget.
+    void refreshFailed(Mountain* mountain);
+    void refreshFailedAt(Mountain* mountain, const QDateTime& failedAt);
+
+    // The forecasts to refresh now, most interesting first, which are counted against the budget as
+    // if they had been requested.
+    QList<Mountain*> plan(const QDateTime& now);
+
+signals:
+    void refreshRequested(Mountain* mountain);
+    void budgetChanged();
+
+private:
+    void forecastUpdated(Mountain* mountain);
+    void planAndRequest();
+    void planSoon();
+    void publishBudget();
+    void startDayIfNeeded(const QDateTime& now);
+
+    bool m_active = false;
+    QDate m_budgetDay;
+    int m_dailyBudget = 10000;
+    int m_deferredCount = 0;
+    QSet<const Mountain*> m_favourites;
+    QSet<const Mountain*> m_filteredGood;
+    QHash<const Mountain*, qint64> m_lastFailure;
+    QDateTime m_latestModelRun;
+    int m_modelRunDelayMinutes = 240;
+    int m_modelRunIntervalMinutes = 360;
+    QSet<const Mountain*> m_pending;
+    QTimer m_planSoonTimer;
+    QTimer m_planTimer;
+    double m_requestCost = 1.0;
+    double m_requestsToday = 0.0;
+    // When each loaded forecast was retrieved, in seconds since 1970-01-01T00:00Z.
+    QHash<Mountain*, qint64> m_retrievedAt;
+    // What may still be spent on the forecasts of the latest model run.
+    double m_runAllowance = 0.0;
+    const Mountain* m_selectedMountain = nullptr;
+    QRectF m_viewport;
+};
+
+#endif // REFRESHPLANNER_H
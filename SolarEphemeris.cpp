@@ -0,0 +1,115 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SolarEphemeris.h"
+#include "Tracer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr double degreesToRadians = 3.14159265358979323846 / 180.0;
+
+    // The Julian date of 2000-01-01T12:00Z, from which the orbital elements are measured, and of
+    // 1970-01-01T00:00Z.
+    constexpr double julianDate2000 = 2451545.0;
+    constexpr double julianDateUnixEpoch = 2440587.5;
+    constexpr double secondsPerDay = 86400.0;
+
+    constexpr double obliquityOfEcliptic = 23.4397 * degreesToRadians;
+
+    // The sun is seen this many degrees further below the horizon for each square root of a metre above it.
+    constexpr double horizonDipPerRootMetre = 2.076 / 60.0;
+
+    qint64 toUnixSeconds(double julianDate)
+    {
+        return std::llround((julianDate - julianDateUnixEpoch) * secondsPerDay);
+    }
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+void SolarEphemeris::Batch::append(double latitude, double longitude, double elevation, QDate date)
+{
+    this->latitude.append(latitude);
+    this->longitude.append(longitude);
+    this->elevation.append(elevation);
+    julianDay.append(date.toJulianDay());
+}
+
+void SolarEphemeris::Batch::clear()
+{
+    // Keeps the storage for the next batch.
+    latitude.resize(0);
+    longitude.resize(0);
+    elevation.resize(0);
+    julianDay.resize(0);
+}
+
+qsizetype SolarEphemeris::Batch::size() const
+{
+    return julianDay.size();
+}
+
+void SolarEphemeris::compute(const Batch& batch, double solarAltitude, Windows* windows)
+{
+    TRACE_SCOPE("computeDaylight");
+
+    const qsizetype size = batch.size();
+    windows->begin.resize(size);
+    windows->end.resize(size);
+
+    const double* const latitudes = batch.latitude.constData();
+    const double* const longitudes = batch.longitude.constData();
+    const double* const elevations = batch.elevation.constData();
+    const qint64* const julianDays = batch.julianDay.constData();
+    qint64* const begin = windows->begin.data();
+    qint64* const end = windows->end.data();
+
+    for (qsizetype index = 0; index < size; ++index)
+    {
+        // The days since 2000-01-01 at the location's mean solar noon. A Julian day number starts at
+        // noon UTC, and noon comes earlier to the east.
+        const double meanSolarNoon = static_cast<double>(julianDays[index]) - julianDate2000 + 0.0008 - longitudes[index] / 360.0;
+
+        const double meanAnomaly = std::fmod(357.5291 + 0.98560028 * meanSolarNoon, 360.0) * degreesToRadians;
+        const double equationOfCentre = 1.9148 * std::sin(meanAnomaly) + 0.0200 * std::sin(2.0 * meanAnomaly) +
+                                        0.0003 * std::sin(3.0 * meanAnomaly);
+        const double eclipticLongitude = std::fmod(meanAnomaly / degreesToRadians + equationOfCentre + 180.0 + 102.9372, 360.0) * degreesToRadians;
+        const double solarTransit = julianDate2000 + meanSolarNoon + 0.0053 * std::sin(meanAnomaly) - 0.0069 * std::sin(2.0 * eclipticLongitude);
+
+        const double sinDeclination = std::sin(eclipticLongitude) * std::sin(obliquityOfEcliptic);
+        const double cosDeclination = std::sqrt(1.0 - sinDeclination * sinDeclination);
+
+        const double latitude = latitudes[index] * degreesToRadians;
+        const double altitude = (solarAltitude - horizonDipPerRootMetre * std::sqrt(std::max(elevations[index], 0.0))) * degreesToRadians;
+        const double cosHourAngle = (std::sin(altitude) - std::sin(latitude) * sinDeclination) / (std::cos(latitude) * cosDeclination);
+
+        // Outside [-1, 1] the sun does not cross the altitude that day. Clamping gives a window of no
+        // length or of the whole day, without a branch.
+        const double hourAngle = std::acos(std::clamp(cosHourAngle, -1.0, 1.0)) / (2.0 * 3.14159265358979323846);
+
+        begin[index] = toUnixSeconds(solarTransit - hourAngle);
+        end[index] = toUnixSeconds(solarTransit + hourAngle);
+    }
+}
+
+SolarEphemeris::Windows SolarEphemeris::compute(const Batch& batch, double solarAltitude)
+{
+    Windows windows;
+    compute(batch, solarAltitude, &windows);
+    return windows;
+}
@@ -0,0 +1,60 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SOLAREPHEMERIS_H
+#define SOLAREPHEMERIS_H
+
+#include <QDate>
+#include <QList>
+
+// Works out when the sun rises and sets, or when civil twilight begins and ends, at a location on a
+// given day, without asking Open-Meteo. It uses the sunrise equation of NOAA's solar calculator,
+// which is accurate to a few minutes at the latitudes of the catalog. Any number of location-days
+// are computed together from flat arrays, with no branches in the loop, so that it can be vectorised.
+class SolarEphemeris
+{
+public:
+    // The altitude of the centre of the sun at the start and end of daylight, in degrees. Sunrise
+    // allows for the refraction of the atmosphere and the size of the sun's disc.
+    static constexpr double sunriseAltitude = -0.833;
+    static constexpr double civilTwilightAltitude = -6.0;
+
+    struct Batch
+    {
+        // Degrees, with east and north positive.
+        QList<double> latitude;
+        QList<double> longitude;
+        // Metres above sea level. The horizon is lower from a summit, so the sun rises earlier there.
+        QList<double> elevation;
+        QList<qint64> julianDay;
+
+        void append(double latitude, double longitude, double elevation, QDate date);
+        void clear();
+        qsizetype size() const;
+    };
+
+    // The UTC times at which daylight begins and ends, in seconds since 1970-01-01T00:00Z. On a day the
+    // sun stays below the altitude both are at solar noon, and on a day it stays above they are 12
+    // hours either side of it.
+    struct Windows
+    {
+        QList<qint64> begin;
+        QList<qint64> end;
+    };
+
+    // Reuses the storage of the windows from a previous call.
+    static void compute(const Batch& batch, double solarAltitude, Windows* windows);
+    static Windows compute(const Batch& batch, double solarAltitude);
+};
+
+#endif // SOLAREPHEMERIS_H
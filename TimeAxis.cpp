@@ -0,0 +1,276 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TimeAxis.h"
+#include "Tracer.h"
+
+#include <QDebug>
+#include <QTime>
+
+#include <algorithm>
+
+namespace
+{
+    constexpr qint64 secondsInADay = 24 * 60 * 60;
+    constexpr qint64 julianDayOfEpoch = 2440588;
+
+    qint64 floorDivide(qint64 value, qint64 divisor)
+    {
+        const qint64 quotient = value / divisor;
+        return quotient * divisor > value ? quotient - 1 : quotient;
+    }
+
+    // Reads a fixed number of digits starting at position, returning false if any is not a digit.
+    bool readDigits(QStringView text, qsizetype position, int numberOfDigits, int* value)
+    {
+        int result = 0;
+        for (int digit = 0; digit < numberOfDigits; ++digit)
+        {
+            const unsigned int character = text.at(position + digit).unicode() - u'0';
+            if (character > 9)
+                return false;
+            result = result * 10 + static_cast<int>(character);
+        }
+        *value = result;
+        return true;
+    }
+
+    // The number of days from 1970-01-01 to the given date in the proleptic Gregorian calendar,
+    // after Howard Hinnant's days_from_civil.
+    qint64 daysFromCivil(qint64 year, int month, int day)
+    {
+        year -= month <= 2 ? 1 : 0;
+        const qint64 era = floorDivide(year, 400);
+        const qint64 yearOfEra = year - era * 400;
+        const qint64 dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        const qint64 dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    bool readDate(QStringView text, qint64* days)
+    {
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        if (text.size() < 10 || text.at(4) != u'-' || text.at(7) != u'-' ||
+            !readDigits(text, 0, 4, &year) || !readDigits(text, 5, 2, &month) || !readDigits(text, 8, 2, &day) ||
+            !QDate::isValid(year, month, day))
+            return false;
+
+        *days = daysFromCivil(year, month, day);
+        return true;
+    }
+}
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+TimeAxis::TimeAxis(qint64 originSeconds, int stepSeconds, qsizetype size, int utcOffsetSeconds) :
+    m_originSeconds(originSeconds),
+    m_stepSeconds(stepSeconds),
+    m_size(size),
+    m_utcOffsetSeconds(utcOffsetSeconds),
+    m_coarseStartIndex(size),
+    m_coarseStepSeconds(stepSeconds)
+{
+}
+
+TimeAxis::TimeAxis(qint64 originSeconds, int stepSeconds, qsizetype size, int utcOffsetSeconds, qsizetype coarseStartIndex, int coarseStepSeconds) :
+    m_originSeconds(originSeconds),
+    m_stepSeconds(stepSeconds),
+    m_size(size),
+    m_utcOffsetSeconds(utcOffsetSeconds),
+    m_coarseStartIndex(std::min(coarseStartIndex, size)),
+    m_coarseStepSeconds(coarseStepSeconds)
+{
+}
+
+// ------------------------------------- //
+//     Property Getters and Setters      //
+// ------------------------------------- //
+
+qint64 TimeAxis::getOriginSeconds() const
+{
+    return m_originSeconds;
+}
+
+int TimeAxis::getStepSeconds() const
+{
+    return m_stepSeconds;
+}
+
+qsizetype TimeAxis::getCoarseStartIndex() const
+{
+    return m_coarseStartIndex;
+}
+
+int TimeAxis::getCoarseStepSeconds() const
+{
+    return m_coarseStepSeconds;
+}
+
+int TimeAxis::getUtcOffsetSeconds() const
+{
+    return m_utcOffsetSeconds;
+}
+
+qsizetype TimeAxis::size() const
+{
+    return m_size;
+}
+
+bool TimeAxis::isEmpty() const
+{
+    return m_size == 0;
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+TimeAxis TimeAxis::fromIsoStrings(const QVariantList& times, int utcOffsetSeconds)
+{
+    TRACE_SCOPE("parseTimeAxis");
+
+    if (times.isEmpty())
+        return {};
+
+    qint64 origin = 0;
+    if (!parseIsoDateTime(times.first().toString(), &origin))
+    {
+        qWarning() << "Unable to parse the time" << times.first();
+        return {};
+    }
+
+    qint64 step = 3600;
+    if (times.size() > 1)
+    {
+        qint64 second = 0;
+        if (!parseIsoDateTime(times.at(1).toString(), &second) || second <= origin)
+        {
+            qWarning() << "Unable to parse the time" << times.at(1);
+            return {};
+        }
+        step = second - origin;
+    }
+
+    // Every time is checked, but none is kept.
+    for (qsizetype index = 2; index < times.size(); ++index)
+    {
+        qint64 seconds = 0;
+        if (!parseIsoDateTime(times.at(index).toString(), &seconds) || seconds != origin + index * step)
+        {
+            qWarning() << "Times are not evenly spaced at" << times.at(index);
+            return {};
+        }
+    }
+
+    return TimeAxis(origin - utcOffsetSeconds, static_cast<int>(step), times.size(), utcOffsetSeconds);
+}
+
+bool TimeAxis::parseIsoDateTime(QStringView text, qint64* seconds)
+{
+    qint64 days = 0;
+    if (!readDate(text, &days))
+        return false;
+
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    if (text.size() == 10)
+    {
+        // A date on its own is the start of the day.
+    }
+    else if (text.size() == 16 || text.size() == 19)
+    {
+        if (text.at(10) != u'T' || text.at(13) != u':' ||
+            !readDigits(text, 11, 2, &hour) || !readDigits(text, 14, 2, &minute) || hour > 23 || minute > 59)
+            return false;
+
+        if (text.size() == 19 && (text.at(16) != u':' || !readDigits(text, 17, 2, &second) || second > 59))
+            return false;
+    }
+    else
+    {
+        return false;
+    }
+
+    *seconds = days * secondsInADay + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
+bool TimeAxis::parseIsoDate(QStringView text, QDate* date)
+{
+    qint64 days = 0;
+    if (text.size() != 10 || !readDate(text, &days))
+        return false;
+
+    *date = QDate::fromJulianDay(days + julianDayOfEpoch);
+    return true;
+}
+
+qint64 TimeAxis::getUtcSeconds(qsizetype index) const
+{
+    // Entries beyond the end, such as the extra ones of toDateTimes, continue at the coarse step.
+    const qsizetype fineEntries = std::min(index, m_coarseStartIndex);
+    return m_originSeconds + fineEntries * m_stepSeconds + (index - fineEntries) * m_coarseStepSeconds;
+}
+
+qint64 TimeAxis::getLocalSeconds(qsizetype index) const
+{
+    return getUtcSeconds(index) + m_utcOffsetSeconds;
+}
+
+QDate TimeAxis::getDate(qsizetype index) const
+{
+    return QDate::fromJulianDay(floorDivide(getLocalSeconds(index), secondsInADay) + julianDayOfEpoch);
+}
+
+int TimeAxis::getHour(qsizetype index) const
+{
+    const qint64 localSeconds = getLocalSeconds(index);
+    return static_cast<int>((localSeconds - floorDivide(localSeconds, secondsInADay) * secondsInADay) / 3600);
+}
+
+QDateTime TimeAxis::getDateTime(qsizetype index) const
+{
+    const qint64 localSeconds = getLocalSeconds(index);
+    const qint64 days = floorDivide(localSeconds, secondsInADay);
+    const QTime time = QTime::fromMSecsSinceStartOfDay(static_cast<int>((localSeconds - days * secondsInADay) * 1000));
+    return QDateTime(QDate::fromJulianDay(days + julianDayOfEpoch), time);
+}
+
+QList<QDateTime> TimeAxis::toDateTimes(qsizetype extraEntries) const
+{
+    QList<QDateTime> dateTimes;
+    if (m_size == 0)
+        return dateTimes;
+
+    dateTimes.reserve(m_size + extraEntries);
+    for (qsizetype index = 0; index < m_size + extraEntries; ++index)
+        dateTimes.append(getDateTime(index));
+    return dateTimes;
+}
+
+bool TimeAxis::operator==(const TimeAxis& other) const
+{
+    return m_originSeconds == other.m_originSeconds && m_stepSeconds == other.m_stepSeconds &&
+           m_size == other.m_size && m_utcOffsetSeconds == other.m_utcOffsetSeconds &&
+           m_coarseStartIndex == other.m_coarseStartIndex && m_coarseStepSeconds == other.m_coarseStepSeconds;
+}
+
+bool TimeAxis::operator!=(const TimeAxis& other) const
+{
+    return !(*this == other);
+}
@@ -0,0 +1,75 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIMEAXIS_H
+#define TIMEAXIS_H
+
+#include <QDate>
+#include <QDateTime>
+#include <QList>
+#include <QStringView>
+#include <QVariant>
+
+// The times of an evenly spaced series, held as the UTC time of the first entry, the step between
+// entries and the offset of the location's timezone, rather than as one QDateTime per entry.
+// Open-Meteo gives times as wall clock times in the location's timezone ("2023-09-18T14:00") along
+// with that timezone's offset, and the wall clock times are what the charts and daily values use.
+// A tiered axis (see ForecastTiering) changes to a longer step part of the way through.
+class TimeAxis
+{
+public:
+    TimeAxis() = default;
+    TimeAxis(qint64 originSeconds, int stepSeconds, qsizetype size, int utcOffsetSeconds);
+    // The entries from coarseStartIndex on are coarseStepSeconds apart.
+    TimeAxis(qint64 originSeconds, int stepSeconds, qsizetype size, int utcOffsetSeconds, qsizetype coarseStartIndex, int coarseStepSeconds);
+
+    // Returns an empty axis, with a warning, if any of the times cannot be parsed or they are not
+    // evenly spaced.
+    static TimeAxis fromIsoStrings(const QVariantList& times, int utcOffsetSeconds);
+
+    // Parses "YYYY-MM-DD", "YYYY-MM-DDTHH:MM" or "YYYY-MM-DDTHH:MM:SS" without allocating. The text
+    // has no timezone, so the result is the number of seconds from 1970-01-01T00:00 on the same clock.
+    static bool parseIsoDateTime(QStringView text, qint64* seconds);
+    static bool parseIsoDate(QStringView text, QDate* date);
+
+    qint64 getOriginSeconds() const;
+    int getStepSeconds() const;
+    qsizetype getCoarseStartIndex() const;
+    int getCoarseStepSeconds() const;
+    int getUtcOffsetSeconds() const;
+    qsizetype size() const;
+    bool isEmpty() const;
+
+    qint64 getUtcSeconds(qsizetype index) const;
+    qint64 getLocalSeconds(qsizetype index) const;
+    QDate getDate(qsizetype index) const;
+    int getHour(qsizetype index) const;
+
+    // Only needed where Qt wants real date/time values, such as the chart axes. Like the strings they
+    // came from, they have no timezone and so are in local time. Extra entries continue the series.
+    QDateTime getDateTime(qsizetype index) const;
+    QList<QDateTime> toDateTimes(qsizetype extraEntries = 0) const;
+
+    bool operator==(const TimeAxis& other) const;
+    bool operator!=(const TimeAxis& other) const;
+
+private:
+    qint64 m_originSeconds = 0;
+    int m_stepSeconds = 3600;
+    qsizetype m_size = 0;
+    int m_utcOffsetSeconds = 0;
+    qsizetype m_coarseStartIndex = 0;
+    int m_coarseStepSeconds = 3600;
+};
+
+#endif // TIMEAXIS_H
@@ -0,0 +1,176 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Tracer.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+
+std::atomic_bool Tracer::s_enabled{false};
+
+// ------------------------------------- //
+//              Constructor              //
+// ------------------------------------- //
+
+Tracer::Tracer()
+{
+    m_clock.start();
+}
+
+// ------------------------------------- //
+//            Public Methods             //
+// ------------------------------------- //
+
+Tracer& Tracer::instance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::configure(const QStringList& arguments)
+{
+    QString outputPath = qEnvironmentVariable("CONDITIONS_NAVIGATOR_TRACE");
+
+    const qsizetype traceOption = arguments.indexOf("--trace");
+    if (traceOption >= 0 && traceOption + 1 < arguments.size())
+        outputPath = arguments.at(traceOption + 1);
+
+    if (!outputPath.isEmpty())
+        start(outputPath);
+}
+
+void Tracer::start(const QString& outputPath)
+{
+    QMutexLocker locker(&m_mutex);
+    m_outputPath = outputPath;
+    m_events.clear();
+    m_events.reserve(4096);
+    s_enabled.store(true, std::memory_order_relaxed);
+}
+
+bool Tracer::stop()
+{
+    if (!isEnabled())
+        return false;
+
+    s_enabled.store(false, std::memory_order_relaxed);
+
+    QMutexLocker locker(&m_mutex);
+
+    QJsonArray traceEvents;
+    for (const TraceEvent& event : std::as_const(m_events))
+    {
+        QJsonObject traceEvent{
+            {"name", QString::fromLatin1(event.name)},
+            {"cat", "ConditionsNavigator"},
+            {"ph", QString(QLatin1Char(event.phase))},
+            {"ts", event.timestamp},
+            {"pid", QCoreApplication::applicationPid()},
+            {"tid", event.threadId}
+        };
+
+        switch (event.phase)
+        {
+        case 'X':
+            traceEvent.insert("dur", event.duration);
+            break;
+        case 'b':
+        case 'e':
+            // Async events are matched on category and id, so each kind of operation gets its own category.
+            traceEvent.insert("cat", QString::fromLatin1(event.name));
+            traceEvent.insert("id", QString::number(event.id));
+            break;
+        case 'C':
+            traceEvent.insert("args", QJsonObject{{"value", event.value}});
+            break;
+        case 'i':
+            traceEvent.insert("s", "t");
+            break;
+        }
+
+        if (!event.detail.isEmpty())
+            traceEvent.insert("args", QJsonObject{{"detail", event.detail}});
+
+        traceEvents.append(traceEvent);
+    }
+
+    const QJsonObject trace{{"traceEvents", traceEvents}, {"displayTimeUnit", "ms"}};
+
+    QFile traceFile(m_outputPath);
+    if (!traceFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Unable to write trace file" << m_outputPath;
+        return false;
+    }
+    traceFile.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    m_events.clear();
+    return true;
+}
+
+void Tracer::addAsyncBegin(const char* name, quint64 id, const QString& detail)
+{
+    if (isEnabled())
+        append({'b', name, nowMicroseconds(), 0, id, 0.0, currentThreadId(), detail});
+}
+
+void Tracer::addAsyncEnd(const char* name, quint64 id)
+{
+    if (isEnabled())
+        append({'e', name, nowMicroseconds(), 0, id, 0.0, currentThreadId(), QString()});
+}
+
+void Tracer::addCompleteEvent(const char* name, qint64 startMicroseconds, qint64 durationMicroseconds)
+{
+    if (isEnabled())
+        append({'X', name, startMicroseconds, durationMicroseconds, 0, 0.0, currentThreadId(), QString()});
+}
+
+void Tracer::addCounter(const char* name, double value)
+{
+    if (isEnabled())
+        append({'C', name, nowMicroseconds(), 0, 0, value, currentThreadId(), QString()});
+}
+
+void Tracer::addInstantEvent(const char* name, const QString& detail)
+{
+    if (isEnabled())
+        append({'i', name, nowMicroseconds(), 0, 0, 0.0, currentThreadId(), detail});
+}
+
+qint64 Tracer::nowMicroseconds() const
+{
+    return m_clock.nsecsElapsed() / 1000;
+}
+
+// ------------------------------------- //
+//            Private Methods            //
+// ------------------------------------- //
+
+void Tracer::append(TraceEvent&& event)
+{
+    QMutexLocker locker(&m_mutex);
+    m_events.append(std::move(event));
+}
+
+int Tracer::currentThreadId()
+{
+    // Small sequential ids read better in the trace viewer than native thread handles.
+    static std::atomic_int nextThreadId{1};
+    thread_local const int threadId = nextThreadId.fetch_add(1);
+    return threadId;
+}
@@ -0,0 +1,103 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+
+// Records spans and counters and writes them out as a Chrome trace (viewable in chrome://tracing
+// or https://ui.perfetto.dev). Tracing is enabled by the CONDITIONS_NAVIGATOR_TRACE environment
+// variable or the --trace command line option, both of which give the path of the trace file.
+// When tracing is disabled each trace point costs a single relaxed atomic load.
+class Tracer
+{
+public:
+    static Tracer& instance();
+
+    static bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    void configure(const QStringList& arguments);
+    void start(const QString& outputPath);
+    bool stop();
+
+    void addAsyncBegin(const char* name, quint64 id, const QString& detail = QString());
+    void addAsyncEnd(const char* name, quint64 id);
+    void addCompleteEvent(const char* name, qint64 startMicroseconds, qint64 durationMicroseconds);
+    void addCounter(const char* name, double value);
+    void addInstantEvent(const char* name, const QString& detail = QString());
+    qint64 nowMicroseconds() const;
+
+private:
+    struct TraceEvent
+    {
+        char phase;
+        const char* name;
+        qint64 timestamp;
+        qint64 duration;
+        quint64 id;
+        double value;
+        int threadId;
+        QString detail;
+    };
+
+    Tracer();
+    void append(TraceEvent&& event);
+    static int currentThreadId();
+
+    static std::atomic_bool s_enabled;
+
+    QElapsedTimer m_clock;
+    QList<TraceEvent> m_events;
+    QMutex m_mutex;
+    QString m_outputPath;
+};
+
+// Records the time between its construction and destruction as a span on the current thread.
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char* name) :
+        m_name(Tracer::isEnabled() ? name : nullptr),
+        m_start(m_name ? Tracer::instance().nowMicroseconds() : 0)
+    {
+    }
+
+    ~TraceSpan()
+    {
+        if (m_name)
+            Tracer::instance().addCompleteEvent(m_name, m_start, Tracer::instance().nowMicroseconds() - m_start);
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* const m_name;
+    const qint64 m_start;
+};
+
+#define TRACE_CONCATENATE_IMPL(first, second) first##second
+#define TRACE_CONCATENATE(first, second) TRACE_CONCATENATE_IMPL(first, second)
+#define TRACE_SCOPE(name) const TraceSpan TRACE_CONCATENATE(traceSpan, __LINE__)(name)
+
+#endif // TRACER_H
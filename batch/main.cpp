@@ -0,0 +1,108 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastArchive.h"
+#include "ForecastBatchRunner.h"
+#include "MetricsEndpoint.h"
+#include "Tracer.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFileInfo>
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ConditionsNavigatorBatch");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Fetches and classifies the forecast for every location in a catalog, "
+                                     "without the map, and writes the results to a file.");
+    parser.addHelpOption();
+
+    const QCommandLineOption catalogOption("catalog", "CSV file of name,latitude,longitude,elevation "
+                                           "(defaults to the built in list of Munros).", "file");
+    const QCommandLineOption outputOption("output", "File to write the results to.", "file");
+    const QCommandLineOption formatOption("format", "json, csv or binary (defaults to the output file extension).", "format");
+    const QCommandLineOption concurrencyOption("max-concurrent", "Maximum number of requests in flight (default 64).", "count", "64");
+    const QCommandLineOption modelsOption("models", "Comma separated forecast models to combine, for example "
+                                          "ukmo_seamless,ecmwf_ifs025,icon_seamless.", "models");
+    const QCommandLineOption percentileOption("percentile", "Percentile of the models to classify (default 50).", "percentile", "50");
+    const QCommandLineOption archiveOption("archive", "Also append the forecasts to the archive in this directory.", "directory");
+    const QCommandLineOption archiveHourlyOption("archive-hourly", "Also archive the hourly series, which makes each forecast about ten times larger.");
+    const QCommandLineOption traceOption("trace", "Write a Chrome trace of the run to the file.", "file");
+    const QCommandLineOption metricsPortOption("metrics-port", "Serve Prometheus metrics on this local port.", "port");
+    parser.addOptions({catalogOption, outputOption, formatOption, concurrencyOption, modelsOption, percentileOption,
+                       archiveOption, archiveHourlyOption, traceOption, metricsPortOption});
+    parser.process(app);
+
+    if (!parser.isSet(outputOption))
+    {
+        qCritical("--output is required");
+        return 1;
+    }
+    const QString outputPath = parser.value(outputOption);
+
+    ForecastBatchRunner::OutputFormat format = ForecastBatchRunner::OutputFormat::Json;
+    const QString formatName = parser.isSet(formatOption) ? parser.value(formatOption) : QFileInfo(outputPath).suffix();
+    if (!ForecastBatchRunner::outputFormatFromName(formatName, &format) && parser.isSet(formatOption))
+    {
+        qCritical("Unknown output format %s", qPrintable(formatName));
+        return 1;
+    }
+
+    QList<CatalogEntry> catalog;
+    if (parser.isSet(catalogOption))
+    {
+        QString errorMessage;
+        catalog = ForecastCatalog::load(parser.value(catalogOption), &errorMessage);
+        if (!errorMessage.isEmpty())
+        {
+            qCritical("Unable to read the catalog: %s", qPrintable(errorMessage));
+            return 1;
+        }
+    }
+    else
+    {
+        catalog = ForecastCatalog::builtIn();
+    }
+
+    Tracer::instance().configure(app.arguments());
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [](){ Tracer::instance().stop(); });
+
+    MetricsEndpoint metricsEndpoint;
+    metricsEndpoint.configure(app.arguments());
+
+    ForecastBatchRunner runner;
+    runner.setMaximumConcurrentRequests(parser.value(concurrencyOption).toInt());
+    if (parser.isSet(modelsOption))
+        runner.setModels(parser.value(modelsOption).split(',', Qt::SkipEmptyParts), parser.value(percentileOption).toDouble());
+    if (parser.isSet(archiveOption))
+    {
+        auto* archive = new ForecastArchive(parser.value(archiveOption), &runner);
+        archive->setIncludeHourly(parser.isSet(archiveHourlyOption));
+        runner.setArchive(archive);
+    }
+    QObject::connect(&runner, &ForecastBatchRunner::finished, &app, [](bool success){
+        QCoreApplication::exit(success ? 0 : 2);
+    });
+
+    if (!runner.start(catalog, outputPath, format))
+        return 1;
+
+    return app.exec();
+}
+
+//------------------------------------------------------------------------------
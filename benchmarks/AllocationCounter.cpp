@@ -0,0 +1,119 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+
+namespace
+{
+    std::atomic<quint64> s_allocations{0};
+    std::atomic<quint64> s_deallocations{0};
+}
+
+#if defined(__GLIBC__)
+
+// glibc's own implementations, which the replacements below forward to. Nothing here may allocate.
+extern "C"
+{
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t count, std::size_t size);
+    void* __libc_realloc(void* memory, std::size_t size);
+    void* __libc_memalign(std::size_t alignment, std::size_t size);
+    void __libc_free(void* memory);
+
+    void* malloc(std::size_t size)
+    {
+        void* const memory = __libc_malloc(size);
+        if (memory)
+            s_allocations.fetch_add(1, std::memory_order_relaxed);
+        return memory;
+    }
+
+    void* calloc(std::size_t count, std::size_t size)
+    {
+        void* const memory = __libc_calloc(count, size);
+        if (memory)
+            s_allocations.fetch_add(1, std::memory_order_relaxed);
+        return memory;
+    }
+
+    // A block that is grown in place is neither allocated nor freed; one that moves is both.
+    void* realloc(void* memory, std::size_t size)
+    {
+        void* const reallocated = __libc_realloc(memory, size);
+        if (reallocated != memory)
+        {
+            if (memory && (reallocated || size == 0))
+                s_deallocations.fetch_add(1, std::memory_order_relaxed);
+            if (reallocated)
+                s_allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        return reallocated;
+    }
+
+    void* aligned_alloc(std::size_t alignment, std::size_t size)
+    {
+        void* const memory = __libc_memalign(alignment, size);
+        if (memory)
+            s_allocations.fetch_add(1, std::memory_order_relaxed);
+        return memory;
+    }
+
+    int posix_memalign(void** memory, std::size_t alignment, std::size_t size)
+    {
+        if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+        void* const aligned = __libc_memalign(alignment, size);
+        if (aligned == nullptr)
+            return ENOMEM;
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        *memory = aligned;
+        return 0;
+    }
+
+    void free(void* memory)
+    {
+        if (memory == nullptr)
+            return;
+        s_deallocations.fetch_add(1, std::memory_order_relaxed);
+        __libc_free(memory);
+    }
+}
+
+bool AllocationCounter::isAvailable()
+{
+    return true;
+}
+
+#else
+
+bool AllocationCounter::isAvailable()
+{
+    return false;
+}
+
+#endif
+
+quint64 AllocationCounter::getAllocations()
+{
+    return s_allocations.load(std::memory_order_relaxed);
+}
+
+quint64 AllocationCounter::getDeallocations()
+{
+    return s_deallocations.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,32 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+// Counts the heap allocations made by the whole process. Qt allocates the storage of its containers
+// and strings with malloc rather than operator new, so malloc, calloc, realloc and free are replaced
+// in the executable that links AllocationCounter.cpp, which covers operator new as well. This relies
+// on the C library exporting its own entry points, which glibc does; elsewhere nothing is counted
+// and isAvailable is false.
+namespace AllocationCounter
+{
+    bool isAvailable();
+    // Blocks handed out, including those moved by realloc, and blocks given back.
+    quint64 getAllocations();
+    quint64 getDeallocations();
+}
+
+#endif // ALLOCATIONCOUNTER_H
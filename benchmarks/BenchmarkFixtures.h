@@ -0,0 +1,71 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BENCHMARKFIXTURES_H
+#define BENCHMARKFIXTURES_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+#include "Mountain.h"
+#include "MountainLocations.h"
+
+namespace BenchmarkFixtures
+{
+    // A response from Open-Meteo for a single mountain, in the format requested by OpenMeteoForecastSource.
+    inline QByteArray readForecastResponse()
+    {
+        QFile fixture(QStringLiteral(BENCHMARK_FIXTURES_DIR "/open-meteo-forecast.json"));
+        if (!fixture.open(QIODevice::ReadOnly))
+            return {};
+        return fixture.readAll();
+    }
+
+    // The Munro catalog, repeated with small offsets until it holds the requested number of locations.
+    inline QList<Mountain*> createCatalog(int numberOfLocations, QObject* parent)
+    {
+        const MountainLocations mountainLocations{parent};
+        const QList<Mountain*> munros = mountainLocations.getLocations();
+
+        QList<Mountain*> catalog;
+        catalog.reserve(numberOfLocations);
+        for (int index = 0; index < numberOfLocations; ++index)
+        {
+            const Mountain* munro = munros.at(index % munros.size());
+            const int copy = index / static_cast<int>(munros.size());
+            if (copy == 0)
+            {
+                catalog.append(munros.at(index));
+                continue;
+            }
+
+            const double offset = 0.001 * copy;
+            catalog.append(new Mountain(QString("%1 (%2)").arg(munro->getName()).arg(copy),
+                                        munro->getLatitude() + offset,
+                                        munro->getLongitude() - offset,
+                                        munro->getElevation(),
+                                        parent));
+        }
+
+        // The catalog may be smaller than the list of Munros.
+        for (qsizetype index = numberOfLocations; index < munros.size(); ++index)
+            delete munros.at(index);
+
+        return catalog;
+    }
+}
+
+#endif // BENCHMARKFIXTURES_H
@@ -0,0 +1,146 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CANNEDNETWORKACCESSMANAGER_H
+#define CANNEDNETWORKACCESSMANAGER_H
+
+#include <QByteArray>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+
+#include <algorithm>
+#include <cstring>
+
+// A reply that finishes with the given body, or error, from the event loop as a real one does.
+class CannedReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    CannedReply(const QNetworkRequest& request, const QByteArray& body, QNetworkReply::NetworkError error, QObject* parent) :
+        QNetworkReply(parent),
+        m_body(body)
+    {
+        setRequest(request);
+        setUrl(request.url());
+        setOperation(QNetworkAccessManager::GetOperation);
+        open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+        // Queued so that the caller can connect to the reply's signals first.
+        QMetaObject::invokeMethod(this, [this, error]() { finish(error); }, Qt::QueuedConnection);
+    }
+
+    void abort() override
+    {
+        finish(QNetworkReply::OperationCanceledError);
+    }
+
+    qint64 bytesAvailable() const override
+    {
+        return m_body.size() - m_offset + QNetworkReply::bytesAvailable();
+    }
+
+    bool isSequential() const override
+    {
+        return true;
+    }
+
+protected:
+    qint64 readData(char* data, qint64 maximumSize) override
+    {
+        const qint64 size = std::min<qint64>(maximumSize, m_body.size() - m_offset);
+        if (size <= 0)
+            return isFinished() ? -1 : 0;
+
+        std::memcpy(data, m_body.constData() + m_offset, static_cast<size_t>(size));
+        m_offset += size;
+        return size;
+    }
+
+private:
+    void finish(QNetworkReply::NetworkError error)
+    {
+        if (isFinished())
+            return;
+
+        if (error == QNetworkReply::NoError)
+        {
+            setAttribute(QNetworkRequest::HttpStatusCodeAttribute, 200);
+            emit metaDataChanged();
+            emit readyRead();
+        }
+        else
+        {
+            m_body.clear();
+            setError(error, QStringLiteral("Canned failure"));
+            emit errorOccurred(error);
+        }
+
+        setFinished(true);
+        emit finished();
+    }
+
+    QByteArray m_body;
+    qint64 m_offset = 0;
+};
+
+// Answers every request with a recorded response instead of going to the network. Some requests
+// can be made to fail, or to return a response that is cut short, so that the failure paths are
+// exercised too. Replies are children of the manager, so any that are never deleted can be counted.
+class CannedNetworkAccessManager : public QNetworkAccessManager
+{
+    Q_OBJECT
+
+public:
+    explicit CannedNetworkAccessManager(const QByteArray& response, QObject* parent = nullptr) :
+        QNetworkAccessManager(parent),
+        m_response(response)
+    {
+    }
+
+    // Every nth request fails with a network error, or returns half of the response.
+    void setFailureInterval(int failureInterval)
+    {
+        m_failureInterval = failureInterval;
+    }
+
+    void setTruncatedInterval(int truncatedInterval)
+    {
+        m_truncatedInterval = truncatedInterval;
+    }
+
+    quint64 requestCount() const
+    {
+        return m_requestCount;
+    }
+
+protected:
+    QNetworkReply* createRequest(Operation, const QNetworkRequest& request, QIODevice*) override
+    {
+        ++m_requestCount;
+        if (m_failureInterval > 0 && m_requestCount % m_failureInterval == 0)
+            return new CannedReply(request, QByteArray(), QNetworkReply::ConnectionRefusedError, this);
+        if (m_truncatedInterval > 0 && m_requestCount % m_truncatedInterval == 0)
+            return new CannedReply(request, m_response.left(m_response.size() / 2), QNetworkReply::NoError, this);
+        return new CannedReply(request, m_response, QNetworkReply::NoError, this);
+    }
+
+private:
+    QByteArray m_response;
+    int m_failureInterval = 0;
+    int m_truncatedInterval = 0;
+    quint64 m_requestCount = 0;
+};
+
+#endif // CANNEDNETWORKACCESSMANAGER_H
@@ -0,0 +1,876 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AllocationCounter.h"
+#include "BenchmarkFixtures.h"
+#include "ConditionsClassifier.h"
+#include "DailyAggregator.h"
+#include "ForecastArchive.h"
+#include "ForecastBufferPool.h"
+#include "ForecastEnsemble.h"
+#include "ForecastTiering.h"
+#include "ForecastViewportLoader.h"
+#include "HazardKernel.h"
+#include "Metrics.h"
+#include "Mountain.h"
+#include "MountainForecast.h"
+#include "MountainNameIndex.h"
+#include "OpenMeteoForecastSource.h"
+#include "RefreshPlanner.h"
+#include "SolarEphemeris.h"
+#include "TimeAxis.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTimeZone>
+#include <QtTest>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Measures the stages a forecast passes through between arriving from Open-Meteo and colouring
+// the pins, for catalogs of 282 (the Munros), 5,000 and 50,000 locations. Every location is given
+// the same recorded response so that results are comparable between runs and machines.
+class ForecastBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void decodeJson_data();
+    void decodeJson();
+    void ingestResponses_data();
+    void ingestResponses();
+    void assignTypedLists_data();
+    void assignTypedLists();
+    void parseTimeAxis_data();
+    void parseTimeAxis();
+    void deriveHazards_data();
+    void deriveHazards();
+    void computeDaylight_data();
+    void computeDaylight();
+    void tierHourlySeries_data();
+    void tierHourlySeries();
+    void groupTieredDays_data();
+    void groupTieredDays();
+    void planViewportLoading_data();
+    void planViewportLoading();
+    void evictForecasts();
+    void planRefreshes_data();
+    void planRefreshes();
+    void planRefreshesWithinBudget();
+    void searchNames_data();
+    void searchNames();
+    void classifyCatalog_data();
+    void classifyCatalog();
+    void aggregateCatalog_data();
+    void aggregateCatalog();
+    void mergeEnsemble_data();
+    void mergeEnsemble();
+    void archiveCatalog_data();
+    void archiveCatalog();
+    void queryArchive();
+
+private:
+    QByteArray m_response;
+
+    static void addCatalogSizes();
+};
+
+void ForecastBenchmark::initTestCase()
+{
+    m_response = BenchmarkFixtures::readForecastResponse();
+    QVERIFY2(!m_response.isEmpty(), "Unable to read the Open-Meteo fixture");
+    QVERIFY(QJsonDocument::fromJson(m_response).isObject());
+}
+
+void ForecastBenchmark::addCatalogSizes()
+{
+    QTest::addColumn<int>("numberOfLocations");
+    QTest::newRow("munros") << 282;
+    QTest::newRow("5k") << 5000;
+    QTest::newRow("50k") << 50000;
+}
+
+void ForecastBenchmark::decodeJson_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::decodeJson()
+{
+    QFETCH(int, numberOfLocations);
+
+    QBENCHMARK
+    {
+        for (int location = 0; location < numberOfLocations; ++location)
+        {
+            const QVariantMap response = QJsonDocument::fromJson(m_response).object().toVariantMap();
+            QVERIFY(!response.isEmpty());
+        }
+    }
+}
+
+void ForecastBenchmark::ingestResponses_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::ingestResponses()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+    const OpenMeteoForecastSource forecastSource;
+
+    QBENCHMARK
+    {
+        for (Mountain* mountain : catalog)
+            forecastSource.processReply(m_response, mountain);
+    }
+
+    // Once every mountain has been refreshed twice, the forecasts are filled into recycled buffers.
+    // What is still allocated on the heap, through malloc as well as operator new, is measured over
+    // two more refreshes of the catalog against the allocations of decoding the response alone.
+    if (AllocationCounter::isAvailable())
+    {
+        for (Mountain* mountain : catalog)
+            forecastSource.processReply(m_response, mountain);
+        const quint64 poolAllocations = forecastSource.getBufferPool().getAllocations();
+        QList<quint64> replyAllocations;
+        for (int refresh = 0; refresh < 2; ++refresh)
+        {
+            const quint64 firstAllocation = AllocationCounter::getAllocations();
+            for (Mountain* mountain : catalog)
+                forecastSource.processReply(m_response, mountain);
+            replyAllocations.append((AllocationCounter::getAllocations() - firstAllocation) / numberOfLocations);
+        }
+
+        const quint64 firstDecodeAllocation = AllocationCounter::getAllocations();
+        const QVariantMap response = QJsonDocument::fromJson(m_response).object().toVariantMap();
+        const quint64 decodeAllocations = AllocationCounter::getAllocations() - firstDecodeAllocation;
+
+        qInfo("%llu heap allocations per reply, of which %llu decode the response", replyAllocations.last(), decodeAllocations);
+        QVERIFY(!response.isEmpty());
+        QCOMPARE(forecastSource.getBufferPool().getAllocations(), poolAllocations);
+
+        // Decoding into QJsonDocument and QVariant allocates by nature, once for every time string and
+        // every list of the response. Beyond that a reply only allocates for looking up the series by
+        // name and for the few daily lists it works out, which comes to less than this bound. Storing
+        // a series without the pool, or anything else done once for every hour, goes over it.
+        constexpr quint64 maximumAllocationsBeyondDecoding = 256;
+        QCOMPARE(replyAllocations.first(), replyAllocations.last());
+        QVERIFY2(replyAllocations.last() <= decodeAllocations + maximumAllocationsBeyondDecoding,
+                 qPrintable(QString("%1 allocations per reply beyond the %2 of decoding the response")
+                                .arg(replyAllocations.last() - std::min(replyAllocations.last(), decodeAllocations))
+                                .arg(decodeAllocations)));
+    }
+
+    // The hazards are derived from the recorded dewpoint, freezing level, low cloud and wind. The
+    // freezing level only drops below the summit at night, which is counted over the whole day unless
+    // the daily values are limited to the daylight.
+    const std::shared_ptr<const MountainForecast> forecast = catalog.first()->getForecast();
+    QCOMPARE(forecast->getDates().size(), 7);
+    QCOMPARE(forecast->getHourlyWindChill().size(), forecast->getHourlyTemperature().size());
+    const QList<int> freezingLevelBelowSummitHours = forecast->getDailyFreezingLevelBelowSummitHours();
+    QVERIFY(std::any_of(freezingLevelBelowSummitHours.cbegin(), freezingLevelBelowSummitHours.cend(), [](int hours) { return hours > 0; }));
+    const QList<int> summitInCloudHours = forecast->getDailySummitInCloudHours();
+    QVERIFY(std::all_of(summitInCloudHours.cbegin(), summitInCloudHours.cend(), [](int hours) { return hours > 0; }));
+
+    OpenMeteoForecastSource daylightSource;
+    daylightSource.setDaylightWindow(OpenMeteoForecastSource::DaylightWindow::Sunlight);
+    QCOMPARE(daylightSource.parseReply(m_response)->getDailyFreezingLevelBelowSummitHours(), QList<int>(7, 0));
+}
+
+void ForecastBenchmark::assignTypedLists_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::assignTypedLists()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+
+    // Decode once up front so only the conversion into the forecast's storage is measured.
+    const QVariantMap response = QJsonDocument::fromJson(m_response).object().toVariantMap();
+    const QVariantMap hourly = response.value("hourly").toMap();
+    const QVariantMap daily = response.value("daily").toMap();
+
+    const TimeAxis hourlyTimeAxis = TimeAxis::fromIsoStrings(hourly.value("time").toList(), response.value("utc_offset_seconds").toInt());
+    const QVariantList hourlyTemperature = hourly.value("temperature_2m").toList();
+    const QVariantList hourlyPrecipitation = hourly.value("precipitation").toList();
+    const QVariantList hourlyVisibility = hourly.value("visibility").toList();
+    QList<QDate> dates;
+    for (const QVariant& value : daily.value("time").toList())
+        dates.append(value.toDate());
+    const QVariantList weatherCodes = daily.value("weathercode").toList();
+    const QVariantList windSpeed = daily.value("windspeed_10m_max").toList();
+
+    // Includes publishing each new generation, which is all that happens on the GUI thread, and
+    // returning the one it replaces to the pool.
+    ForecastBufferPool bufferPool;
+    const auto refreshCatalog = [&]()
+    {
+        for (Mountain* mountain : catalog)
+        {
+            const std::shared_ptr<MountainForecast> forecast = bufferPool.acquire();
+            MountainForecast::Series* const series = forecast->mutableSeries();
+            series->hourlyTime = hourlyTimeAxis;
+            bufferPool.assign<double>(&series->hourlyTemperature, hourlyTemperature);
+            bufferPool.assign<double>(&series->hourlyApparentTemperature, hourlyTemperature);
+            bufferPool.assign<double>(&series->hourlyPrecipitation, hourlyPrecipitation);
+            bufferPool.assign<int>(&series->hourlyVisibility, hourlyVisibility);
+            bufferPool.assign(&series->dates, dates);
+            bufferPool.assign<int>(&series->dailyWeatherCode, weatherCodes);
+            bufferPool.assign<double>(&series->dailyWindSpeed, windSpeed);
+            bufferPool.assign<double>(&series->dailyWindGusts, windSpeed);
+            bufferPool.assign<double>(&series->dailyPrecipitation, windSpeed);
+            bufferPool.recycle(mountain->publishForecast(forecast));
+        }
+    };
+
+    // The first refresh creates a generation for every location and the second grows the empty
+    // generations the mountains started with. From then on every refresh reuses them.
+    refreshCatalog();
+    refreshCatalog();
+    const quint64 allocations = bufferPool.getAllocations();
+
+    QBENCHMARK
+    {
+        refreshCatalog();
+    }
+
+    QCOMPARE(bufferPool.getAllocations(), allocations);
+}
+
+void ForecastBenchmark::parseTimeAxis_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::parseTimeAxis()
+{
+    QFETCH(int, numberOfLocations);
+
+    // The hourly times of every location, already decoded into strings, as they arrive in processResponse.
+    const QVariantMap response = QJsonDocument::fromJson(m_response).object().toVariantMap();
+    const QVariantList times = response.value("hourly").toMap().value("time").toList();
+    const int utcOffsetSeconds = response.value("utc_offset_seconds").toInt();
+
+    TimeAxis timeAxis;
+    QBENCHMARK
+    {
+        for (int location = 0; location < numberOfLocations; ++location)
+            timeAxis = TimeAxis::fromIsoStrings(times, utcOffsetSeconds);
+    }
+
+    QCOMPARE(timeAxis.size(), times.size());
+    QCOMPARE(timeAxis.getDateTime(0), times.first().toDateTime());
+}
+
+void ForecastBenchmark::deriveHazards_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::deriveHazards()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+
+    // The recorded response has hours in and out of cloud, and a few nights with the freezing level
+    // below the summit.
+    const QVariantMap hourly = QJsonDocument::fromJson(m_response).object().toVariantMap().value("hourly").toMap();
+    const auto hourlySeries = [&hourly](const QString& variable)
+    {
+        QList<double> values;
+        for (const QVariant& value : hourly.value(variable).toList())
+            values.append(value.toDouble());
+        return values;
+    };
+    const QList<double> temperature = hourlySeries("temperature_2m");
+    const QList<double> dewpoint = hourlySeries("dewpoint_2m");
+    const QList<double> windSpeed = hourlySeries("windspeed_10m");
+    const QList<double> freezingLevel = hourlySeries("freezinglevel_height");
+    const QList<double> lowCloudCover = hourlySeries("cloudcover_low");
+    QCOMPARE(dewpoint.size(), temperature.size());
+
+    HazardKernel::Batch batch;
+    for (const Mountain* mountain : catalog)
+        batch.appendLocation(mountain->getElevation(), temperature.size(), temperature, dewpoint, windSpeed, freezingLevel, lowCloudCover);
+
+    // Every location is derived in the one pass, as parseReplies does for the replies that arrive
+    // together, into storage kept from the previous refresh.
+    HazardKernel::Hazards hazards;
+    QBENCHMARK
+    {
+        HazardKernel::run(batch, &hazards);
+    }
+
+    QCOMPARE(hazards.windChill.size(), batch.numberOfHours());
+    QVERIFY(std::any_of(hazards.summitInCloud.cbegin(), hazards.summitInCloud.cend(), [](double inCloud) { return inCloud > 0.0; }));
+    QVERIFY(std::any_of(hazards.freezingLevelMargin.cbegin(), hazards.freezingLevelMargin.cend(), [](double margin) { return margin < 0.0; }));
+
+    // Parsing several replies together gives each the hazards it would have on its own.
+    const OpenMeteoForecastSource forecastSource;
+    const std::shared_ptr<const MountainForecast> single = forecastSource.parseReply(m_response);
+    const QList<std::shared_ptr<MountainForecast>> forecasts = forecastSource.parseReplies({m_response, QByteArray("{"), m_response});
+    QCOMPARE(forecasts.size(), 3);
+    QVERIFY(forecasts.at(1) == nullptr);
+    for (qsizetype index : {0, 2})
+    {
+        QCOMPARE(forecasts.at(index)->getHourlyWindChill().size(), single->getHourlyWindChill().size());
+        QCOMPARE(forecasts.at(index)->getDailySummitInCloudHours(), single->getDailySummitInCloudHours());
+        QCOMPARE(forecasts.at(index)->getDailyMinimumWindChill(), single->getDailyMinimumWindChill());
+    }
+}
+
+void ForecastBenchmark::tierHourlySeries_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::tierHourlySeries()
+{
+    QFETCH(int, numberOfLocations);
+
+    // The recorded response covers 7 days, so it is repeated out to Open-Meteo's 16 day horizon.
+    const QVariantMap hourly = QJsonDocument::fromJson(m_response).object().toVariantMap().value("hourly").toMap();
+    const QVariantList recorded = hourly.value("temperature_2m").toList();
+    QList<double> temperature;
+    for (qsizetype hour = 0; hour < OpenMeteoForecastSource::maximumForecastDays * 24; ++hour)
+        temperature.append(recorded.at(hour % recorded.size()).toDouble());
+
+    const ForecastTiering tiering = OpenMeteoForecastSource().getTiering();
+    QList<double> tiered(tiering.tieredSize(temperature.size()));
+
+    // Each series of each location is tiered into storage kept from the previous refresh.
+    QBENCHMARK
+    {
+        for (int location = 0; location < numberOfLocations; ++location)
+            tiering.apply(temperature.constData(), temperature.size(), tiered.data(), ForecastTiering::Reduction::Mean);
+    }
+
+    // Only a little more is kept for 16 days than would be for 7 hourly: 72 hourly entries and then one
+    // for every 3 hours, so each day past the third adds 8 entries rather than 24.
+    QCOMPARE(tiered.size(), 176);
+    QCOMPARE(tiered.first(), temperature.first());
+}
+
+void ForecastBenchmark::groupTieredDays_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::groupTieredDays()
+{
+    QFETCH(int, numberOfLocations);
+
+    // The hours of the recorded response continued out to 16 days and tiered, as the heatmap sees them.
+    const QVariantMap response = QJsonDocument::fromJson(m_response).object().toVariantMap();
+    const TimeAxis recorded = TimeAxis::fromIsoStrings(response.value("hourly").toMap().value("time").toList(),
+                                                       response.value("utc_offset_seconds").toInt());
+    const TimeAxis hourly(recorded.getOriginSeconds(), recorded.getStepSeconds(), OpenMeteoForecastSource::maximumForecastDays * 24,
+                          recorded.getUtcOffsetSeconds());
+    const ForecastTiering tiering = OpenMeteoForecastSource().getTiering();
+    const TimeAxis tiered = tiering.apply(hourly);
+
+    // The heatmap groups the entries of each row into days for the days columns, the conditions
+    // colours and the day separators.
+    QList<DailyAggregator::DayRange> days;
+    QBENCHMARK
+    {
+        for (int location = 0; location < numberOfLocations; ++location)
+            days = DailyAggregator::findDays(tiered);
+    }
+
+    QCOMPARE(days.size(), qsizetype(OpenMeteoForecastSource::maximumForecastDays));
+    const qsizetype fullResolutionDays = tiering.getFullResolutionEntries() / 24;
+    for (qsizetype day = 0; day < days.size(); ++day)
+    {
+        QCOMPARE(days.at(day).date, hourly.getDate(0).addDays(day));
+        QCOMPARE(days.at(day).begin, day == 0 ? 0 : days.at(day - 1).end);
+        QCOMPARE(days.at(day).end - days.at(day).begin, qsizetype(day < fullResolutionDays ? 24 : 24 / tiering.getCoarseFactor()));
+    }
+    QCOMPARE(days.last().end, tiered.size());
+
+    // The hours columns are as wide as the time they cover, so every day is as wide as the others.
+    for (const DailyAggregator::DayRange& day : days)
+        QCOMPARE(tiered.getUtcSeconds(day.end) - tiered.getUtcSeconds(day.begin), qint64(24 * 60 * 60));
+}
+
+void ForecastBenchmark::computeDaylight_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::computeDaylight()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+
+    // Every mountain for each of the 7 days of a forecast, in midwinter.
+    constexpr int numberOfDays = 7;
+    const QDate firstDate(2023, 12, 18);
+    SolarEphemeris::Batch batch;
+    for (const Mountain* mountain : catalog)
+    {
+        for (int day = 0; day < numberOfDays; ++day)
+            batch.append(mountain->getLatitude(), mountain->getLongitude(), mountain->getElevation(), firstDate.addDays(day));
+    }
+
+    SolarEphemeris::Windows windows;
+    QBENCHMARK
+    {
+        SolarEphemeris::compute(batch, SolarEphemeris::sunriseAltitude, &windows);
+    }
+
+    QCOMPARE(windows.begin.size(), batch.size());
+    for (qsizetype index = 0; index < windows.begin.size(); ++index)
+    {
+        // Midwinter days in Scotland are between about 6 and 7.5 hours long.
+        const qint64 length = windows.end.at(index) - windows.begin.at(index);
+        QVERIFY2(length > 5 * 3600 && length < 8 * 3600, qPrintable(QString("A day of %1 s").arg(length)));
+    }
+}
+
+void ForecastBenchmark::planViewportLoading_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::planViewportLoading()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+
+    ForecastViewportLoader loader;
+    loader.setMemoryBudget(std::numeric_limits<qint64>::max() / 2);
+    loader.setMountains(catalog);
+    int requested = 0;
+    QObject::connect(&loader, &ForecastViewportLoader::loadRequested, &loader, [&requested](Mountain*) { ++requested; });
+
+    // Lochaber, panned east a step at a time as ConditionsNavigator plans it while the map moves.
+    const QRectF viewport(QPointF(-5.4, 56.6), QPointF(-4.6, 57.0));
+    loader.setViewport(viewport);
+    loader.planLoading();
+    QVERIFY(requested > 0 && requested < numberOfLocations);
+
+    QBENCHMARK
+    {
+        for (int step = 1; step <= 10; ++step)
+        {
+            loader.setViewport(viewport.translated(0.05 * step, 0));
+            loader.planLoading();
+        }
+    }
+
+    QCOMPARE(loader.pendingCount(), requested);
+}
+
+void ForecastBenchmark::evictForecasts()
+{
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(282, &parent);
+    const OpenMeteoForecastSource forecastSource;
+    for (Mountain* mountain : catalog)
+        forecastSource.processReply(m_response, mountain);
+
+    ForecastBufferPool bufferPool;
+    ForecastViewportLoader loader;
+    loader.setBufferPool(&bufferPool);
+    loader.setMountains(catalog);
+    QCOMPARE(loader.loadedCount(), 282);
+    int evicted = 0;
+    QObject::connect(&loader, &ForecastViewportLoader::forecastEvicted, &loader, [&evicted](Mountain*) { ++evicted; });
+
+    // With room for half of the catalog, the farthest forecasts from Lochaber are dropped, though not
+    // that of the most northerly Munro, the farthest of all, which is selected.
+    Mountain* const selected = *std::max_element(catalog.cbegin(), catalog.cend(), [](const Mountain* first, const Mountain* second)
+    {
+        return first->getLatitude() < second->getLatitude();
+    });
+    loader.setMemoryBudget(loader.memoryBytes() / 2);
+    loader.setSelectedMountain(selected);
+    loader.setViewport(QRectF(QPointF(-5.4, 56.6), QPointF(-4.6, 57.0)));
+    loader.planLoading();
+
+    QVERIFY(evicted > 0);
+    QVERIFY(loader.memoryBytes() <= loader.getMemoryBudget());
+    QVERIFY(loader.isLoaded(selected));
+    QVERIFY(!selected->getForecast()->getHourlyTimeAxis().isEmpty());
+
+    // The dropped generations are in the pool, so loading them again reuses their storage.
+    QCOMPARE(bufferPool.size(), qsizetype{evicted});
+    const quint64 created = bufferPool.getCreated();
+    QVERIFY(bufferPool.acquire() != nullptr);
+    QCOMPARE(bufferPool.getCreated(), created);
+}
+
+void ForecastBenchmark::planRefreshes_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::planRefreshes()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+    const OpenMeteoForecastSource forecastSource;
+    for (Mountain* mountain : catalog)
+        forecastSource.processReply(m_response, mountain);
+
+    // The forecasts already loaded are taken to be a day old, so every one of interest is stale. With
+    // no budget nothing is marked as requested, and every plan weighs the same mountains.
+    RefreshPlanner planner;
+    planner.setMountains(catalog);
+    planner.setDailyBudget(0);
+    planner.setViewport(QRectF(QPointF(-5.4, 56.6), QPointF(-4.6, 57.0)));
+    planner.setSelectedMountain(catalog.first());
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+
+    QBENCHMARK
+    {
+        QVERIFY(planner.plan(now).isEmpty());
+    }
+
+    QVERIFY(planner.deferredCount() > 0 && planner.deferredCount() < numberOfLocations);
+}
+
+void ForecastBenchmark::planRefreshesWithinBudget()
+{
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(282, &parent);
+    const OpenMeteoForecastSource forecastSource;
+    for (Mountain* mountain : catalog)
+        forecastSource.processReply(m_response, mountain);
+
+    // 12 variables over 16 days, so each request counts as 1.2 times 16/14 of Open-Meteo's calls.
+    const double requestCost = forecastSource.getRequestCost();
+    QCOMPARE(requestCost, 1.2 * 16.0 / 14.0);
+
+    RefreshPlanner planner;
+    planner.setMountains(catalog);
+    planner.setRequestCost(requestCost);
+    planner.setDailyBudget(55);
+    QCOMPARE(Metrics::instance().summary().value("dailyRequestBudget").toInt(), 55);
+
+    // The first three Munros are in the south, outside the viewport, and are each of interest for
+    // one reason. Half of the 43 in view were retrieved just now, and the rest a day ago.
+    const QRectF viewport(QPointF(-5.4, 56.6), QPointF(-4.6, 57.0));
+    planner.setViewport(viewport);
+    planner.setSelectedMountain(catalog.at(0));
+    planner.setFavourite(catalog.at(1), true);
+    planner.setFilteredGood(catalog.at(2), true);
+    QList<Mountain*> older;
+    int viewed = 0;
+    for (Mountain* mountain : catalog)
+    {
+        if (!viewport.contains(mountain->getLongitude(), mountain->getLatitude()))
+            continue;
+        if (viewed++ % 2 == 0)
+            older.append(mountain);
+        else
+            mountain->publishForecast(std::make_shared<MountainForecast>(*mountain->getForecast()));
+    }
+    QCOMPARE(viewed, 43);
+    QCOMPARE(older.size(), 22);
+
+    // Planning on a later day starts its budget afresh. At 04:30 UTC the 04:00 run is the first of
+    // four still to come that day, so it may spend a quarter of the budget, 13.75 calls, which is 10
+    // requests.
+    const QDateTime firstRun(QDateTime::currentDateTimeUtc().date().addDays(1), QTime(4, 30), QTimeZone::UTC);
+    const QList<Mountain*> firstRefreshes = planner.plan(firstRun);
+    QCOMPARE(firstRefreshes.size(), 10);
+    QCOMPARE(firstRefreshes.at(0), catalog.at(0));
+    QCOMPARE(firstRefreshes.at(1), catalog.at(1));
+    QCOMPARE(firstRefreshes.at(2), catalog.at(2));
+    for (qsizetype index = 3; index < firstRefreshes.size(); ++index)
+        QVERIFY(older.contains(firstRefreshes.at(index)));
+    QCOMPARE(planner.requestsToday(), 10 * requestCost);
+    QCOMPARE(planner.deferredCount(), 46 - 10);
+    QCOMPARE(Metrics::instance().summary().value("requestsToday").toInt(), 14);
+
+    // The run's allowance is spent, so nothing more is planned until the next one.
+    QVERIFY(planner.plan(firstRun.addSecs(5 * 60)).isEmpty());
+
+    // At 10:30 a third of what is left may be spent, again 10 requests. A refresh that failed five
+    // minutes earlier is not retried yet, and those still pending are not planned again. The newer
+    // forecasts, though also stale by now, wait behind the older ones.
+    const QDateTime secondRun = firstRun.addSecs(6 * 60 * 60);
+    Mountain* const failed = firstRefreshes.at(3);
+    planner.refreshFailedAt(failed, secondRun.addSecs(-5 * 60));
+    const QList<Mountain*> secondRefreshes = planner.plan(secondRun);
+    QCOMPARE(secondRefreshes.size(), 10);
+    QVERIFY(!secondRefreshes.contains(failed));
+    for (Mountain* mountain : secondRefreshes)
+        QVERIFY(older.contains(mountain) && !firstRefreshes.contains(mountain));
+    QCOMPARE(planner.requestsToday(), 20 * requestCost);
+    QCOMPARE(planner.deferredCount(), 46 - 9 - 1 - 10);
+    QCOMPARE(Metrics::instance().summary().value("requestsToday").toInt(), 28);
+}
+
+void ForecastBenchmark::searchNames_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::searchNames()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+    QStringList names;
+    for (const Mountain* mountain : catalog)
+        names.append(mountain->getName());
+    const MountainNameIndex index(names);
+
+    // One search per keystroke, as MountainSearchModel runs them while the name is typed.
+    const QString query = "sgurr a ghreadaidh";
+    QBENCHMARK
+    {
+        for (qsizetype length = 1; length <= query.size(); ++length)
+            index.search(QStringView(query).left(length), 8);
+    }
+
+    QCOMPARE(names.at(index.search(u"Sgùrr a’ Ghreadaidh", 8).first().entry), QString("Sgurr a' Ghreadaidh"));
+    QCOMPARE(names.at(index.search(u"sgur a gredaidh", 8).first().entry), QString("Sgurr a' Ghreadaidh"));
+    QVERIFY(index.search(u"teallach", 8).size() >= 3);
+    QCOMPARE(names.at(index.search(u"beinn laoigh", 8).first().entry), QString("Ben Lui [Beinn Laoigh]"));
+}
+
+void ForecastBenchmark::classifyCatalog_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::classifyCatalog()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+    const OpenMeteoForecastSource forecastSource;
+    for (Mountain* mountain : catalog)
+        forecastSource.processReply(m_response, mountain);
+
+    // Matches ConditionsNavigator::applyFilter with every day of the week selected.
+    const ConditionsClassifier classifier;
+    const QList<int> days{0, 1, 2, 3, 4, 5, 6};
+    QMap<ConditionsClassifier::Conditions, int> locationsByConditions;
+
+    QBENCHMARK
+    {
+        locationsByConditions.clear();
+        for (const Mountain* mountain : catalog)
+            ++locationsByConditions[classifier.classifyDays(mountain, days)];
+    }
+
+    // Every location has the recorded forecast, which has at least 5 mm of rain on every day.
+    for (int day : days)
+        QCOMPARE(classifier.classifyDay(catalog.first(), day), ConditionsClassifier::Conditions::Bad);
+    QCOMPARE(locationsByConditions.value(ConditionsClassifier::Conditions::Bad), numberOfLocations);
+    QCOMPARE(locationsByConditions.size(), 1);
+
+    // Classifying reads the stored series, so it allocates nothing however often the pins are coloured.
+    if (AllocationCounter::isAvailable())
+    {
+        const quint64 allocationsBefore = AllocationCounter::getAllocations();
+        int badDays = 0;
+        for (const Mountain* mountain : catalog)
+        {
+            for (int day : days)
+                badDays += classifier.classifyDay(mountain, day) == ConditionsClassifier::Conditions::Bad ? 1 : 0;
+        }
+        QCOMPARE(AllocationCounter::getAllocations() - allocationsBefore, quint64{0});
+        QCOMPARE(badDays, numberOfLocations * static_cast<int>(days.size()));
+    }
+}
+
+void ForecastBenchmark::aggregateCatalog_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::aggregateCatalog()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+    const OpenMeteoForecastSource forecastSource;
+    for (Mountain* mountain : catalog)
+        forecastSource.processReply(m_response, mountain);
+
+    QBENCHMARK
+    {
+        for (const Mountain* mountain : catalog)
+            mountain->identifyMaxAndMinValues();
+    }
+}
+
+void ForecastBenchmark::mergeEnsemble_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::mergeEnsemble()
+{
+    QFETCH(int, numberOfLocations);
+
+    // Three models, each a little warmer than the last, for the four hourly series of every location.
+    const QVariantList temperatures = QJsonDocument::fromJson(m_response).object().toVariantMap()
+                                          .value("hourly").toMap().value("temperature_2m").toList();
+    QList<QList<double>> members(3);
+    for (int model = 0; model < members.size(); ++model)
+    {
+        for (const QVariant& temperature : temperatures)
+            members[model].append(temperature.toDouble() + 0.5 * model);
+    }
+
+    ForecastEnsemble::Statistics statistics;
+    QBENCHMARK
+    {
+        for (int series = 0; series < 4 * numberOfLocations; ++series)
+            statistics = ForecastEnsemble::merge(members, 75.0);
+    }
+
+    QCOMPARE(statistics.percentile.size(), temperatures.size());
+}
+
+void ForecastBenchmark::archiveCatalog_data()
+{
+    addCatalogSizes();
+}
+
+void ForecastBenchmark::archiveCatalog()
+{
+    QFETCH(int, numberOfLocations);
+
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &parent);
+    const OpenMeteoForecastSource forecastSource;
+    for (Mountain* mountain : catalog)
+        forecastSource.processReply(m_response, mountain);
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    int run = 0;
+    qint64 bytesWritten = 0;
+
+    // A new archive each time, as the archive skips forecasts it has already stored.
+    QBENCHMARK
+    {
+        ForecastArchive archive(directory.filePath(QString::number(run++)));
+        for (const Mountain* mountain : catalog)
+            QVERIFY(archive.append(mountain));
+        bytesWritten = archive.getBytesWritten();
+    }
+
+    qInfo("%lld bytes archived, %lld per location", bytesWritten, bytesWritten / numberOfLocations);
+}
+
+void ForecastBenchmark::queryArchive()
+{
+    QObject parent;
+    const QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(282, &parent);
+    const OpenMeteoForecastSource forecastSource;
+    for (Mountain* mountain : catalog)
+        forecastSource.processReply(m_response, mountain);
+
+    // A month of forecasts issued every six hours for the Munros.
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    ForecastArchive archive(directory.path());
+    archive.setIncludeHourly(true);
+    const QDateTime firstIssue(QDate(2023, 9, 18), QTime(0, 0), QTimeZone::UTC);
+    const double windSpeed = catalog.first()->getDailyWindSpeed().first();
+    for (int issue = 0; issue < 30 * 4; ++issue)
+    {
+        const QDateTime issued = firstIssue.addSecs(issue * 6 * 60 * 60);
+        for (Mountain* mountain : catalog)
+        {
+            // Vary the forecast a little so that it is not skipped as a repeat.
+            auto forecast = std::make_shared<MountainForecast>(*mountain->getForecast());
+            forecast->mutableSeries()->dailyWindSpeed.first() = windSpeed + 0.1 * (issue % 10);
+            mountain->publishForecast(std::move(forecast));
+            QVERIFY(archive.append(mountain, issued));
+        }
+    }
+    qInfo("%lld bytes archived for a month", archive.getBytesWritten());
+
+    const QString location = catalog.first()->getName();
+    const QDateTime target(catalog.first()->getDates().first(), QTime(12, 0));
+    QList<ForecastArchive::Revision> revisions;
+
+    QBENCHMARK
+    {
+        revisions = archive.revisions(location, ForecastArchive::Field::DailyWindSpeed, target, QDateTime(), QDateTime());
+    }
+
+    QCOMPARE(revisions.size(), 30 * 4);
+    for (int issue = 0; issue < revisions.size(); ++issue)
+    {
+        QCOMPARE(revisions.at(issue).issued, firstIssue.addSecs(issue * 6 * 60 * 60));
+        QCOMPARE(revisions.at(issue).value, std::round((windSpeed + 0.1 * (issue % 10)) * 10.0) / 10.0);
+    }
+
+    // The last forecast appended for the location, decoded as it was stored.
+    const QList<ForecastArchive::ArchivedForecast> forecasts = archive.forecasts(location, firstIssue.addSecs((30 * 4 - 1) * 6 * 60 * 60),
+                                                                                 QDateTime());
+    QCOMPARE(forecasts.size(), 1);
+    const ForecastArchive::ArchivedForecast& archived = forecasts.first();
+    const std::shared_ptr<const MountainForecast> appended = catalog.first()->getForecast();
+    const auto rounded = [](const QList<double>& values, double scale){
+        QList<double> roundedValues;
+        for (double value : values)
+            roundedValues.append(std::round(value * scale) / scale);
+        return roundedValues;
+    };
+    QList<double> visibility;
+    for (int value : appended->getHourlyVisibility())
+        visibility.append(value);
+
+    const TimeAxis timeAxis = appended->getHourlyTimeAxis();
+    QCOMPARE(archived.hourlyTimes.size(), timeAxis.size());
+    for (qsizetype index = 0; index < timeAxis.size(); ++index)
+        QCOMPARE(archived.hourlyTimes.at(index).toSecsSinceEpoch(), timeAxis.getUtcSeconds(index));
+    QCOMPARE(archived.dates, appended->getDates());
+    QCOMPARE(archived.values.value(ForecastArchive::Field::Temperature), rounded(appended->getHourlyTemperature(), 10.0));
+    QCOMPARE(archived.values.value(ForecastArchive::Field::ApparentTemperature), rounded(appended->getHourlyApparentTemperature(), 10.0));
+    QCOMPARE(archived.values.value(ForecastArchive::Field::Precipitation), rounded(appended->getHourlyPrecipitation(), 10.0));
+    QCOMPARE(archived.values.value(ForecastArchive::Field::Visibility), visibility);
+    QCOMPARE(archived.values.value(ForecastArchive::Field::DailyPrecipitation), rounded(appended->getDailyPrecipitation(), 10.0));
+    QCOMPARE(archived.values.value(ForecastArchive::Field::DailyWindSpeed), rounded(appended->getDailyWindSpeed(), 10.0));
+    QCOMPARE(archived.values.value(ForecastArchive::Field::DailyWindGusts), rounded(appended->getDailyWindGusts(), 10.0));
+}
+
+QTEST_GUILESS_MAIN(ForecastBenchmark)
+
+#include "ForecastBenchmark.moc"
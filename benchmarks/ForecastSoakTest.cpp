@@ -0,0 +1,275 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AllocationCounter.h"
+#include "BenchmarkFixtures.h"
+#include "CannedNetworkAccessManager.h"
+#include "Mountain.h"
+#include "OpenMeteoForecastSource.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <QtTest>
+
+#include <algorithm>
+
+#if defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#endif
+
+namespace
+{
+    // Cycles run before any growth is counted, while caches inside Qt and the source fill up.
+    constexpr int warmUpCycles = 20;
+    // Growth is measured between the medians of this many samples at each end of the run, so that a
+    // single noisy sample does not fail the test.
+    constexpr int samplesPerMedian = 10;
+
+    // Steady-state limits. A leak of anything per request grows the live allocations by at least the
+    // size of the catalog each cycle; what is allowed here covers allocator and Qt bookkeeping.
+    constexpr double maximumAllocationGrowthPerCycle = 1.0;
+    constexpr qint64 maximumResidentGrowthBytes = 4 * 1024 * 1024;
+
+    struct CycleSample
+    {
+        int cycle;
+        qint64 residentBytes;
+        qsizetype liveObjects;
+        qint64 liveAllocations;
+        quint64 allocations;
+        quint64 poolAllocations;
+    };
+
+    // The resident set size of the process, or -1 where it cannot be read.
+    qint64 residentBytes()
+    {
+#if defined(Q_OS_LINUX)
+        QFile status(QStringLiteral("/proc/self/status"));
+        if (!status.open(QIODevice::ReadOnly | QIODevice::Text))
+            return -1;
+
+        // The line reads "VmRSS:     12345 kB".
+        const QList<QByteArray> lines = status.readAll().split('\n');
+        for (const QByteArray& line : lines)
+        {
+            if (line.startsWith("VmRSS:"))
+                return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024;
+        }
+        return -1;
+#elif defined(Q_OS_MACOS)
+        mach_task_basic_info_data_t info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+            return -1;
+        return static_cast<qint64>(info.resident_size);
+#else
+        return -1;
+#endif
+    }
+
+    template<typename T>
+    T median(QList<T> values)
+    {
+        std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+        return values.at(values.size() / 2);
+    }
+
+    template<typename T, typename Member>
+    T medianOf(const QList<CycleSample>& samples, qsizetype first, Member member)
+    {
+        QList<T> values;
+        for (qsizetype index = first; index < first + samplesPerMedian; ++index)
+            values.append(static_cast<T>(samples.at(index).*member));
+        return median(values);
+    }
+
+    int numberOfCycles()
+    {
+        bool isNumber = false;
+        const int cycles = qEnvironmentVariableIntValue("CONDITIONS_NAVIGATOR_SOAK_CYCLES", &isNumber);
+        return isNumber ? std::max(cycles, warmUpCycles + 2 * samplesPerMedian) : 300;
+    }
+
+    void writeSamples(const QList<CycleSample>& samples, const QString& runName)
+    {
+        const QString path = qEnvironmentVariable("CONDITIONS_NAVIGATOR_SOAK_OUTPUT");
+        if (path.isEmpty())
+            return;
+
+        QFile output(path);
+        const bool isNewFile = !output.exists();
+        if (!output.open(QIODevice::Append | QIODevice::Text))
+        {
+            qWarning() << "Unable to write soak samples to" << path;
+            return;
+        }
+
+        QTextStream stream(&output);
+        if (isNewFile)
+            stream << "run,cycle,residentBytes,liveObjects,liveAllocations,allocations,poolAllocations\n";
+        for (const CycleSample& sample : samples)
+        {
+            stream << runName << ',' << sample.cycle << ',' << sample.residentBytes << ',' << sample.liveObjects << ','
+                   << sample.liveAllocations << ',' << sample.allocations << ',' << sample.poolAllocations << '\n';
+        }
+    }
+}
+
+// Refreshes a catalog hundreds of times through OpenMeteoForecastSource and Mountain, with every
+// request answered by a recorded response, and fails if anything keeps growing once the first few
+// cycles are over. Some requests fail and some return a response that is cut short, so the error
+// paths are covered, and in the churn run a tenth of the mountains are replaced while their requests
+// are in flight, as happens when the catalog changes during a refresh.
+class ForecastSoakTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void refreshCycles_data();
+    void refreshCycles();
+
+private:
+    QByteArray m_response;
+};
+
+void ForecastSoakTest::initTestCase()
+{
+    m_response = BenchmarkFixtures::readForecastResponse();
+    QVERIFY2(!m_response.isEmpty(), "Unable to read the Open-Meteo fixture");
+}
+
+void ForecastSoakTest::refreshCycles_data()
+{
+    QTest::addColumn<int>("numberOfLocations");
+    QTest::addColumn<bool>("replaceMountains");
+    QTest::newRow("munros") << 282 << false;
+    QTest::newRow("munros with churn") << 282 << true;
+    QTest::newRow("5k") << 5000 << false;
+}
+
+void ForecastSoakTest::refreshCycles()
+{
+    QFETCH(int, numberOfLocations);
+    QFETCH(bool, replaceMountains);
+
+    QObject root;
+    QList<Mountain*> catalog = BenchmarkFixtures::createCatalog(numberOfLocations, &root);
+
+    auto* networkManager = new CannedNetworkAccessManager(m_response, &root);
+    networkManager->setFailureInterval(37);
+    networkManager->setTruncatedInterval(53);
+
+    auto* forecastSource = new OpenMeteoForecastSource(&root);
+    forecastSource->setNetworkAccessManager(networkManager);
+
+    // Mountains replaced mid-flight may or may not report a failure, so only the others are counted.
+    int completed = 0;
+    int failed = 0;
+    connect(forecastSource, &OpenMeteoForecastSource::forecastReceived, this, [&completed](Mountain* mountain)
+    {
+        if (mountain)
+            ++completed;
+    });
+    connect(forecastSource, &OpenMeteoForecastSource::forecastFailed, this, [&completed, &failed](Mountain* mountain)
+    {
+        if (mountain)
+        {
+            ++completed;
+            ++failed;
+        }
+    });
+
+    const int cycles = numberOfCycles();
+    QList<CycleSample> samples;
+    samples.reserve(cycles);
+
+    for (int cycle = 0; cycle < cycles; ++cycle)
+    {
+        completed = 0;
+        for (Mountain* mountain : std::as_const(catalog))
+            forecastSource->MakeRequest(mountain->getLongitude(), mountain->getLatitude(), mountain->getElevation(), mountain);
+
+        int replaced = 0;
+        if (replaceMountains)
+        {
+            for (qsizetype index = cycle % 10; index < catalog.size(); index += 10)
+            {
+                Mountain* const mountain = catalog.at(index);
+                catalog[index] = new Mountain(mountain->getName(), mountain->getLatitude(), mountain->getLongitude(), mountain->getElevation(), &root);
+                delete mountain;
+                ++replaced;
+            }
+        }
+
+        QTRY_COMPARE_WITH_TIMEOUT(completed, static_cast<int>(catalog.size()) - replaced, 60000);
+        QTRY_VERIFY(networkManager->findChildren<QNetworkReply*>().isEmpty());
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+
+        // The live allocations, counted through malloc and free, show whether anything is being kept
+        // from one cycle to the next, including inside Qt.
+        const quint64 allocations = AllocationCounter::getAllocations();
+        samples.append({cycle,
+                        residentBytes(),
+                        root.findChildren<QObject*>().size(),
+                        static_cast<qint64>(allocations - AllocationCounter::getDeallocations()),
+                        allocations,
+                        forecastSource->getBufferPool().getAllocations()});
+    }
+
+    writeSamples(samples, QTest::currentDataTag());
+    QVERIFY2(failed > 0, "No requests failed, so the error paths were not covered");
+
+    const qsizetype firstSteady = warmUpCycles;
+    const qsizetype lastSteady = samples.size() - samplesPerMedian;
+    const int steadyCycles = static_cast<int>(lastSteady - firstSteady);
+
+    // Every reply is deleted and every replaced mountain is gone, so nothing should be left over.
+    QCOMPARE(samples.last().liveObjects, samples.at(firstSteady).liveObjects);
+
+    if (AllocationCounter::isAvailable())
+    {
+        const qint64 allocationGrowth = medianOf<qint64>(samples, lastSteady, &CycleSample::liveAllocations) -
+                                        medianOf<qint64>(samples, firstSteady, &CycleSample::liveAllocations);
+        const double allocationGrowthPerCycle = static_cast<double>(allocationGrowth) / steadyCycles;
+        qInfo("Live allocations grew by %lld over %d cycles (%.2f per cycle)", allocationGrowth, steadyCycles, allocationGrowthPerCycle);
+        QVERIFY2(allocationGrowthPerCycle <= maximumAllocationGrowthPerCycle,
+                 qPrintable(QString("Live allocations grew by %1 per cycle").arg(allocationGrowthPerCycle)));
+    }
+    else
+    {
+        qInfo("Allocations cannot be counted on this platform, so their growth is not checked");
+    }
+
+    // Generations are recycled, so the pool stops allocating once it holds one for every mountain.
+    const quint64 poolGrowth = samples.last().poolAllocations - samples.at(firstSteady).poolAllocations;
+    if (!replaceMountains)
+        QCOMPARE(poolGrowth, quint64(0));
+
+    if (samples.first().residentBytes < 0)
+    {
+        qInfo("The resident set size cannot be read on this platform, so it is not checked");
+        return;
+    }
+
+    const qint64 residentGrowth = medianOf<qint64>(samples, lastSteady, &CycleSample::residentBytes) -
+                                  medianOf<qint64>(samples, firstSteady, &CycleSample::residentBytes);
+    qInfo("Resident set size grew by %lld KB over %d cycles", residentGrowth / 1024, steadyCycles);
+    QVERIFY2(residentGrowth <= maximumResidentGrowthBytes,
+             qPrintable(QString("Resident set size grew by %1 KB").arg(residentGrowth / 1024)));
+}
+
+QTEST_GUILESS_MAIN(ForecastSoakTest)
+
+#include "ForecastSoakTest.moc"
@@ -1,80 +1,125 @@
-// Copyright 2023 Esri
-
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-// http://www.apache.org/licenses/LICENSE-2.0
-
-// Unless required by applicable law or agreed to in writing, software
-// distributed under the License is distributed on an "AS IS" BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-// See the License for the specific language governing permissions and
-// limitations under the License.
-
-#include "ConditionsNavigator.h"
-
-#include "ArcGISRuntimeEnvironment.h"
-#include "MapQuickView.h"
-
-#include <QDir>
-#include <QtWidgets/QApplication>
-#include <QQmlApplicationEngine>
-
-//------------------------------------------------------------------------------
-
-using namespace Esri::ArcGISRuntime;
-
-int main(int argc, char *argv[])
-{
-    QApplication app(argc, argv);
-
-    // Use of Esri location services, including basemaps and geocoding, requires
-    // either an ArcGIS identity or an API key. For more information see
-    // https://links.esri.com/arcgis-runtime-security-auth.
-
-    // 1. ArcGIS identity: An ArcGIS named user account that is a member of an
-    // organization in ArcGIS Online or ArcGIS Enterprise.
-
-    // 2. API key: A permanent key that gives your application access to Esri
-    // location services. Create a new API key or access existing API keys from
-    // your ArcGIS for Developers dashboard (https://links.esri.com/arcgis-api-keys).
-
-    const QString apiKey = QString("");
-    if (apiKey.isEmpty())
-    {
-        qWarning() << "Use of Esri location services, including basemaps, requires" <<
-                      "you to authenticate with an ArcGIS identity or set the API Key property.";
-    }
-    else
-    {
-        ArcGISRuntimeEnvironment::setApiKey(apiKey);
-    }
-
-    // Production deployment of applications built with ArcGIS Maps SDK requires you to
-    // license ArcGIS Maps SDK functionality. For more information see
-    // https://links.esri.com/arcgis-runtime-license-and-deploy.
-
-    // ArcGISRuntimeEnvironment::setLicense("Place license string in here");
-
-    // Register the map view for QML
-    qmlRegisterType<MapQuickView>("Esri.ConditionsNavigator", 1, 0, "MapView");
-
-    // Register the ConditionsNavigator (QQuickItem) for QML
-    qmlRegisterType<ConditionsNavigator>("Esri.ConditionsNavigator", 1, 0, "ConditionsNavigator");
-
-    // Register the Mountain object with QML
-    qmlRegisterType<Mountain>("Source.Mountain", 1, 0, "Mountain");
-
-    // Initialize application view
-    QQmlApplicationEngine engine;
-
-    // Add the import Path
-    engine.addImportPath(QDir(QCoreApplication::applicationDirPath()).filePath("qml"));
-
-    // Set the source
-    engine.load(QUrl("qrc:/qml/main.qml"));
-
-    return app.exec();
-}
-
-//------------------------------------------------------------------------------
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ChartSeriesFeeder.h"
+#include "ConditionsNavigator.h"
+#include "DetailViewCache.h"
+#include "ForecastHeatmap.h"
+#include "ForecastTableModel.h"
+#include "ForecastViewportLoader.h"
+#include "Metrics.h"
+#include "MetricsEndpoint.h"
+#include "MountainSearchModel.h"
+#include "Tracer.h"
+
+#include "ArcGISRuntimeEnvironment.h"
+#include "MapQuickView.h"
+
+#include <QDir>
+#include <QtWidgets/QApplication>
+#include <QQmlApplicationEngine>
+
+//------------------------------------------------------------------------------
+
+using namespace Esri::ArcGISRuntime;
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+
+    // Optionally record a Chrome trace of start up and refreshes (see Tracer.h).
+    Tracer::instance().configure(app.arguments());
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [](){ Tracer::instance().stop(); });
+
+    // Optionally serve runtime metrics to Prometheus on the loopback interface (see MetricsEndpoint.h).
+    MetricsEndpoint metricsEndpoint;
+    metricsEndpoint.configure(app.arguments());
+
+    // Use of Esri location services, including basemaps and geocoding, requires
+    // either an ArcGIS identity or an API key. For more information see
+    // https://links.esri.com/arcgis-runtime-security-auth.
+
+    // 1. ArcGIS identity: An ArcGIS named user account that is a member of an
+    // organization in ArcGIS Online or ArcGIS Enterprise.
+
+    // 2. API key: A permanent key that gives your application access to Esri
+    // location services. Create a new API key or access existing API keys from
+    // your ArcGIS for Developers dashboard (https://links.esri.com/arcgis-api-keys).
+
+    const QString apiKey = QString("");
+    if (apiKey.isEmpty())
+    {
+        qWarning() << "Use of Esri location services, including basemaps, requires" <<
+                      "you to authenticate with an ArcGIS identity or set the API Key property.";
+    }
+    else
+    {
+        ArcGISRuntimeEnvironment::setApiKey(apiKey);
+    }
+
+    // Production deployment of applications built with ArcGIS Maps SDK requires you to
+    // license ArcGIS Maps SDK functionality. For more information see
+    // https://links.esri.com/arcgis-runtime-license-and-deploy.
+
+    // ArcGISRuntimeEnvironment::setLicense("Place license string in here");
+
+    // Register the map view for QML
+    qmlRegisterType<MapQuickView>("Esri.ConditionsNavigator", 1, 0, "MapView");
+
+    // Register the ConditionsNavigator (QQuickItem) for QML
+    qmlRegisterType<ConditionsNavigator>("Esri.ConditionsNavigator", 1, 0, "ConditionsNavigator");
+
+    // Register the ChartSeriesFeeder with QML
+    qmlRegisterType<ChartSeriesFeeder>("Esri.ConditionsNavigator", 1, 0, "ChartSeriesFeeder");
+
+    // Register the DetailViewCache with QML (the instance is provided by the ConditionsNavigator)
+    qmlRegisterUncreatableType<DetailViewCache>("Esri.ConditionsNavigator", 1, 0, "DetailViewCache",
+                                                "DetailViewCache is provided by ConditionsNavigator");
+
+    // Register the ForecastHeatmap (QQuickPaintedItem) for QML
+    qmlRegisterType<ForecastHeatmap>("Esri.ConditionsNavigator", 1, 0, "ForecastHeatmap");
+
+    // Register the ForecastTableModel with QML (instances are provided by the ConditionsNavigator)
+    qmlRegisterUncreatableType<ForecastTableModel>("Esri.ConditionsNavigator", 1, 0, "ForecastTableModel",
+                                                   "ForecastTableModel is provided by ConditionsNavigator");
+
+    // Register the ForecastViewportLoader with QML (the instance is provided by the ConditionsNavigator)
+    qmlRegisterUncreatableType<ForecastViewportLoader>("Esri.ConditionsNavigator", 1, 0, "ForecastViewportLoader",
+                                                       "ForecastViewportLoader is provided by ConditionsNavigator");
+
+    // Register the MountainSearchModel with QML (the instance is provided by the ConditionsNavigator)
+    qmlRegisterUncreatableType<MountainSearchModel>("Esri.ConditionsNavigator", 1, 0, "MountainSearchModel",
+                                                    "MountainSearchModel is provided by ConditionsNavigator");
+
+    // Register the runtime metrics with QML for the debug overlay
+    qmlRegisterSingletonInstance("Esri.ConditionsNavigator", 1, 0, "Metrics", &Metrics::instance());
+
+    // Register the Mountain object with QML
+    qmlRegisterType<Mountain>("Source.Mountain", 1, 0, "Mountain");
+
+    // Initialize application view
+    QQmlApplicationEngine engine;
+
+    // Add the import Path
+    engine.addImportPath(QDir(QCoreApplication::applicationDirPath()).filePath("qml"));
+
+    // Set the source
+    {
+        TRACE_SCOPE("loadQml");
+        engine.load(QUrl("qrc:/qml/main.qml"));
+    }
+
+    return app.exec();
+}
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,218 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Metrics.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <QWebSocket>
+
+#include <memory>
+
+// Opens many WebSocket sessions against a ConditionsNavigatorService. Each session subscribes to
+// the catalog and then asks for the forecast of randomly chosen locations one after another, as the
+// app does when mountains are selected. Latencies are reported as percentiles once every session
+// has finished.
+class ForecastLoadTest : public QObject
+{
+public:
+    ForecastLoadTest(const QUrl& url, int sessions, int requestsPerSession, int sessionsPerSecond) :
+        m_url(url),
+        m_requestsPerSession(requestsPerSession),
+        m_sessionsPerSecond(std::max(1, sessionsPerSecond)),
+        m_sessionsToOpen(sessions)
+    {
+    }
+
+    void start()
+    {
+        m_runTimer.start();
+
+        // Sessions are opened in batches every 100ms so the service sees a ramp rather than a single burst.
+        connect(&m_rampTimer, &QTimer::timeout, this, [this](){
+            const int batchSize = std::max(1, m_sessionsPerSecond / 10);
+            for (int session = 0; session < batchSize && m_sessionsOpened < m_sessionsToOpen; ++session)
+                openSession();
+            if (m_sessionsOpened >= m_sessionsToOpen)
+                m_rampTimer.stop();
+        });
+        m_rampTimer.start(100);
+    }
+
+private:
+    struct Session
+    {
+        std::unique_ptr<QWebSocket> webSocket;
+        QElapsedTimer timer;
+        int requestsSent = 0;
+        bool subscribed = false;
+    };
+
+    void openSession()
+    {
+        ++m_sessionsOpened;
+        auto session = std::make_shared<Session>();
+        session->webSocket = std::make_unique<QWebSocket>();
+        QWebSocket* const webSocket = session->webSocket.get();
+
+        connect(webSocket, &QWebSocket::connected, this, [this, session](){
+            m_connect.record(session->timer.nsecsElapsed() / 1000);
+            ++m_sessionsConnected;
+            session->timer.restart();
+            session->webSocket->sendTextMessage("{\"type\":\"subscribe\"}");
+        });
+        connect(webSocket, &QWebSocket::textMessageReceived, this, [this, session](const QString& message){
+            handleMessage(session, message);
+        });
+        connect(webSocket, &QWebSocket::errorOccurred, this, [this, session](QAbstractSocket::SocketError){
+            ++m_sessionsFailed;
+            qWarning() << "Session failed:" << session->webSocket->errorString();
+            finishSession(session);
+        });
+
+        session->timer.start();
+        webSocket->open(m_url);
+    }
+
+    void handleMessage(const std::shared_ptr<Session>& session, const QString& message)
+    {
+        m_bytesReceived += message.size();
+        const qint64 latency = session->timer.nsecsElapsed() / 1000;
+
+        if (!session->subscribed)
+        {
+            session->subscribed = true;
+            m_catalog.record(latency);
+            if (m_locations.isEmpty())
+                m_locations = QJsonDocument::fromJson(message.toUtf8()).object().value("locations").toArray();
+        }
+        else if (message.startsWith("{\"type\":\"catalog\""))
+        {
+            // A refresh pushed to every subscriber, not the reply to this session's request.
+            return;
+        }
+        else
+        {
+            m_forecast.record(latency);
+        }
+
+        if (session->requestsSent >= m_requestsPerSession || m_locations.isEmpty())
+        {
+            finishSession(session);
+            return;
+        }
+
+        const QJsonObject location = m_locations.at(QRandomGenerator::global()->bounded(m_locations.size())).toObject();
+        const QJsonObject request{
+            {"type", "forecast"},
+            {"latitude", location.value("latitude")},
+            {"longitude", location.value("longitude")}
+        };
+        ++session->requestsSent;
+        session->timer.restart();
+        session->webSocket->sendTextMessage(QString::fromUtf8(QJsonDocument(request).toJson(QJsonDocument::Compact)));
+    }
+
+    void finishSession(const std::shared_ptr<Session>& session)
+    {
+        if (!session->webSocket)
+            return;
+
+        session->webSocket->disconnect(this);
+        session->webSocket->close();
+        session->webSocket.release()->deleteLater();
+
+        if (++m_sessionsFinished == m_sessionsToOpen)
+            report();
+    }
+
+    void report() const
+    {
+        const double seconds = m_runTimer.elapsed() / 1000.0;
+        const auto percentiles = [](const LatencyHistogram& histogram){
+            return QString("p50 %1 ms, p99 %2 ms, max %3 ms (%4 samples)")
+                .arg(histogram.valueAtPercentile(50) / 1000.0, 0, 'f', 1)
+                .arg(histogram.valueAtPercentile(99) / 1000.0, 0, 'f', 1)
+                .arg(histogram.max() / 1000.0, 0, 'f', 1)
+                .arg(histogram.count());
+        };
+
+        qInfo().noquote() << QString("%1 sessions connected, %2 failed in %3 s").arg(m_sessionsConnected).arg(m_sessionsFailed).arg(seconds, 0, 'f', 1);
+        qInfo().noquote() << "Connect: " << percentiles(m_connect);
+        qInfo().noquote() << "Catalog: " << percentiles(m_catalog);
+        qInfo().noquote() << "Forecast:" << percentiles(m_forecast);
+        qInfo().noquote() << QString("%1 forecasts/s, %2 MiB received")
+                             .arg(seconds > 0.0 ? m_forecast.count() / seconds : 0.0, 0, 'f', 1)
+                             .arg(m_bytesReceived / (1024.0 * 1024.0), 0, 'f', 1);
+
+        QCoreApplication::exit(m_sessionsFailed == 0 ? 0 : 2);
+    }
+
+    const QUrl m_url;
+    const int m_requestsPerSession;
+    const int m_sessionsPerSecond;
+    const int m_sessionsToOpen;
+
+    qint64 m_bytesReceived = 0;
+    LatencyHistogram m_catalog;
+    LatencyHistogram m_connect;
+    LatencyHistogram m_forecast;
+    QJsonArray m_locations;
+    QTimer m_rampTimer;
+    QElapsedTimer m_runTimer;
+    int m_sessionsConnected = 0;
+    int m_sessionsFailed = 0;
+    int m_sessionsFinished = 0;
+    int m_sessionsOpened = 0;
+};
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ForecastLoadTest");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Opens many WebSocket sessions against a ConditionsNavigatorService and reports latency percentiles.");
+    parser.addHelpOption();
+
+    const QCommandLineOption urlOption("url", "Service to test (default ws://127.0.0.1:8080).", "url", "ws://127.0.0.1:8080");
+    const QCommandLineOption sessionsOption("sessions", "Number of sessions to open (default 1000).", "count", "1000");
+    const QCommandLineOption requestsOption("requests", "Forecast requests per session (default 10).", "count", "10");
+    const QCommandLineOption rampOption("ramp", "Sessions opened per second (default 500).", "count", "500");
+    parser.addOptions({urlOption, sessionsOption, requestsOption, rampOption});
+    parser.process(app);
+
+    const int sessions = parser.value(sessionsOption).toInt();
+    if (sessions <= 0)
+    {
+        qCritical("--sessions must be at least 1");
+        return 1;
+    }
+
+    ForecastLoadTest loadTest(QUrl(parser.value(urlOption)), sessions,
+                              parser.value(requestsOption).toInt(), parser.value(rampOption).toInt());
+    loadTest.start();
+
+    return app.exec();
+}
+
+//------------------------------------------------------------------------------
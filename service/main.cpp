@@ -0,0 +1,111 @@
+// Copyright 2023 Esri
+
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ForecastArchive.h"
+#include "ForecastCatalog.h"
+#include "ForecastService.h"
+#include "MetricsEndpoint.h"
+#include "Tracer.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+//------------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ConditionsNavigatorService");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Serves one shared, periodically refreshed copy of the forecasts over HTTP and WebSocket.");
+    parser.addHelpOption();
+
+    const QCommandLineOption catalogOption("catalog", "CSV file of name,latitude,longitude,elevation "
+                                           "(defaults to the built in list of Munros).", "file");
+    const QCommandLineOption addressOption("address", "Address to listen on (default 127.0.0.1).", "address", "127.0.0.1");
+    const QCommandLineOption portOption("port", "Port to listen on (default 8080).", "port", "8080");
+    const QCommandLineOption refreshOption("refresh-minutes", "Minutes between refreshes (default 30).", "minutes", "30");
+    const QCommandLineOption sessionsOption("max-sessions", "Maximum number of client sessions (default 10000).", "count", "10000");
+    const QCommandLineOption concurrencyOption("max-concurrent", "Maximum number of requests to Open-Meteo in flight (default 32).", "count", "32");
+    const QCommandLineOption upstreamOption("upstream-url", "Forecast API to refresh from (default https://api.open-meteo.com/v1/forecast).",
+                                            "url", "https://api.open-meteo.com/v1/forecast");
+    const QCommandLineOption modelsOption("models", "Comma separated forecast models to combine, for example "
+                                          "ukmo_seamless,ecmwf_ifs025,icon_seamless.", "models");
+    const QCommandLineOption percentileOption("percentile", "Percentile of the models to classify (default 50).", "percentile", "50");
+    const QCommandLineOption archiveOption("archive", "Append every new forecast to the archive in this directory.", "directory");
+    const QCommandLineOption archiveIntervalOption("archive-interval", "Minimum minutes between archived forecasts of a location "
+                                                   "(default 360, about one per run of the global models).", "minutes", "360");
+    const QCommandLineOption archiveHourlyOption("archive-hourly", "Also archive the hourly series, which makes each forecast about ten times larger.");
+    const QCommandLineOption traceOption("trace", "Write a Chrome trace to the file on exit.", "file");
+    const QCommandLineOption metricsPortOption("metrics-port", "Serve Prometheus metrics on this local port.", "port");
+    parser.addOptions({catalogOption, addressOption, portOption, refreshOption, sessionsOption, concurrencyOption,
+                       upstreamOption, modelsOption, percentileOption, archiveOption, archiveIntervalOption, archiveHourlyOption, traceOption, metricsPortOption});
+    parser.process(app);
+
+    QList<CatalogEntry> catalog;
+    if (parser.isSet(catalogOption))
+    {
+        QString errorMessage;
+        catalog = ForecastCatalog::load(parser.value(catalogOption), &errorMessage);
+        if (!errorMessage.isEmpty())
+        {
+            qCritical("Unable to read the catalog: %s", qPrintable(errorMessage));
+            return 1;
+        }
+    }
+    else
+    {
+        catalog = ForecastCatalog::builtIn();
+    }
+
+    Tracer::instance().configure(app.arguments());
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [](){ Tracer::instance().stop(); });
+
+    MetricsEndpoint metricsEndpoint;
+    metricsEndpoint.configure(app.arguments());
+
+    ForecastService service;
+    service.setCatalog(catalog);
+    service.setUpstreamUrl(QUrl(parser.value(upstreamOption)));
+    service.setRefreshInterval(parser.value(refreshOption).toInt());
+    service.setMaximumSessions(parser.value(sessionsOption).toInt());
+    service.setMaximumConcurrentRequests(parser.value(concurrencyOption).toInt());
+    if (parser.isSet(modelsOption))
+        service.setModels(parser.value(modelsOption).split(',', Qt::SkipEmptyParts), parser.value(percentileOption).toDouble());
+
+    ForecastArchive* archive = nullptr;
+    if (parser.isSet(archiveOption))
+    {
+        archive = new ForecastArchive(parser.value(archiveOption), &service);
+        archive->setMinimumInterval(parser.value(archiveIntervalOption).toInt());
+        archive->setIncludeHourly(parser.isSet(archiveHourlyOption));
+        service.setArchive(archive);
+    }
+
+    if (!service.listen(QHostAddress(parser.value(addressOption)), parser.value(portOption).toUShort()))
+        return 1;
+
+    QObject::connect(&service, &ForecastService::refreshed, [&service, archive](quint64 version){
+        qInfo("Forecasts refreshed to version %llu, %d sessions", version, service.getSessionCount());
+        if (archive)
+            qInfo("%lld bytes archived since start up", archive->getBytesWritten());
+    });
+
+    qInfo("Serving %lld locations on port %d", static_cast<long long>(catalog.size()), service.port());
+    service.refresh();
+
+    return app.exec();
+}
+
+//------------------------------------------------------------------------------